@@ -0,0 +1,136 @@
+#ifndef __PWI_HOST_ARDUINO_H__
+#define __PWI_HOST_ARDUINO_H__
+
+/*
+ * Host (Linux) replacement for the Arduino core header.
+ *
+ * This shim provides just what the pwiCommon library needs to be built and
+ * exercised off-target:
+ * - millis()/micros() driven by a simulated clock (see pwiHost.h),
+ * - digitalRead() fed from scripted waveforms,
+ * - attachInterrupt() whose handlers are fired when the simulated clock
+ *   crosses a scripted edge,
+ * - no-op noInterrupts()/interrupts(),
+ * - PROGMEM and friends as plain RAM accessors,
+ * - a fake Serial which writes to stdout (or nowhere).
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+/* pin levels, modes and edges
+ */
+#define LOW                 0x0
+#define HIGH                0x1
+
+#define INPUT               0x0
+#define OUTPUT              0x1
+#define INPUT_PULLUP        0x2
+
+#define CHANGE              1
+#define FALLING             2
+#define RISING              3
+
+#define NOT_AN_INTERRUPT    -1
+
+#define DEC                 10
+#define HEX                 16
+#define OCT                 8
+#define BIN                 2
+
+#ifndef max
+#define max(a,b)            ((a)>(b)?(a):(b))
+#endif
+#ifndef min
+#define min(a,b)            ((a)<(b)?(a):(b))
+#endif
+
+/* program memory: the host has only one address space
+ */
+#define PROGMEM
+#define PSTR(s)             (s)
+#define pgm_read_byte(p)    (*( const uint8_t * )( p ))
+#define pgm_read_word(p)    (*( const uint16_t * )( p ))
+#define pgm_read_dword(p)   (*( const uint32_t * )( p ))
+#define pgm_read_ptr(p)     (*( void * const * )( p ))
+#define strlen_P            strlen
+#define strcpy_P            strcpy
+#define strncpy_P           strncpy
+#define strcmp_P            strcmp
+#define memcpy_P            memcpy
+
+class __FlashStringHelper;
+#define F(s)                (( const __FlashStringHelper * )( s ))
+
+int snprintf_P( char *buf, size_t size, const char *fmt, ... );
+int vsnprintf_P( char *buf, size_t size, const char *fmt, va_list ap );
+
+/* time
+ */
+unsigned long       millis( void );
+unsigned long       micros( void );
+void                delay( unsigned long ms );
+void                delayMicroseconds( unsigned int us );
+
+/* digital I/O
+ */
+void                pinMode( uint8_t pin, uint8_t mode );
+void                digitalWrite( uint8_t pin, uint8_t val );
+int                 digitalRead( uint8_t pin );
+
+/* ports: the simulated pins are grouped by 8-bits ports, port #1 holding
+ * pins 0 to 7, and so on
+ */
+#define NOT_A_PIN                   0
+#define NOT_A_PORT                  0
+#define digitalPinToPort(p)         ( hostPinToPort( p ))
+#define digitalPinToBitMask(p)      (( uint8_t )( 1 << (( p ) % 8 )))
+#define portInputRegister(port)     ( hostPortInputRegister( port ))
+
+uint8_t             hostPinToPort( uint8_t pin );
+volatile uint8_t   *hostPortInputRegister( uint8_t port );
+
+/* interrupts
+ */
+#define noInterrupts()
+#define interrupts()
+#define digitalPinToInterrupt(p)    ( hostPinToInterrupt( p ))
+
+int                 hostPinToInterrupt( uint8_t pin );
+void                attachInterrupt( uint8_t irq, void ( *isr )( void ), int mode );
+void                detachInterrupt( uint8_t irq );
+
+/* serial
+ */
+class HardwareSerial {
+    public:
+        void        begin( unsigned long baud );
+        size_t      write( uint8_t c );
+        size_t      write( const uint8_t *buf, size_t size );
+        size_t      print( const __FlashStringHelper *str );
+        size_t      print( const char *str );
+        size_t      print( char c );
+        size_t      print( unsigned char n, int base=DEC );
+        size_t      print( int n, int base=DEC );
+        size_t      print( unsigned int n, int base=DEC );
+        size_t      print( long n, int base=DEC );
+        size_t      print( unsigned long n, int base=DEC );
+        size_t      print( double n, int digits=2 );
+        size_t      println( void );
+        template<typename T>
+        size_t      println( T v ) { size_t n = this->print( v ); return( n + this->println()); }
+        template<typename T>
+        size_t      println( T v, int arg ) { size_t n = this->print( v, arg ); return( n + this->println()); }
+};
+
+extern HardwareSerial Serial;
+
+#include "pwiHost.h"
+
+#endif // __PWI_HOST_ARDUINO_H__
@@ -0,0 +1,46 @@
+#ifndef __PWI_HOST_EEPROM_H__
+#define __PWI_HOST_EEPROM_H__
+
+/*
+ * Host (Linux) replacement for the Arduino EEPROM library.
+ *
+ * The EEPROM is simulated in RAM; each physical write (i.e. each written byte
+ * whose value actually changes) is counted per cell, so that wear-leveling
+ * can be measured.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <Arduino.h>
+
+#define HOST_EEPROM_SIZE    1024
+
+class EEPROMClass {
+    public:
+        uint8_t     read( int idx );
+        void        write( int idx, uint8_t val );
+        void        update( int idx, uint8_t val );
+        uint16_t    length( void );
+
+        template<typename T>
+        T          &get( int idx, T &t ){
+                        uint8_t *ptr = ( uint8_t * ) &t;
+                        for( size_t i=0 ; i<sizeof( T ) ; ++i ){ ptr[i] = this->read( idx+i ); }
+                        return( t );
+                    }
+        template<typename T>
+        const T    &put( int idx, const T &t ){
+                        const uint8_t *ptr = ( const uint8_t * ) &t;
+                        for( size_t i=0 ; i<sizeof( T ) ; ++i ){ this->update( idx+i, ptr[i] ); }
+                        return( t );
+                    }
+};
+
+extern EEPROMClass EEPROM;
+
+/* host simulation
+ */
+uint32_t            hostEepromWrites( int idx );
+uint32_t            hostEepromTotalWrites( void );
+
+#endif // __PWI_HOST_EEPROM_H__
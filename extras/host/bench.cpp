@@ -0,0 +1,201 @@
+/*
+ * Host microbenchmarks of the pwiCommon library.
+ *
+ * Durations are measured with pwiBench in real time, while the library runs
+ * against the simulated clock: the timers never expire during the Loop()
+ * benches, and the pulses are fed from scripted waveforms.
+ *
+ * The results are written as CSV to stdout:
+ * - first the durations, one row per bench and parameter;
+ * - then, after an empty line, the pulses missed depending on the main loop
+ *   duration, in polling and in interrupt modes.
+ *
+ * pwi 2026-10-18 creation
+ *                the sensors are globals
+ */
+
+#include <Arduino.h>
+#include <pwiBench.h>
+#include <pwiList.h>
+#include <pwiPulseSensor.h>
+#include <pwiTimer.h>
+
+#define TIMERS_MAX          10000
+#define LOOP_RUNS           200
+#define LIST_ITER_RUNS      20
+#define INPUT_RUNS          100000
+
+#define PULSE_PERIOD_US     20000
+#define PULSE_WIDTH_US      5000
+#define PULSE_COUNT         500
+
+/* a pulse sensor which neither measures nor sends anything
+ */
+class benchSensor : public pwiPulseSensor {
+    public:
+        benchSensor( uint8_t id, uint8_t input_pin, uint8_t edge ) : pwiPulseSensor( id, input_pin, edge ) {}
+    protected:
+        bool vMeasure() { return( false ); }
+        void vSend() {}
+};
+
+/* the sensors stay registered in the sensors and timers lists, and in the
+ * interrupt table, once created: they must outlive the benches
+ */
+static benchSensor st_input( 1, 4, FALLING );
+static benchSensor st_polling( 2, 0, FALLING );
+static benchSensor st_isr( 3, 1, FALLING );
+
+static void nopTimerCb( void *user_data )
+{
+}
+
+static void nopIterCb( void *element, void *user_data )
+{
+    *( uint32_t * ) user_data += 1;
+}
+
+/*
+ * cost of pwiTimer::Loop() against the count of registered timers
+ * as the timers cannot be removed, the same list grows from one step to the next
+ */
+static void benchTimerLoop( void )
+{
+    static const uint32_t steps[] = { 10, 100, 1000, 10000 };
+    uint32_t count = 0;
+
+    for( uint8_t i=0 ; i<sizeof( steps )/sizeof( steps[0] ) ; ++i ){
+        while( count < steps[i] ){
+            pwiTimer *timer = new pwiTimer();
+            timer->setup( "bench", 3600000UL, false, nopTimerCb );
+            timer->start();
+            count += 1;
+        }
+        pwiBench bench( "timer_loop" );
+        for( uint32_t r=0 ; r<LOOP_RUNS ; ++r ){
+            bench.start();
+            pwiTimer::Loop();
+            bench.stop();
+        }
+        bench.csv( count );
+    }
+}
+
+/*
+ * cost of pwiList::add() and pwiList::iter() against the list length
+ */
+static void benchList( void )
+{
+    static const uint32_t steps[] = { 10, 100, 1000, 10000 };
+    static uint32_t elements[TIMERS_MAX];
+
+    for( uint8_t i=0 ; i<sizeof( steps )/sizeof( steps[0] ) ; ++i ){
+        pwiList *list = new pwiList();
+        pwiBench add( "list_add" );
+        for( uint32_t e=0 ; e<steps[i] ; ++e ){
+            add.start();
+            list->add( &elements[e] );
+            add.stop();
+        }
+        add.csv( steps[i] );
+
+        pwiBench iter( "list_iter" );
+        for( uint32_t r=0 ; r<LIST_ITER_RUNS ; ++r ){
+            uint32_t n = 0;
+            iter.start();
+            list->iter( nopIterCb, &n );
+            iter.stop();
+        }
+        iter.csv( steps[i] );
+        // the list nodes cannot be released
+    }
+}
+
+/*
+ * per-call cost of pwiPulseSensor::loopInput() on a steady input
+ */
+static void benchLoopInput( void )
+{
+    pwiBench bench( "pulse_loop_input" );
+
+    hostPinSet( 4, HIGH );
+    for( uint32_t r=0 ; r<INPUT_RUNS ; ++r ){
+        bench.start();
+        st_input.loopInput();
+        bench.stop();
+        hostClockAdvance( 100 );
+    }
+    bench.csv( 0 );
+}
+
+/*
+ * pulses missed against the main loop duration
+ * the pulses are PULSE_WIDTH_US low every PULSE_PERIOD_US
+ */
+static uint32_t runPulses( pwiPulseSensor &sensor, uint8_t pin, uint32_t loop_us )
+{
+    static hostEdge wave[2*PULSE_COUNT];
+    uint64_t t0 = hostClockMicros() + PULSE_PERIOD_US;
+
+    for( uint32_t i=0 ; i<PULSE_COUNT ; ++i ){
+        uint64_t t = t0 + ( uint64_t ) i * PULSE_PERIOD_US;
+        wave[2*i].t_us = t;
+        wave[2*i].level = LOW;
+        wave[2*i+1].t_us = t + PULSE_WIDTH_US;
+        wave[2*i+1].level = HIGH;
+    }
+    hostPinScript( pin, wave, 2*PULSE_COUNT );
+
+    uint32_t before = sensor.getPulsesCount();
+    uint64_t end = t0 + ( uint64_t ) PULSE_COUNT * PULSE_PERIOD_US;
+    while( hostClockMicros() < end ){
+        sensor.loopInput();
+        hostClockAdvance( loop_us );
+    }
+    sensor.loopInput();
+    hostPinScript( pin, NULL, 0 );
+    return( sensor.getPulsesCount() - before );
+}
+
+static void benchMissedPulses( void )
+{
+    static const uint32_t loops_us[] = { 100, 1000, 2000, 4000, 5000, 6000, 10000, 15000, 20000, 30000 };
+    hostPinSet( 0, HIGH );
+    hostPinSet( 1, HIGH );
+    st_polling.setInputPin( 0 );
+    st_isr.setInputPin( 1 );
+    st_isr.setInterruptMode( true );
+
+    Serial.println();
+    Serial.println( F( "missed,loop_us,mode,expected,counted,missed" ));
+    for( uint8_t i=0 ; i<sizeof( loops_us )/sizeof( loops_us[0] ) ; ++i ){
+        for( uint8_t m=0 ; m<2 ; ++m ){
+            uint32_t counted = runPulses( m ? st_isr : st_polling, m, loops_us[i] );
+            Serial.print( F( "pulse_missed," ));
+            Serial.print(( unsigned long ) loops_us[i] );
+            Serial.print( m ? F( ",interrupt," ) : F( ",polling," ));
+            Serial.print(( unsigned long ) PULSE_COUNT );
+            Serial.print( ',' );
+            Serial.print(( unsigned long ) counted );
+            Serial.print( ',' );
+            Serial.println(( long ) PULSE_COUNT - ( long ) counted );
+        }
+    }
+    st_isr.setInterruptMode( false );
+}
+
+int main( int argc, char **argv )
+{
+    hostReset();
+    hostSerialEnable( true );
+    pwiBench::Begin();
+
+    pwiBench::CsvHeader();
+    benchList();
+    benchTimerLoop();
+    benchLoopInput();
+    benchMissedPulses();
+
+    pwiBench::End();
+    return( 0 );
+}
@@ -0,0 +1,98 @@
+#ifndef __PWI_HOST_MYSENSORS_CORE_H__
+#define __PWI_HOST_MYSENSORS_CORE_H__
+
+/*
+ * Host (Linux) replacement for the MySensors core header.
+ *
+ * Only the subset of the MySensors API used by the pwiCommon library is
+ * provided. The radio is simulated: send() succeeds while the transport is
+ * up, and each sent message is handed to an optional host callback.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <Arduino.h>
+
+#define MAX_PAYLOAD                     25
+#define EEPROM_LOCAL_CONFIG_ADDRESS     413
+
+typedef enum {
+    S_DOOR = 0, S_MOTION, S_SMOKE, S_BINARY, S_DIMMER, S_COVER, S_TEMP, S_HUM,
+    S_BARO, S_WIND, S_RAIN, S_UV, S_WEIGHT, S_POWER, S_HEATER, S_DISTANCE,
+    S_LIGHT_LEVEL, S_ARDUINO_NODE, S_ARDUINO_REPEATER_NODE, S_LOCK, S_IR,
+    S_WATER, S_AIR_QUALITY, S_CUSTOM, S_DUST, S_SCENE_CONTROLLER, S_RGB_LIGHT, S_RGBW_LIGHT,
+    S_COLOR_SENSOR, S_HVAC, S_MULTIMETER, S_SPRINKLER, S_WATER_LEAK, S_SOUND,
+    S_VIBRATION, S_MOISTURE, S_INFO, S_GAS, S_GPS, S_WATER_QUALITY
+}
+    mysensors_sensor_t;
+
+typedef enum {
+    V_TEMP = 0, V_HUM, V_STATUS, V_PERCENTAGE, V_PRESSURE, V_FORECAST, V_RAIN,
+    V_RAINRATE, V_WIND, V_GUST, V_DIRECTION, V_UV, V_WEIGHT, V_DISTANCE,
+    V_IMPEDANCE, V_ARMED, V_TRIPPED, V_WATT, V_KWH, V_SCENE_ON, V_SCENE_OFF,
+    V_HVAC_FLOW_STATE, V_HVAC_SPEED, V_LIGHT_LEVEL, V_VAR1, V_VAR2, V_VAR3,
+    V_VAR4, V_VAR5, V_UP, V_DOWN, V_STOP, V_IR_SEND, V_IR_RECEIVE, V_FLOW,
+    V_VOLUME, V_LOCK_STATUS, V_LEVEL, V_VOLTAGE, V_CURRENT, V_RGB, V_RGBW,
+    V_ID, V_UNIT_PREFIX, V_HVAC_SETPOINT_COOL, V_HVAC_SETPOINT_HEAT,
+    V_HVAC_FLOW_MODE, V_TEXT, V_CUSTOM
+}
+    mysensors_data_t;
+
+typedef enum {
+    P_STRING = 0, P_BYTE, P_INT16, P_UINT16, P_LONG32, P_ULONG32, P_CUSTOM, P_FLOAT32
+}
+    mysensors_payload_t;
+
+class MyMessage {
+    public:
+                    MyMessage( void );
+                    MyMessage( const uint8_t sensor, const mysensors_data_t type );
+
+        uint8_t     getSensor( void ) const;
+        MyMessage  &setSensor( const uint8_t sensor );
+        uint8_t     getType( void ) const;
+        MyMessage  &setType( const uint8_t type );
+        mysensors_payload_t getPayloadType( void ) const;
+        MyMessage  &setPayloadType( const mysensors_payload_t type );
+        uint8_t     getLength( void ) const;
+        MyMessage  &setLength( const uint8_t length );
+        const void *getCustom( void ) const;
+        const char *getString( void ) const;
+        int32_t     getLong( void ) const;
+        uint32_t    getULong( void ) const;
+        float       getFloat( void ) const;
+
+        MyMessage  &set( const void *payload, const size_t length );
+        MyMessage  &set( const char *value );
+        MyMessage  &set( const __FlashStringHelper *value );
+        MyMessage  &set( const bool value );
+        MyMessage  &set( const uint8_t value );
+        MyMessage  &set( const int16_t value );
+        MyMessage  &set( const uint16_t value );
+        MyMessage  &set( const int32_t value );
+        MyMessage  &set( const uint32_t value );
+        MyMessage  &set( const float value, const uint8_t decimals );
+
+    private:
+        uint8_t     sensor;
+        uint8_t     type;
+        uint8_t     payload_type;
+        uint8_t     length;
+        uint8_t     data[MAX_PAYLOAD+1];
+};
+
+bool                send( MyMessage &msg, const bool echo=false );
+bool                present( const uint8_t child, const mysensors_sensor_t type, const char *description="", const bool echo=false );
+bool                isTransportReady( void );
+void                saveState( const uint8_t pos, const uint8_t value );
+uint8_t             loadState( const uint8_t pos );
+
+/* host simulation of the radio link
+ */
+typedef void ( *hostSendCb )( const MyMessage &msg, void *user_data );
+
+void                hostTransportSet( bool up );
+void                hostTransportHook( hostSendCb cb, void *user_data );
+uint32_t            hostTransportSentCount( void );
+
+#endif // __PWI_HOST_MYSENSORS_CORE_H__
@@ -0,0 +1,135 @@
+/*
+ * Render the binary records dumped by pwiLog::Dump().
+ *
+ * The input is a capture of the Serial output of the node (on stdin, or in
+ * the file given as argument); any line which is not part of a dump is
+ * echoed unchanged, so that the records are rendered in the context of the
+ * other traces.
+ *
+ * The format strings are taken from pwiLogSites.h, so the decoder must be
+ * built from the same version of the library than the node.
+ *
+ * Usage: logdecode [<capture>]
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <Arduino.h>
+#include <pwiLog.h>
+
+static unsigned st_ptr_size = 2;
+
+static int hexValue( char c )
+{
+    if( c >= '0' && c <= '9' ) return( c-'0' );
+    if( c >= 'a' && c <= 'f' ) return( c-'a'+10 );
+    if( c >= 'A' && c <= 'F' ) return( c-'A'+10 );
+    return( -1 );
+}
+
+static uint64_t readLE( const uint8_t *p, unsigned size )
+{
+    uint64_t value = 0;
+    for( unsigned i=0 ; i<size ; ++i ){
+        value |= ( uint64_t ) p[i] << ( 8*i );
+    }
+    return( value );
+}
+
+/* render one record, whose bytes have been decoded from the hexa line
+ */
+static void render( const uint8_t *record, unsigned length )
+{
+    if( length < PWI_LOG_HEADER || record[0] != length ){
+        printf( "!! malformed record\n" );
+        return;
+    }
+    uint8_t site = record[1];
+    unsigned long ts = ( unsigned long ) readLE( record+2, 4 );
+    const char *format = pwiLog::GetFormat( site );
+    if( !format ){
+        printf( "[%10lu us] !! unknown site %u\n", ts, site );
+        return;
+    }
+
+    const uint8_t *arg = record+PWI_LOG_HEADER;
+    const uint8_t *end = record+length;
+    printf( "[%10lu us] ", ts );
+    for( const char *p=format ; *p ; ++p ){
+        if( *p != '%' ){
+            putchar( *p );
+            continue;
+        }
+        p += 1;
+        if( *p == '%' ){
+            putchar( '%' );
+            continue;
+        }
+        // width and length modifiers are ignored
+        while( *p && strchr( "0123456789-+ #lhz", *p )){
+            p += 1;
+        }
+        unsigned size = ( *p == 'p' ) ? st_ptr_size : 4;
+        if( arg+size > end ){
+            printf( "<?>" );
+        } else {
+            uint64_t value = readLE( arg, size );
+            switch( *p ){
+                case 'd':
+                    printf( "%ld", ( long )( int32_t ) value );
+                    break;
+                case 'x':
+                case 'X':
+                    printf( "%lx", ( unsigned long ) value );
+                    break;
+                case 'p':
+                    printf( "0x%0*llx", 2*size, ( unsigned long long ) value );
+                    break;
+                default:
+                    printf( "%lu", ( unsigned long ) value );
+                    break;
+            }
+            arg += size;
+        }
+        if( !*p ){
+            break;
+        }
+    }
+    putchar( '\n' );
+}
+
+int main( int argc, char **argv )
+{
+    FILE *fp = stdin;
+    char line[1024];
+
+    if( argc > 1 && !( fp = fopen( argv[1], "r" ))){
+        perror( argv[1] );
+        return( 1 );
+    }
+    while( fgets( line, sizeof( line ), fp )){
+        unsigned version, ptr_size, dropped;
+        if( sscanf( line, "!LOG %u %u %u", &version, &ptr_size, &dropped ) == 3 ){
+            if( version != PWI_LOG_VERSION ){
+                printf( "!! unsupported dump version %u\n", version );
+            }
+            st_ptr_size = ptr_size;
+            if( dropped ){
+                printf( "!! %u records dropped\n", dropped );
+            }
+        } else if( !strncmp( line, "!L ", 3 )){
+            uint8_t record[256];
+            unsigned length = 0;
+            for( const char *p=line+3 ; length<sizeof( record ) && hexValue( p[0] ) >= 0 && hexValue( p[1] ) >= 0 ; p+=2 ){
+                record[length++] = ( hexValue( p[0] ) << 4 ) | hexValue( p[1] );
+            }
+            render( record, length );
+        } else if( strncmp( line, "!END", 4 )){
+            fputs( line, stdout );
+        }
+    }
+    if( fp != stdin ){
+        fclose( fp );
+    }
+    return( 0 );
+}
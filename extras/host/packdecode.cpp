@@ -0,0 +1,218 @@
+/*
+ * Decode the frames built by pwiPack, or simulate a lossy link to check the
+ * delta channels.
+ *
+ * Decode mode: the input (on stdin, or in the file given as argument) holds
+ * one received frame per line, as '<node> <hex bytes>', e.g. as extracted
+ * from the logs of the controller; '<node> reset' forgets the bases of the
+ * node (e.g. after it has rebooted), and '#' starts a comment. Each field is
+ * printed as:
+ *    <node> <seq> <channel> <type> <value>
+ * with type being one of 'u'nsigned, 's'igned, 'd'elta or 'a'bsolute.
+ *
+ * Simulation mode (-s): a node sends frames of several counter channels
+ * through a link which loses frames and echoes, and the decoded values are
+ * checked against the sent ones.
+ *
+ * Usage: packdecode [options] [<file>]
+ *  -s              simulate instead of decoding
+ *  -n <count>      simulation: count of frames (1000)
+ *  -c <count>      simulation: count of counter channels (4)
+ *  -i <max>        simulation: max increment of a counter per frame (50)
+ *  -l <percent>    simulation: loss rate of the frames (10)
+ *  -a <percent>    simulation: loss rate of the echoes (10)
+ *  -r <seed>       random seed (1)
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <Arduino.h>
+#include <pwiPack.h>
+
+#include <unistd.h>
+
+#define MAX_NODES           256
+#define MAX_CHANNELS        16
+
+static const char st_types[] = "usda";
+
+static pwiPackDecoder *st_decoders[MAX_NODES];
+
+static int hexValue( char c )
+{
+    if( c >= '0' && c <= '9' ) return( c-'0' );
+    if( c >= 'a' && c <= 'f' ) return( c-'a'+10 );
+    if( c >= 'A' && c <= 'F' ) return( c-'A'+10 );
+    return( -1 );
+}
+
+/* decode mode
+ */
+typedef struct {
+    unsigned node;
+    unsigned seq;
+}
+    sFrame;
+
+static void printCb( uint8_t channel, uint8_t type, uint32_t value, sFrame *frame )
+{
+    if( type == PWI_PACK_SIGNED ){
+        printf( "%u %u %u %c %ld\n", frame->node, frame->seq, channel, st_types[type], ( long )( int32_t ) value );
+    } else {
+        printf( "%u %u %u %c %lu\n", frame->node, frame->seq, channel, st_types[type], ( unsigned long ) value );
+    }
+}
+
+static int decodeFile( FILE *fp )
+{
+    char line[1024];
+    int errors = 0;
+
+    while( fgets( line, sizeof( line ), fp )){
+        char *p = line;
+        unsigned node;
+        int consumed;
+        if( *p == '#' || sscanf( p, "%u %n", &node, &consumed ) != 1 || node >= MAX_NODES ){
+            continue;
+        }
+        p += consumed;
+        if( !st_decoders[node] ){
+            st_decoders[node] = new pwiPackDecoder;
+        }
+        if( !strncmp( p, "reset", 5 )){
+            st_decoders[node]->reset();
+            continue;
+        }
+        uint8_t frame[MAX_PAYLOAD];
+        uint8_t length = 0;
+        for( ; *p && length<sizeof( frame ) ; ++p ){
+            if( hexValue( p[0] ) >= 0 && hexValue( p[1] ) >= 0 ){
+                frame[length++] = ( hexValue( p[0] ) << 4 ) | hexValue( p[1] );
+                p += 1;
+            }
+        }
+        sFrame info = { node, length ? frame[0] : 0u };
+        uint8_t status = st_decoders[node]->decode( frame, length, ( pwiPackDecoderCb ) printCb, &info );
+        if( status != PWI_PACK_OK ){
+            printf( "!! %u %u %s\n", node, info.seq, status == PWI_PACK_ERR01 ? "truncated frame" : "unknown delta base" );
+            errors += 1;
+        }
+    }
+    return( errors );
+}
+
+/* simulation mode
+ */
+static uint32_t st_seed = 1;
+
+static uint32_t rnd( uint32_t max )
+{
+    // xorshift32, deterministic across the platforms
+    st_seed ^= st_seed << 13;
+    st_seed ^= st_seed >> 17;
+    st_seed ^= st_seed << 5;
+    return( max ? st_seed % max : 0 );
+}
+
+typedef struct {
+    uint32_t expected[MAX_CHANNELS];
+    uint32_t decoded;
+    uint32_t wrong;
+}
+    sCheck;
+
+static void checkCb( uint8_t channel, uint8_t type, uint32_t value, sCheck *check )
+{
+    check->decoded += 1;
+    if( channel >= MAX_CHANNELS || value != check->expected[channel] ){
+        check->wrong += 1;
+    }
+}
+
+static int simulate( uint32_t frames, uint32_t channels, uint32_t increment, uint32_t frame_loss, uint32_t echo_loss )
+{
+    pwiPackChannel *chans[MAX_CHANNELS];
+    uint32_t counters[MAX_CHANNELS];
+    pwiPackDecoder decoder;
+    sCheck check;
+    uint32_t received = 0, fields = 0, deltas = 0, skipped = 0, packed_bytes = 0, text_bytes = 0;
+
+    memset( &check, '\0', sizeof( check ));
+    for( uint32_t c=0 ; c<channels ; ++c ){
+        chans[c] = new pwiPackChannel( c );
+        // start from large counts, as an absolute 32-bits count would be
+        counters[c] = 1000000 + rnd( 1000000 );
+    }
+    for( uint32_t f=0 ; f<frames ; ++f ){
+        pwiPack pack;
+        for( uint32_t c=0 ; c<channels ; ++c ){
+            counters[c] += rnd( increment+1 );
+            if( !pack.addDelta( *chans[c], counters[c] )){
+                fprintf( stderr, "frame full at channel %u\n", c );
+                return( 1 );
+            }
+            deltas += chans[c]->isAcked() ? 1 : 0;
+            check.expected[c] = counters[c];
+            // a text message per channel: the decimal count
+            text_bytes += snprintf( NULL, 0, "%lu", ( unsigned long ) counters[c] );
+        }
+        packed_bytes += pack.getLength();
+        if( rnd( 100 ) < frame_loss ){
+            continue;
+        }
+        received += 1;
+        fields += channels;
+        uint32_t before = check.decoded;
+        if( decoder.decode( pack.getBuffer(), pack.getLength(), ( pwiPackDecoderCb ) checkCb, &check ) != PWI_PACK_OK ){
+            skipped += channels - ( check.decoded - before );
+        }
+        if( rnd( 100 ) >= echo_loss ){
+            pwiPackChannel::Ack( pwiPack::GetSeq( pack.getBuffer()));
+        }
+    }
+    printf( "frames sent:        %lu (%lu channels each)\n", ( unsigned long ) frames, ( unsigned long ) channels );
+    printf( "frames received:    %lu\n", ( unsigned long ) received );
+    printf( "fields decoded:     %lu of %lu\n", ( unsigned long ) check.decoded, ( unsigned long ) fields );
+    printf( "fields skipped:     %lu (unknown base)\n", ( unsigned long ) skipped );
+    printf( "wrong values:       %lu\n", ( unsigned long ) check.wrong );
+    printf( "delta fields:       %.1f%%\n", frames ? 100.0 * deltas / ( frames*channels ) : 0.0 );
+    printf( "mean frame:         %.1f bytes\n", frames ? ( double ) packed_bytes / frames : 0.0 );
+    printf( "text equivalent:    %.1f bytes in %lu messages\n", frames ? ( double ) text_bytes / frames : 0.0, ( unsigned long ) channels );
+    return( check.wrong || skipped ? 2 : 0 );
+}
+
+int main( int argc, char **argv )
+{
+    uint32_t frames = 1000, channels = 4, increment = 50, frame_loss = 10, echo_loss = 10;
+    bool sim = false;
+    int opt;
+
+    while(( opt = getopt( argc, argv, "sn:c:i:l:a:r:" )) != -1 ){
+        switch( opt ){
+            case 's': sim = true; break;
+            case 'n': frames = strtoul( optarg, NULL, 0 ); break;
+            case 'c': channels = min( strtoul( optarg, NULL, 0 ), ( unsigned long ) MAX_CHANNELS ); break;
+            case 'i': increment = strtoul( optarg, NULL, 0 ); break;
+            case 'l': frame_loss = strtoul( optarg, NULL, 0 ); break;
+            case 'a': echo_loss = strtoul( optarg, NULL, 0 ); break;
+            case 'r': st_seed = max( strtoul( optarg, NULL, 0 ), 1UL ); break;
+            default:
+                fprintf( stderr, "see the head of packdecode.cpp for the options\n" );
+                return( 1 );
+        }
+    }
+    if( sim ){
+        return( simulate( frames, channels, increment, frame_loss, echo_loss ));
+    }
+
+    FILE *fp = stdin;
+    if( optind < argc && !( fp = fopen( argv[optind], "r" ))){
+        perror( argv[optind] );
+        return( 1 );
+    }
+    int errors = decodeFile( fp );
+    if( fp != stdin ){
+        fclose( fp );
+    }
+    return( errors ? 2 : 0 );
+}
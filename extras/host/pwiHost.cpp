@@ -0,0 +1,655 @@
+/*
+ * Host (Linux) simulation of the Arduino and MySensors environments.
+ *
+ * pwi 2026-10-18 creation
+ *                float payloads are 5 bytes long, as in MySensors
+ */
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <core/MySensorsCore.h>
+
+/* simulated clock
+ */
+static uint64_t st_clock_us = 0;
+
+/* simulated pins
+ */
+typedef struct {
+    uint8_t             level;
+    uint8_t             mode;
+    const hostEdge     *edges;
+    size_t              count;
+    size_t              next;
+    uint32_t            reads;
+}
+    hostPin;
+
+static hostPin st_pins[HOST_PINS_COUNT];
+
+/* simulated input registers, one per 8 pins
+ */
+static volatile uint8_t st_ports[HOST_PINS_COUNT/8];
+
+/* attached interrupt handlers, indexed by pin (irq number == pin number)
+ */
+typedef struct {
+    void              ( *isr )( void );
+    int                 mode;
+}
+    hostIrq;
+
+static hostIrq st_irqs[HOST_IRQ_COUNT];
+
+/* simulated serial
+ */
+HardwareSerial Serial;
+static bool st_serial_enabled = false;
+
+/* simulated eeprom
+ */
+EEPROMClass EEPROM;
+static uint8_t  st_eeprom[HOST_EEPROM_SIZE];
+static uint32_t st_eeprom_writes[HOST_EEPROM_SIZE];
+
+/* simulated radio
+ */
+static bool        st_transport_up = true;
+static hostSendCb  st_send_cb = NULL;
+static void       *st_send_data = NULL;
+static uint32_t    st_sent_count = 0;
+
+/*
+ * Set the pin level, firing the attached interrupt handler on a matching edge.
+ */
+static void pin_set_level( uint8_t pin, uint8_t level )
+{
+    hostPin *p = &st_pins[pin];
+    uint8_t prev = p->level;
+    p->level = level ? HIGH : LOW;
+    if( p->level ){
+        st_ports[pin/8] |= ( 1 << ( pin%8 ));
+    } else {
+        st_ports[pin/8] &= ~( 1 << ( pin%8 ));
+    }
+    if( p->level != prev && st_irqs[pin].isr ){
+        int mode = st_irqs[pin].mode;
+        if( mode == CHANGE
+                || ( mode == RISING && p->level == HIGH )
+                || ( mode == FALLING && p->level == LOW )){
+            st_irqs[pin].isr();
+        }
+    }
+}
+
+/*
+ * Apply all the scripted edges up to (and including) @t_us.
+ */
+static void pins_apply_until( uint64_t t_us )
+{
+    bool found = true;
+    while( found ){
+        // apply the edges in chronological order, whatever be the pin
+        found = false;
+        uint8_t best_pin = 0;
+        uint64_t best_t = 0;
+        for( uint8_t i=0 ; i<HOST_PINS_COUNT ; ++i ){
+            hostPin *p = &st_pins[i];
+            if( p->edges && p->next < p->count && p->edges[p->next].t_us <= t_us ){
+                if( !found || p->edges[p->next].t_us < best_t ){
+                    found = true;
+                    best_pin = i;
+                    best_t = p->edges[p->next].t_us;
+                }
+            }
+        }
+        if( found ){
+            hostPin *p = &st_pins[best_pin];
+            if( best_t > st_clock_us ){
+                st_clock_us = best_t;
+            }
+            uint8_t level = p->edges[p->next].level;
+            p->next += 1;
+            pin_set_level( best_pin, level );
+        }
+    }
+}
+
+uint64_t hostClockMicros( void )
+{
+    return( st_clock_us );
+}
+
+void hostClockSet( uint64_t t_us )
+{
+    st_clock_us = t_us;
+    for( uint8_t i=0 ; i<HOST_PINS_COUNT ; ++i ){
+        hostPin *p = &st_pins[i];
+        while( p->edges && p->next < p->count && p->edges[p->next].t_us <= t_us ){
+            p->level = p->edges[p->next].level;
+            p->next += 1;
+        }
+        if( p->level ){
+            st_ports[i/8] |= ( 1 << ( i%8 ));
+        } else {
+            st_ports[i/8] &= ~( 1 << ( i%8 ));
+        }
+    }
+}
+
+void hostClockAdvance( uint64_t delta_us )
+{
+    uint64_t target = st_clock_us + delta_us;
+    pins_apply_until( target );
+    st_clock_us = target;
+}
+
+void hostPinSet( uint8_t pin, uint8_t level )
+{
+    if( pin < HOST_PINS_COUNT ){
+        pin_set_level( pin, level );
+    }
+}
+
+void hostPinScript( uint8_t pin, const hostEdge *edges, size_t count )
+{
+    if( pin < HOST_PINS_COUNT ){
+        st_pins[pin].edges = edges;
+        st_pins[pin].count = count;
+        st_pins[pin].next = 0;
+        // edges already in the past are silently applied
+        while( st_pins[pin].next < count && edges[st_pins[pin].next].t_us <= st_clock_us ){
+            st_pins[pin].level = edges[st_pins[pin].next].level;
+            st_pins[pin].next += 1;
+        }
+        if( st_pins[pin].level ){
+            st_ports[pin/8] |= ( 1 << ( pin%8 ));
+        } else {
+            st_ports[pin/8] &= ~( 1 << ( pin%8 ));
+        }
+    }
+}
+
+uint32_t hostPinReadCount( uint8_t pin )
+{
+    return( pin < HOST_PINS_COUNT ? st_pins[pin].reads : 0 );
+}
+
+void hostSerialEnable( bool enabled )
+{
+    st_serial_enabled = enabled;
+}
+
+void hostReset( void )
+{
+    st_clock_us = 0;
+    memset( st_pins, 0, sizeof( st_pins ));
+    for( uint8_t i=0 ; i<HOST_PINS_COUNT ; ++i ){
+        st_pins[i].level = HIGH;
+    }
+    memset(( void * ) st_ports, 0xff, sizeof( st_ports ));
+    memset( st_irqs, 0, sizeof( st_irqs ));
+    memset( st_eeprom, 0xff, sizeof( st_eeprom ));
+    memset( st_eeprom_writes, 0, sizeof( st_eeprom_writes ));
+    st_transport_up = true;
+    st_send_cb = NULL;
+    st_send_data = NULL;
+    st_sent_count = 0;
+}
+
+/* Arduino core
+ */
+unsigned long millis( void )
+{
+    return(( unsigned long )( uint32_t )( st_clock_us / 1000 ));
+}
+
+unsigned long micros( void )
+{
+    return(( unsigned long )( uint32_t ) st_clock_us );
+}
+
+void delay( unsigned long ms )
+{
+    hostClockAdvance(( uint64_t ) ms * 1000 );
+}
+
+void delayMicroseconds( unsigned int us )
+{
+    hostClockAdvance( us );
+}
+
+void pinMode( uint8_t pin, uint8_t mode )
+{
+    if( pin < HOST_PINS_COUNT ){
+        st_pins[pin].mode = mode;
+    }
+}
+
+void digitalWrite( uint8_t pin, uint8_t val )
+{
+    // an input pin is only pulled-up, the level stays driven by the script
+    if( pin < HOST_PINS_COUNT && st_pins[pin].mode == OUTPUT ){
+        pin_set_level( pin, val );
+    }
+}
+
+int digitalRead( uint8_t pin )
+{
+    if( pin < HOST_PINS_COUNT ){
+        st_pins[pin].reads += 1;
+        return( st_pins[pin].level );
+    }
+    return( LOW );
+}
+
+uint8_t hostPinToPort( uint8_t pin )
+{
+    return( pin < HOST_PINS_COUNT ? 1 + pin/8 : NOT_A_PORT );
+}
+
+volatile uint8_t *hostPortInputRegister( uint8_t port )
+{
+    return( port && port <= HOST_PINS_COUNT/8 ? &st_ports[port-1] : NULL );
+}
+
+int hostPinToInterrupt( uint8_t pin )
+{
+    return( pin < HOST_IRQ_COUNT ? pin : NOT_AN_INTERRUPT );
+}
+
+void attachInterrupt( uint8_t irq, void ( *isr )( void ), int mode )
+{
+    if( irq < HOST_IRQ_COUNT ){
+        st_irqs[irq].isr = isr;
+        st_irqs[irq].mode = mode;
+    }
+}
+
+void detachInterrupt( uint8_t irq )
+{
+    if( irq < HOST_IRQ_COUNT ){
+        st_irqs[irq].isr = NULL;
+    }
+}
+
+/*
+ * AVR libc understands '%S' as a string in program memory, while glibc
+ * understands it as a wide string: rewrite the format accordingly.
+ */
+int vsnprintf_P( char *buf, size_t size, const char *fmt, va_list ap )
+{
+    char local[256];
+    size_t i = 0;
+    for( const char *c=fmt ; *c && i<sizeof( local )-1 ; ++c ){
+        if( c[0] == '%' && c[1] == '%' ){
+            local[i++] = *c++;
+            if( i < sizeof( local )-1 ){
+                local[i++] = *c;
+            }
+        } else if( c[0] == '%' && c[1] == 'S' ){
+            local[i++] = '%';
+            if( i < sizeof( local )-1 ){
+                local[i++] = 's';
+            }
+            c++;
+        } else {
+            local[i++] = *c;
+        }
+    }
+    local[i] = '\0';
+    return( vsnprintf( buf, size, local, ap ));
+}
+
+int snprintf_P( char *buf, size_t size, const char *fmt, ... )
+{
+    va_list ap;
+    va_start( ap, fmt );
+    int res = vsnprintf_P( buf, size, fmt, ap );
+    va_end( ap );
+    return( res );
+}
+
+/* serial
+ */
+void HardwareSerial::begin( unsigned long baud )
+{
+}
+
+size_t HardwareSerial::write( uint8_t c )
+{
+    if( st_serial_enabled ){
+        fputc( c, stdout );
+    }
+    return( 1 );
+}
+
+size_t HardwareSerial::write( const uint8_t *buf, size_t size )
+{
+    if( st_serial_enabled ){
+        fwrite( buf, 1, size, stdout );
+    }
+    return( size );
+}
+
+size_t HardwareSerial::print( const __FlashStringHelper *str )
+{
+    return( this->print(( const char * ) str ));
+}
+
+size_t HardwareSerial::print( const char *str )
+{
+    return( str ? this->write(( const uint8_t * ) str, strlen( str )) : 0 );
+}
+
+size_t HardwareSerial::print( char c )
+{
+    return( this->write(( uint8_t ) c ));
+}
+
+size_t HardwareSerial::print( unsigned char n, int base )
+{
+    return( this->print(( unsigned long ) n, base ));
+}
+
+size_t HardwareSerial::print( int n, int base )
+{
+    return( this->print(( long ) n, base ));
+}
+
+size_t HardwareSerial::print( unsigned int n, int base )
+{
+    return( this->print(( unsigned long ) n, base ));
+}
+
+size_t HardwareSerial::print( long n, int base )
+{
+    if( n < 0 && base == DEC ){
+        return( this->print( '-' ) + this->print(( unsigned long ) -n, base ));
+    }
+    return( this->print(( unsigned long ) n, base ));
+}
+
+size_t HardwareSerial::print( unsigned long n, int base )
+{
+    char buf[8*sizeof( long )+1];
+    char *str = &buf[sizeof( buf )-1];
+    *str = '\0';
+    if( base < 2 ){
+        base = 10;
+    }
+    do {
+        unsigned long m = n;
+        n /= base;
+        char c = m - base * n;
+        *--str = c < 10 ? c + '0' : c + 'A' - 10;
+    } while( n );
+    return( this->print( str ));
+}
+
+size_t HardwareSerial::print( double n, int digits )
+{
+    char buf[32];
+    snprintf( buf, sizeof( buf ), "%.*f", digits, n );
+    return( this->print( buf ));
+}
+
+size_t HardwareSerial::println( void )
+{
+    return( this->print( "\r\n" ));
+}
+
+/* eeprom
+ */
+uint8_t EEPROMClass::read( int idx )
+{
+    return( idx >= 0 && idx < HOST_EEPROM_SIZE ? st_eeprom[idx] : 0xff );
+}
+
+void EEPROMClass::write( int idx, uint8_t val )
+{
+    if( idx >= 0 && idx < HOST_EEPROM_SIZE ){
+        st_eeprom[idx] = val;
+        st_eeprom_writes[idx] += 1;
+    }
+}
+
+void EEPROMClass::update( int idx, uint8_t val )
+{
+    if( this->read( idx ) != val ){
+        this->write( idx, val );
+    }
+}
+
+uint16_t EEPROMClass::length( void )
+{
+    return( HOST_EEPROM_SIZE );
+}
+
+uint32_t hostEepromWrites( int idx )
+{
+    return( idx >= 0 && idx < HOST_EEPROM_SIZE ? st_eeprom_writes[idx] : 0 );
+}
+
+uint32_t hostEepromTotalWrites( void )
+{
+    uint32_t total = 0;
+    for( int i=0 ; i<HOST_EEPROM_SIZE ; ++i ){
+        total += st_eeprom_writes[i];
+    }
+    return( total );
+}
+
+/* MySensors
+ */
+MyMessage::MyMessage( void )
+{
+    memset( this, 0, sizeof( *this ));
+}
+
+MyMessage::MyMessage( const uint8_t sensor, const mysensors_data_t type )
+{
+    memset( this, 0, sizeof( *this ));
+    this->sensor = sensor;
+    this->type = type;
+}
+
+uint8_t MyMessage::getSensor( void ) const
+{
+    return( this->sensor );
+}
+
+MyMessage &MyMessage::setSensor( const uint8_t sensor )
+{
+    this->sensor = sensor;
+    return( *this );
+}
+
+uint8_t MyMessage::getType( void ) const
+{
+    return( this->type );
+}
+
+MyMessage &MyMessage::setType( const uint8_t type )
+{
+    this->type = type;
+    return( *this );
+}
+
+mysensors_payload_t MyMessage::getPayloadType( void ) const
+{
+    return(( mysensors_payload_t ) this->payload_type );
+}
+
+MyMessage &MyMessage::setPayloadType( const mysensors_payload_t type )
+{
+    this->payload_type = type;
+    return( *this );
+}
+
+uint8_t MyMessage::getLength( void ) const
+{
+    return( this->length );
+}
+
+MyMessage &MyMessage::setLength( const uint8_t length )
+{
+    this->length = min( length, MAX_PAYLOAD );
+    return( *this );
+}
+
+const void *MyMessage::getCustom( void ) const
+{
+    return( this->data );
+}
+
+const char *MyMessage::getString( void ) const
+{
+    return(( const char * ) this->data );
+}
+
+int32_t MyMessage::getLong( void ) const
+{
+    int32_t v;
+    memcpy( &v, this->data, sizeof( v ));
+    return( v );
+}
+
+uint32_t MyMessage::getULong( void ) const
+{
+    uint32_t v;
+    memcpy( &v, this->data, sizeof( v ));
+    return( v );
+}
+
+float MyMessage::getFloat( void ) const
+{
+    float v;
+    memcpy( &v, this->data, sizeof( v ));
+    return( v );
+}
+
+MyMessage &MyMessage::set( const void *payload, const size_t length )
+{
+    this->length = min( length, ( size_t ) MAX_PAYLOAD );
+    this->payload_type = P_CUSTOM;
+    memcpy( this->data, payload, this->length );
+    return( *this );
+}
+
+MyMessage &MyMessage::set( const char *value )
+{
+    this->length = value ? min( strlen( value ), ( size_t ) MAX_PAYLOAD ) : 0;
+    this->payload_type = P_STRING;
+    memcpy( this->data, value, this->length );
+    this->data[this->length] = '\0';
+    return( *this );
+}
+
+MyMessage &MyMessage::set( const __FlashStringHelper *value )
+{
+    return( this->set(( const char * ) value ));
+}
+
+MyMessage &MyMessage::set( const bool value )
+{
+    return( this->set(( uint8_t ) value ));
+}
+
+MyMessage &MyMessage::set( const uint8_t value )
+{
+    this->length = 1;
+    this->payload_type = P_BYTE;
+    this->data[0] = value;
+    return( *this );
+}
+
+MyMessage &MyMessage::set( const int16_t value )
+{
+    this->length = 2;
+    this->payload_type = P_INT16;
+    memcpy( this->data, &value, 2 );
+    return( *this );
+}
+
+MyMessage &MyMessage::set( const uint16_t value )
+{
+    this->length = 2;
+    this->payload_type = P_UINT16;
+    memcpy( this->data, &value, 2 );
+    return( *this );
+}
+
+MyMessage &MyMessage::set( const int32_t value )
+{
+    this->length = 4;
+    this->payload_type = P_LONG32;
+    memcpy( this->data, &value, 4 );
+    return( *this );
+}
+
+MyMessage &MyMessage::set( const uint32_t value )
+{
+    this->length = 4;
+    this->payload_type = P_ULONG32;
+    memcpy( this->data, &value, 4 );
+    return( *this );
+}
+
+MyMessage &MyMessage::set( const float value, const uint8_t decimals )
+{
+    // as MySensors, the float is followed by its precision
+    this->length = 5;
+    this->payload_type = P_FLOAT32;
+    memcpy( this->data, &value, 4 );
+    this->data[4] = decimals;
+    return( *this );
+}
+
+bool send( MyMessage &msg, const bool echo )
+{
+    if( !st_transport_up ){
+        return( false );
+    }
+    st_sent_count += 1;
+    if( st_send_cb ){
+        st_send_cb( msg, st_send_data );
+    }
+    return( true );
+}
+
+bool present( const uint8_t child, const mysensors_sensor_t type, const char *description, const bool echo )
+{
+    return( st_transport_up );
+}
+
+bool isTransportReady( void )
+{
+    return( st_transport_up );
+}
+
+void saveState( const uint8_t pos, const uint8_t value )
+{
+    EEPROM.update( EEPROM_LOCAL_CONFIG_ADDRESS+pos, value );
+}
+
+uint8_t loadState( const uint8_t pos )
+{
+    return( EEPROM.read( EEPROM_LOCAL_CONFIG_ADDRESS+pos ));
+}
+
+void hostTransportSet( bool up )
+{
+    st_transport_up = up;
+}
+
+void hostTransportHook( hostSendCb cb, void *user_data )
+{
+    st_send_cb = cb;
+    st_send_data = user_data;
+}
+
+uint32_t hostTransportSentCount( void )
+{
+    return( st_sent_count );
+}
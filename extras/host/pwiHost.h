@@ -0,0 +1,63 @@
+#ifndef __PWI_HOST_H__
+#define __PWI_HOST_H__
+
+/*
+ * Control interface of the host simulation.
+ *
+ * The simulated clock is a 64-bits count of microseconds; millis() and
+ * micros() return its truncated value, so that the Arduino rollovers can be
+ * reproduced by just setting the clock near to them.
+ *
+ * A pin level is either set directly, or scripted as a list of timestamped
+ * edges. When the clock is advanced, each scripted edge which is crossed
+ * fires the interrupt handler attached to the pin (if any), the clock being
+ * set at the edge timestamp during the handler.
+ *
+ * Synopsys:
+ * a) script the input:
+ *    static const hostEdge wave[] = {{ 1000, LOW }, { 1200, HIGH }, ... };
+ *    hostPinScript( 3, wave, sizeof( wave )/sizeof( wave[0] ));
+ * b) run the loop while advancing the clock:
+ *    while( hostClockMicros() < end_us ){
+ *        sensor.loopInput();
+ *        hostClockAdvance( 500 );
+ *    }
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define HOST_PINS_COUNT     32
+#define HOST_IRQ_COUNT      HOST_PINS_COUNT
+
+/* a scripted edge: the pin takes the @level at @t_us (absolute simulated time)
+ */
+typedef struct {
+    uint64_t    t_us;
+    uint8_t     level;
+}
+    hostEdge;
+
+/* clock
+ */
+uint64_t            hostClockMicros( void );
+void                hostClockSet( uint64_t t_us );
+void                hostClockAdvance( uint64_t delta_us );
+
+/* pins
+ */
+void                hostPinSet( uint8_t pin, uint8_t level );
+void                hostPinScript( uint8_t pin, const hostEdge *edges, size_t count );
+uint32_t            hostPinReadCount( uint8_t pin );
+
+/* serial output: disabled by default
+ */
+void                hostSerialEnable( bool enabled );
+
+/* reset the whole simulation (clock, pins, interrupts, eeprom, transport)
+ */
+void                hostReset( void );
+
+#endif // __PWI_HOST_H__
@@ -0,0 +1,380 @@
+/*
+ * Replay a pulse trace into a pwiPulseSensor, and report how well the
+ * pulses have been counted.
+ *
+ * The trace is either read from a file, or synthetized from a few
+ * parameters (count, period, width and contact bounce of the pulses). It is
+ * fed to the sensor input through the host simulation, while the main loop
+ * calls loopInput() with a configurable period, random jitter, and periodic
+ * long stalls which mimic a blocking vMeasure() or radio transmission.
+ *
+ * Each counted pulse is attributed to the latest true pulse which has started
+ * before it has been observed. A true pulse which gets no count is a miss;
+ * each count beyond the first one is a double count.
+ *
+ * Trace file format: one edge per line, '#' starts a comment:
+ *    <t_us> <level> [*]
+ * where the optional '*' marks the edge which starts a true pulse. When no
+ * edge is marked, a true pulse is assumed on each active edge which follows
+ * an idle level stable for at least the guard delay (-G).
+ *
+ * Usage: replay [options]
+ *  -f <file>       read the trace from this file
+ *  -o <file>       write the (synthetic) trace to this file
+ *  -n <count>      synthetic: count of pulses (100)
+ *  -p <us>         synthetic: pulse period (100000)
+ *  -w <us>         synthetic: pulse width (30000)
+ *  -b <count>      synthetic: count of bounces on each transition (0)
+ *  -B <us>         synthetic: max duration of the bounces (1000)
+ *  -G <us>         guard delay to find the true pulses of an unmarked trace (2000)
+ *  -l <us>         main loop period (1000)
+ *  -j <us>         max random jitter added to each loop period (0)
+ *  -s <us>         duration of the stalls (0)
+ *  -S <ms>         mean interval between two stalls (1000)
+ *  -i              count the pulses in interrupt mode (default is polling)
+ *  -d <strategy>   lockout, integrator or consecutive (lockout)
+ *  -D <param>      debounce parameter, see pwiDebounce::setup() (0)
+ *  -r <seed>       random seed (1)
+ *  -c              print the report as CSV
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <Arduino.h>
+#include <pwiPulseSensor.h>
+
+#include <unistd.h>
+
+#define INPUT_PIN           1
+#define IDLE_LEVEL          HIGH
+#define ACTIVE_LEVEL        LOW
+
+/* a pulse sensor which neither measures nor sends anything
+ */
+class replaySensor : public pwiPulseSensor {
+    public:
+        replaySensor( uint8_t id, uint8_t input_pin, uint8_t edge ) : pwiPulseSensor( id, input_pin, edge ) {}
+    protected:
+        bool vMeasure() { return( false ); }
+        void vSend() {}
+};
+
+/* the trace
+ */
+static hostEdge *st_edges = NULL;
+static size_t    st_edges_count = 0;
+static size_t    st_edges_size = 0;
+
+/* the true pulses: start timestamps and count of attributed detections
+ */
+static uint64_t *st_pulses = NULL;
+static uint32_t *st_hits = NULL;
+static size_t    st_pulses_count = 0;
+static size_t    st_pulses_size = 0;
+
+static uint32_t  st_spurious = 0;
+static uint64_t  st_latency_max = 0;
+static uint64_t  st_latency_total = 0;
+static uint32_t  st_latency_count = 0;
+
+/* a small xorshift generator, so that the results do not depend on the libc
+ */
+static uint32_t  st_seed = 1;
+
+static uint32_t rnd( uint32_t max )
+{
+    st_seed ^= st_seed << 13;
+    st_seed ^= st_seed >> 17;
+    st_seed ^= st_seed << 5;
+    return( max ? st_seed % ( max+1 ) : 0 );
+}
+
+static void addEdge( uint64_t t_us, uint8_t level )
+{
+    if( st_edges_count == st_edges_size ){
+        st_edges_size = st_edges_size ? 2*st_edges_size : 1024;
+        st_edges = ( hostEdge * ) realloc( st_edges, st_edges_size * sizeof( hostEdge ));
+    }
+    st_edges[st_edges_count].t_us = t_us;
+    st_edges[st_edges_count].level = level;
+    st_edges_count += 1;
+}
+
+static void addPulse( uint64_t t_us )
+{
+    if( st_pulses_count == st_pulses_size ){
+        st_pulses_size = st_pulses_size ? 2*st_pulses_size : 1024;
+        st_pulses = ( uint64_t * ) realloc( st_pulses, st_pulses_size * sizeof( uint64_t ));
+    }
+    st_pulses[st_pulses_count] = t_us;
+    st_pulses_count += 1;
+}
+
+/* a transition to @level at @t_us, preceded by @bounces glitches spread
+ * over @span_us
+ */
+static void addTransition( uint64_t t_us, uint8_t level, uint32_t bounces, uint32_t span_us )
+{
+    uint64_t t = t_us;
+    for( uint32_t i=0 ; i<bounces ; ++i ){
+        addEdge( t, level );
+        t += 1 + rnd( span_us / ( 2*bounces ));
+        addEdge( t, !level );
+        t += 1 + rnd( span_us / ( 2*bounces ));
+    }
+    addEdge( t, level );
+}
+
+static void synthetize( uint32_t count, uint32_t period_us, uint32_t width_us, uint32_t bounces, uint32_t span_us )
+{
+    for( uint32_t i=0 ; i<count ; ++i ){
+        uint64_t t = ( uint64_t )( i+1 ) * period_us;
+        addPulse( t );
+        addTransition( t, ACTIVE_LEVEL, bounces, span_us );
+        addTransition( t + width_us, IDLE_LEVEL, bounces, span_us );
+    }
+}
+
+static bool readTrace( const char *path, uint32_t guard_us )
+{
+    FILE *fp = fopen( path, "r" );
+    if( !fp ){
+        perror( path );
+        return( false );
+    }
+    char line[128];
+    while( fgets( line, sizeof( line ), fp )){
+        unsigned long long t;
+        unsigned level;
+        char mark[2] = "";
+        if( line[0] == '#' || sscanf( line, "%llu %u %1s", &t, &level, mark ) < 2 ){
+            continue;
+        }
+        addEdge( t, level ? HIGH : LOW );
+        if( mark[0] == '*' ){
+            addPulse( t );
+        }
+    }
+    fclose( fp );
+
+    // no marked pulse: find the active edges after a stable idle level
+    if( !st_pulses_count ){
+        uint64_t idle_since = 0;
+        uint8_t level = IDLE_LEVEL;
+        for( size_t i=0 ; i<st_edges_count ; ++i ){
+            if( st_edges[i].level == level ){
+                continue;
+            }
+            if( st_edges[i].level == ACTIVE_LEVEL && st_edges[i].t_us - idle_since >= guard_us ){
+                addPulse( st_edges[i].t_us );
+            }
+            level = st_edges[i].level;
+            if( level == IDLE_LEVEL ){
+                idle_since = st_edges[i].t_us;
+            }
+        }
+    }
+    return( true );
+}
+
+static void writeTrace( const char *path )
+{
+    FILE *fp = fopen( path, "w" );
+    if( !fp ){
+        perror( path );
+        return;
+    }
+    size_t p = 0;
+    fprintf( fp, "# t_us level [*: start of a true pulse]\n" );
+    for( size_t i=0 ; i<st_edges_count ; ++i ){
+        bool start = p < st_pulses_count && st_pulses[p] == st_edges[i].t_us && st_edges[i].level == ACTIVE_LEVEL;
+        fprintf( fp, "%llu %u%s\n", ( unsigned long long ) st_edges[i].t_us, st_edges[i].level, start ? " *" : "" );
+        if( start ){
+            p += 1;
+        }
+    }
+    fclose( fp );
+}
+
+/* attribute a detection observed at @t_us to the latest true pulse started
+ * before it
+ */
+static void attribute( uint64_t t_us )
+{
+    size_t lo = 0, hi = st_pulses_count;
+    while( lo < hi ){
+        size_t mid = ( lo+hi )/2;
+        if( st_pulses[mid] <= t_us ){
+            lo = mid+1;
+        } else {
+            hi = mid;
+        }
+    }
+    if( !lo ){
+        st_spurious += 1;
+        return;
+    }
+    st_hits[lo-1] += 1;
+    if( st_hits[lo-1] == 1 ){
+        uint64_t latency = t_us - st_pulses[lo-1];
+        st_latency_total += latency;
+        st_latency_count += 1;
+        if( latency > st_latency_max ){
+            st_latency_max = latency;
+        }
+    }
+}
+
+static void observe( replaySensor &sensor, uint32_t &last )
+{
+    uint32_t count = sensor.getPulsesCount();
+    while( last != count ){
+        attribute( hostClockMicros());
+        last += 1;
+    }
+}
+
+/* advance the clock to @target, stopping on each edge so that the counts
+ * of the interrupt service routine are timestamped at the edge
+ */
+static void advanceTo( replaySensor &sensor, uint32_t &last, size_t &next, uint64_t target )
+{
+    while( next < st_edges_count && st_edges[next].t_us <= target ){
+        if( st_edges[next].t_us > hostClockMicros()){
+            hostClockAdvance( st_edges[next].t_us - hostClockMicros());
+        }
+        observe( sensor, last );
+        next += 1;
+    }
+    if( target > hostClockMicros()){
+        hostClockAdvance( target - hostClockMicros());
+    }
+}
+
+static uint8_t parseStrategy( const char *str )
+{
+    if( !strcmp( str, "integrator" )){
+        return( PWI_DEBOUNCE_INTEGRATOR );
+    }
+    if( !strcmp( str, "consecutive" )){
+        return( PWI_DEBOUNCE_CONSECUTIVE );
+    }
+    return( PWI_DEBOUNCE_LOCKOUT );
+}
+
+int main( int argc, char **argv )
+{
+    const char *input = NULL;
+    const char *output = NULL;
+    uint32_t count = 100, period_us = 100000, width_us = 30000, bounces = 0, span_us = 1000, guard_us = 2000;
+    uint32_t loop_us = 1000, jitter_us = 0, stall_us = 0, stall_ms = 1000, param = 0;
+    uint8_t strategy = PWI_DEBOUNCE_LOCKOUT;
+    bool interrupt = false, csv = false;
+    int opt;
+
+    while(( opt = getopt( argc, argv, "f:o:n:p:w:b:B:G:l:j:s:S:id:D:r:c" )) != -1 ){
+        switch( opt ){
+            case 'f': input = optarg; break;
+            case 'o': output = optarg; break;
+            case 'n': count = strtoul( optarg, NULL, 0 ); break;
+            case 'p': period_us = strtoul( optarg, NULL, 0 ); break;
+            case 'w': width_us = strtoul( optarg, NULL, 0 ); break;
+            case 'b': bounces = strtoul( optarg, NULL, 0 ); break;
+            case 'B': span_us = strtoul( optarg, NULL, 0 ); break;
+            case 'G': guard_us = strtoul( optarg, NULL, 0 ); break;
+            case 'l': loop_us = max( strtoul( optarg, NULL, 0 ), 1UL ); break;
+            case 'j': jitter_us = strtoul( optarg, NULL, 0 ); break;
+            case 's': stall_us = strtoul( optarg, NULL, 0 ); break;
+            case 'S': stall_ms = max( strtoul( optarg, NULL, 0 ), 1UL ); break;
+            case 'i': interrupt = true; break;
+            case 'd': strategy = parseStrategy( optarg ); break;
+            case 'D': param = strtoul( optarg, NULL, 0 ); break;
+            case 'r': st_seed = max( strtoul( optarg, NULL, 0 ), 1UL ); break;
+            case 'c': csv = true; break;
+            default:
+                fprintf( stderr, "see the head of replay.cpp for the options\n" );
+                return( 1 );
+        }
+    }
+
+    if( input ){
+        if( !readTrace( input, guard_us )){
+            return( 1 );
+        }
+    } else {
+        synthetize( count, period_us, width_us, bounces, span_us );
+    }
+    if( output ){
+        writeTrace( output );
+    }
+    if( !st_edges_count ){
+        fprintf( stderr, "empty trace\n" );
+        return( 1 );
+    }
+    st_hits = ( uint32_t * ) calloc( st_pulses_count+1, sizeof( uint32_t ));
+
+    hostReset();
+    hostPinSet( INPUT_PIN, IDLE_LEVEL );
+    replaySensor sensor( 1, INPUT_PIN, FALLING );
+    sensor.setDebounce( strategy, param );
+    sensor.setInputPin( INPUT_PIN );
+    if( interrupt && !sensor.setInterruptMode( true )){
+        fprintf( stderr, "unable to set the interrupt mode\n" );
+        return( 1 );
+    }
+    hostPinScript( INPUT_PIN, st_edges, st_edges_count );
+
+    uint64_t end_us = st_edges[st_edges_count-1].t_us + 2*loop_us + stall_us;
+    uint64_t next_stall = stall_us ? 1000ULL * ( 1 + rnd( 2*stall_ms )) : 0;
+    uint64_t stalled_us = 0;
+    uint32_t loops = 0, stalls = 0, last = 0;
+    size_t next = 0;
+
+    while( hostClockMicros() < end_us ){
+        sensor.loopInput();
+        observe( sensor, last );
+        loops += 1;
+        uint64_t target = hostClockMicros() + loop_us + rnd( jitter_us );
+        if( next_stall && target >= next_stall ){
+            target += stall_us;
+            stalled_us += stall_us;
+            stalls += 1;
+            next_stall = target + 1000ULL * ( 1 + rnd( 2*stall_ms ));
+        }
+        advanceTo( sensor, last, next, target );
+    }
+
+    uint32_t missed = 0, doubles = st_spurious, detected = 0;
+    for( size_t i=0 ; i<st_pulses_count ; ++i ){
+        if( st_hits[i] ){
+            detected += 1;
+            doubles += st_hits[i]-1;
+        } else {
+            missed += 1;
+        }
+    }
+    double accuracy = st_pulses_count ? 100.0 * ( detected - ( double ) doubles ) / st_pulses_count : 0;
+    unsigned long latency_mean = st_latency_count ? ( unsigned long )( st_latency_total / st_latency_count ) : 0;
+
+    if( csv ){
+        printf( "mode,loop_us,jitter_us,stall_us,stalls,strategy,param,expected,counted,missed,doubles,accuracy,latency_mean_us,latency_max_us\n" );
+        printf( "%s,%lu,%lu,%lu,%lu,%u,%lu,%lu,%lu,%lu,%lu,%.2f,%lu,%lu\n",
+                interrupt ? "interrupt" : "polling",
+                ( unsigned long ) loop_us, ( unsigned long ) jitter_us, ( unsigned long ) stall_us, ( unsigned long ) stalls,
+                strategy, ( unsigned long ) param,
+                ( unsigned long ) st_pulses_count, ( unsigned long ) sensor.getPulsesCount(),
+                ( unsigned long ) missed, ( unsigned long ) doubles, accuracy,
+                latency_mean, ( unsigned long ) st_latency_max );
+    } else {
+        printf( "edges:          %lu\n", ( unsigned long ) st_edges_count );
+        printf( "loops:          %lu (%lu stalls, %llu us stalled)\n", ( unsigned long ) loops, ( unsigned long ) stalls, ( unsigned long long ) stalled_us );
+        printf( "mode:           %s\n", interrupt ? "interrupt" : "polling" );
+        printf( "expected:       %lu\n", ( unsigned long ) st_pulses_count );
+        printf( "counted:        %lu\n", ( unsigned long ) sensor.getPulsesCount());
+        printf( "missed:         %lu\n", ( unsigned long ) missed );
+        printf( "double counts:  %lu\n", ( unsigned long ) doubles );
+        printf( "accuracy:       %.2f %%\n", accuracy );
+        printf( "latency:        mean %lu us, max %lu us\n", latency_mean, ( unsigned long ) st_latency_max );
+    }
+    return( missed || doubles ? 2 : 0 );
+}
@@ -0,0 +1,105 @@
+#ifndef __PWI_HOST_CHECK_H__
+#define __PWI_HOST_CHECK_H__
+
+/*
+ * Minimal assertions for the host tests.
+ *
+ * Each test program runs its scenarios on the simulated clock, prints one
+ * line per failed check, and exits with a non-zero status if any check has
+ * failed, so that 'make check' stops on the first failing program. A program
+ * which has not run any check fails too, unless it explicitly skips its
+ * scenarios because an optional feature is not built in (see checkSkip()):
+ * 'make check' then runs it again with the optional features.
+ *
+ * As the timers and the sensors register themselves in never-shrinking
+ * static lists, the objects under test must outlive the scenarios: they are
+ * defined as globals, and stopped at the end of their scenario.
+ *
+ * Synopsys:
+ *    static void scenarioFoo( void )
+ *    {
+ *        checkBegin( "foo" );
+ *        ...
+ *        CHECK_EQ( count, 10 );
+ *    }
+ *    int main( void )
+ *    {
+ *        scenarioFoo();
+ *        return( checkEnd( "foo" ));
+ *    }
+ *
+ * pwi 2026-10-18 creation
+ *                a program without any check fails, new checkSkip()
+ */
+
+#include <Arduino.h>
+#include <pwiTimer.h>
+
+static const char *st_check_scenario = "";
+static unsigned    st_check_count = 0;
+static unsigned    st_check_failures = 0;
+
+#define CHECK( expr )           checkTrue(( expr ), #expr, __FILE__, __LINE__ )
+#define CHECK_EQ( a, b )        checkEqual(( unsigned long long )( a ), ( unsigned long long )( b ), #a, #b, __FILE__, __LINE__ )
+
+/* start a new scenario from a fresh simulation
+ */
+static inline void checkBegin( const char *scenario )
+{
+    st_check_scenario = scenario;
+    hostReset();
+}
+
+static inline void checkTrue( bool ok, const char *expr, const char *file, int line )
+{
+    st_check_count += 1;
+    if( !ok ){
+        st_check_failures += 1;
+        printf( "%s:%d: [%s] CHECK( %s ) failed\n", file, line, st_check_scenario, expr );
+    }
+}
+
+static inline void checkEqual( unsigned long long a, unsigned long long b, const char *expr_a, const char *expr_b, const char *file, int line )
+{
+    st_check_count += 1;
+    if( a != b ){
+        st_check_failures += 1;
+        printf( "%s:%d: [%s] CHECK_EQ( %s, %s ) failed: %llu != %llu\n", file, line, st_check_scenario, expr_a, expr_b, a, b );
+    }
+}
+
+/* run the main loop for @duration_us, advancing the clock by @step_us
+ * between two iterations
+ */
+static inline void checkRun( uint64_t duration_us, uint32_t step_us )
+{
+    uint64_t end_us = hostClockMicros() + duration_us;
+    while( hostClockMicros() < end_us ){
+        hostClockAdvance( step_us );
+        pwiTimer::Loop();
+    }
+}
+
+/* print the summary of the @program
+ *
+ * Returns: the exit status of the program, which is a failure if no check
+ * has been run at all.
+ */
+static inline int checkEnd( const char *program )
+{
+    printf( "%s: %u checks, %u failed\n", program, st_check_count, st_check_failures );
+    return( st_check_failures || !st_check_count ? 1 : 0 );
+}
+
+/* print that the @program has been skipped, because it needs the optional
+ * @feature which is not built in
+ *
+ * Returns: the exit status of the program.
+ */
+static inline int checkSkip( const char *program, const char *feature )
+{
+    printf( "%s: skipped, needs %s\n", program, feature );
+    return( 0 );
+}
+
+#endif // __PWI_HOST_CHECK_H__
@@ -0,0 +1,127 @@
+/*
+ * Deterministic tests of the wrap-safe helpers and of the clocks of
+ * pwiClock on the simulated clock.
+ *
+ * The clocks keep a static state, so that the checks are made on the
+ * differences between two calls.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <pwiClock.h>
+
+/* the helpers only rely on the difference of the timestamps, and so are
+ * unaffected by the wrap of the counter
+ */
+static void scenarioHelpers( void )
+{
+    checkBegin( "helpers" );
+    CHECK_EQ( pwiElapsed( 100, 250 ), 150 );
+    CHECK_EQ( pwiElapsed( 0xfffffff0, 0x10 ), 0x20 );
+
+    CHECK( pwiReached( 0xfffffff0, 0x20, 0x10 ));
+    CHECK( !pwiReached( 0xfffffff0, 0x21, 0x10 ));
+
+    CHECK_EQ( pwiRemaining( 0xfffffff0, 0x30, 0x10 ), 0x10 );
+    CHECK_EQ( pwiRemaining( 0xfffffff0, 0x20, 0x10 ), 0 );
+    CHECK_EQ( pwiRemaining( 100, 50, 1000 ), 0 );
+
+    CHECK( pwiBefore( 0xfffffff0, 0x10 ));
+    CHECK( !pwiBefore( 0x10, 0xfffffff0 ));
+    CHECK( !pwiBefore( 5, 5 ));
+    CHECK( pwiBefore( 0, 0x7fffffff ));
+    CHECK( !pwiBefore( 0, 0x80000001 ));
+}
+
+/* the default clock is millis()
+ */
+static void scenarioMillis( void )
+{
+    checkBegin( "millis" );
+    hostClockAdvance( 12345678 );
+    CHECK_EQ( pwiMillisClock::Now(), 12345 );
+    CHECK_EQ( pwiMillisClock::Now(), millis());
+}
+
+/* the micros() clock accumulates the sub-ms remainders, and goes through
+ * the wrap of micros()
+ */
+static void scenarioMicros( void )
+{
+    checkBegin( "micros" );
+    uint32_t start = pwiMicrosClock::Now();
+    for( uint8_t i=0 ; i<10 ; ++i ){
+        hostClockAdvance( 1500 );
+        pwiMicrosClock::Now();
+    }
+    CHECK_EQ( pwiMicrosClock::Now() - start, 15 );
+    hostClockAdvance( 400 );
+    CHECK_EQ( pwiMicrosClock::Now() - start, 15 );
+    hostClockAdvance( 600 );
+    CHECK_EQ( pwiMicrosClock::Now() - start, 16 );
+
+    // micros() wraps after 2^32 us
+    hostClockSet( 0xffffffffULL - 2000 );
+    start = pwiMicrosClock::Now();
+    hostClockAdvance( 1000 );
+    CHECK_EQ( pwiMicrosClock::Now() - start, 1 );
+    hostClockAdvance( 3000 );
+    CHECK( micros() < 2000 );
+    CHECK_EQ( pwiMicrosClock::Now() - start, 4 );
+}
+
+/* the RTC clock counts the ticks, interpolates with millis() inside a
+ * second, and never goes back
+ */
+static void scenarioRtc( void )
+{
+    checkBegin( "rtc" );
+    hostClockAdvance( 5000000 );
+    pwiRtcClock::Set( 100 );
+    CHECK_EQ( pwiRtcClock::Now(), 100000 );
+    hostClockAdvance( 500000 );
+    CHECK_EQ( pwiRtcClock::Now(), 100500 );
+
+    hostClockAdvance( 500000 );
+    pwiRtcClock::Tick();
+    CHECK_EQ( pwiRtcClock::Now(), 101000 );
+
+    // a late tick: the interpolation stops at the end of the second
+    hostClockAdvance( 1300000 );
+    CHECK_EQ( pwiRtcClock::Now(), 101999 );
+    pwiRtcClock::Tick();
+    CHECK_EQ( pwiRtcClock::Now(), 102000 );
+
+    // millis() does not run during a deep sleep: the RTC is read back
+    hostClockAdvance( 10000 );
+    pwiRtcClock::Set( 3600 );
+    CHECK_EQ( pwiRtcClock::Now(), 3600000 );
+
+    // a RTC set backwards does not make the clock go back
+    pwiRtcClock::Set( 3000 );
+    CHECK_EQ( pwiRtcClock::Now(), 3600000 );
+}
+
+/* the manual clock only moves when told so, and wraps
+ */
+static void scenarioManual( void )
+{
+    checkBegin( "manual" );
+    pwiManualClock::Set( 0xfffffffe );
+    hostClockAdvance( 1000000 );
+    CHECK_EQ( pwiManualClock::Now(), 0xfffffffe );
+    pwiManualClock::Advance( 5 );
+    CHECK_EQ( pwiManualClock::Now(), 3 );
+    CHECK( pwiReached( 0xfffffffe, 5, pwiManualClock::Now()));
+}
+
+int main( void )
+{
+    scenarioHelpers();
+    scenarioMillis();
+    scenarioMicros();
+    scenarioRtc();
+    scenarioManual();
+    return( checkEnd( "clock" ));
+}
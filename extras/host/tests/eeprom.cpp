@@ -0,0 +1,165 @@
+/*
+ * Deterministic tests of pwiEepromRing on the simulated EEPROM: wear
+ * leveling, wrap of the ring and of the sequence numbers, and restore after
+ * an interrupted write.
+ *
+ * Each pwiEepromRing instance stands for one boot of the node.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <EEPROM.h>
+#include <pwiEepromRing.h>
+
+#define RING_ADDRESS        100
+#define RING_SLOTS          4
+#define SLOT_SIZE           7
+
+/* the address of the slot @index of the ring
+ */
+static int slotAddress( uint8_t index )
+{
+    return( RING_ADDRESS + index*SLOT_SIZE );
+}
+
+/* a blank EEPROM has nothing to restore, and the ring then starts with its
+ * first slot
+ */
+static void scenarioErased( void )
+{
+    checkBegin( "erased" );
+    pwiEepromRing ring;
+    uint32_t value = 42;
+    ring.setup( RING_ADDRESS, RING_SLOTS );
+    CHECK_EQ( ring.getSize(), RING_SLOTS*SLOT_SIZE );
+    CHECK( !ring.restore( value ));
+    CHECK_EQ( value, 42 );
+
+    ring.write( 1 );
+    CHECK_EQ( ring.getWritesCount(), 1 );
+    CHECK( EEPROM.read( slotAddress( 0 )) != 0xff );
+    CHECK_EQ( EEPROM.read( slotAddress( 1 )), 0xff );
+    CHECK_EQ( hostEepromTotalWrites(), SLOT_SIZE );
+}
+
+/* the writes go round the ring, the last one being restored on next boot,
+ * and each slot being written once per turn
+ */
+static void scenarioWrap( void )
+{
+    checkBegin( "wrap" );
+    pwiEepromRing first;
+    first.setup( RING_ADDRESS, RING_SLOTS );
+    for( uint32_t v=1 ; v<=10 ; ++v ){
+        first.write( 1000+v );
+    }
+    for( uint8_t i=0 ; i<RING_SLOTS ; ++i ){
+        // the low byte of the sequence changes on each write of the slot
+        CHECK_EQ( hostEepromWrites( slotAddress( i )), i < 10 % RING_SLOTS ? 3 : 2 );
+    }
+    CHECK_EQ( hostEepromWrites( slotAddress( RING_SLOTS )), 0 );
+
+    pwiEepromRing second;
+    uint32_t value = 0;
+    second.setup( RING_ADDRESS, RING_SLOTS );
+    CHECK( second.restore( value ));
+    CHECK_EQ( value, 1010 );
+
+    // the next write goes to the slot after the restored one
+    second.write( 1011 );
+    CHECK_EQ( hostEepromWrites( slotAddress( 10 % RING_SLOTS )), 3 );
+    pwiEepromRing third;
+    third.setup( RING_ADDRESS, RING_SLOTS );
+    CHECK( third.restore( value ));
+    CHECK_EQ( value, 1011 );
+}
+
+/* the sequence numbers wrap around 16 bits, skipping the erased marker
+ */
+static void scenarioSequence( void )
+{
+    checkBegin( "sequence" );
+    pwiEepromRing first;
+    first.setup( RING_ADDRESS, 3 );
+    for( uint32_t v=1 ; v<=70000 ; ++v ){
+        first.write( v );
+        if( v == 65533 || v == 65534 || v == 65535 || v == 65536 || v == 70000 ){
+            pwiEepromRing boot;
+            uint32_t value = 0;
+            boot.setup( RING_ADDRESS, 3 );
+            CHECK( boot.restore( value ));
+            CHECK_EQ( value, v );
+        }
+    }
+}
+
+/* an interrupted write, whatever its last written byte, leaves the previous
+ * value to be restored
+ */
+static void scenarioTorn( void )
+{
+    checkBegin( "torn" );
+    pwiEepromRing first;
+    first.setup( RING_ADDRESS, RING_SLOTS );
+    for( uint32_t v=1 ; v<=6 ; ++v ){
+        first.write( v );
+    }
+    // the seventh write goes to the slot #2: tear it after each byte
+    uint8_t saved[SLOT_SIZE];
+    for( uint8_t i=0 ; i<SLOT_SIZE ; ++i ){
+        saved[i] = EEPROM.read( slotAddress( 2 )+i );
+    }
+    first.write( 0x12345678 );
+    uint8_t written[SLOT_SIZE];
+    for( uint8_t i=0 ; i<SLOT_SIZE ; ++i ){
+        written[i] = EEPROM.read( slotAddress( 2 )+i );
+    }
+    for( uint8_t torn=1 ; torn<SLOT_SIZE ; ++torn ){
+        for( uint8_t i=0 ; i<SLOT_SIZE ; ++i ){
+            EEPROM.write( slotAddress( 2 )+i, i < torn ? written[i] : saved[i] );
+        }
+        pwiEepromRing boot;
+        uint32_t value = 0;
+        boot.setup( RING_ADDRESS, RING_SLOTS );
+        CHECK( boot.restore( value ));
+        CHECK_EQ( value, 6 );
+    }
+
+    // the next boot writes over the torn slot
+    pwiEepromRing boot;
+    uint32_t value = 0;
+    boot.setup( RING_ADDRESS, RING_SLOTS );
+    CHECK( boot.restore( value ));
+    boot.write( 7 );
+    CHECK_EQ( EEPROM.read( slotAddress( 2 )+2 ), 7 );
+    pwiEepromRing after;
+    after.setup( RING_ADDRESS, RING_SLOTS );
+    CHECK( after.restore( value ));
+    CHECK_EQ( value, 7 );
+}
+
+/* a torn first write of a blank ring is not restored either
+ */
+static void scenarioTornBlank( void )
+{
+    checkBegin( "torn blank" );
+    pwiEepromRing blank;
+    uint32_t value = 0;
+    blank.setup( RING_ADDRESS, RING_SLOTS );
+    blank.write( 1 );
+    EEPROM.write( slotAddress( 0 )+SLOT_SIZE-1, 0xff );
+    pwiEepromRing reboot;
+    reboot.setup( RING_ADDRESS, RING_SLOTS );
+    CHECK( !reboot.restore( value ));
+}
+
+int main( void )
+{
+    scenarioErased();
+    scenarioWrap();
+    scenarioSequence();
+    scenarioTorn();
+    scenarioTornBlank();
+    return( checkEnd( "eeprom" ));
+}
@@ -0,0 +1,125 @@
+/*
+ * Tests of pwiEventLoop.
+ *
+ * The pwiTimer's run on the simulated clock, while the loop sleeps on a
+ * real timerfd: the scenarios check that the loop is woken up on time, not
+ * on the exact sleep durations.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <pwiEventLoop.h>
+#include <time.h>
+#include <unistd.h>
+
+static pwiTimer st_timer;
+static uint32_t st_fired;
+
+static int      st_pipe[2];
+static uint32_t st_reads;
+
+static void timerCb( void *user_data )
+{
+    st_fired += 1;
+}
+
+static void readCb( int fd, uint32_t events, void *user_data )
+{
+    char c;
+    if(( events & EPOLLIN ) && read( fd, &c, 1 ) == 1 ){
+        st_reads += 1;
+    }
+}
+
+/* the real time, in ms
+ */
+static uint32_t realMs( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return(( uint32_t )( ts.tv_sec * 1000 + ts.tv_nsec / 1000000 ));
+}
+
+/* the ready file descriptors are dispatched to their callback
+ */
+static void scenarioFds( void )
+{
+    checkBegin( "fds" );
+    CHECK( !pwiEventLoop::AddFd( st_pipe[0], EPOLLIN, readCb ));
+    CHECK( pwiEventLoop::Setup());
+    CHECK( pwiEventLoop::AddFd( st_pipe[0], EPOLLIN, readCb ));
+
+    CHECK_EQ( write( st_pipe[1], "x", 1 ), 1 );
+    CHECK_EQ( pwiEventLoop::Loop( NULL, 1000 ), 1 );
+    CHECK_EQ( st_reads, 1 );
+
+    // nothing is ready: the loop returns after max_wait_ms
+    uint32_t start = realMs();
+    CHECK_EQ( pwiEventLoop::Loop( NULL, 20 ), 0 );
+    CHECK( realMs() - start >= 15 );
+    CHECK_EQ( st_reads, 1 );
+
+    CHECK( pwiEventLoop::RemoveFd( st_pipe[0] ));
+    CHECK( !pwiEventLoop::RemoveFd( st_pipe[0] ));
+    CHECK_EQ( write( st_pipe[1], "x", 1 ), 1 );
+    CHECK_EQ( pwiEventLoop::Loop( NULL, 20 ), 0 );
+    CHECK_EQ( st_reads, 1 );
+    char c;
+    CHECK_EQ( read( st_pipe[0], &c, 1 ), 1 );
+}
+
+/* the loop sleeps until the next timer deadline, and runs the expired
+ * timers
+ */
+static void scenarioTimers( void )
+{
+    checkBegin( "timers" );
+    CHECK( pwiEventLoop::Setup());
+    st_timer.setup( "Loop", 50, true, timerCb );
+    st_timer.start();
+
+    // not due yet: the timerfd wakes the loop up after about 50 ms, even
+    // without any max wait
+    uint32_t start = realMs();
+    CHECK_EQ( pwiEventLoop::Loop( NULL, -1 ), 0 );
+    uint32_t slept = realMs() - start;
+    CHECK( slept >= 40 && slept < 1000 );
+    CHECK_EQ( st_fired, 0 );
+
+    // due: the loop does not sleep, and runs the timer
+    hostClockAdvance( 50000 );
+    start = realMs();
+    CHECK_EQ( pwiEventLoop::Loop( NULL, 1000 ), 0 );
+    CHECK( realMs() - start < 500 );
+    CHECK_EQ( st_fired, 1 );
+    CHECK( !st_timer.isStarted());
+}
+
+/* Wakeup() interrupts a loop which would sleep forever
+ */
+static void scenarioWakeup( void )
+{
+    checkBegin( "wakeup" );
+    CHECK( pwiEventLoop::Setup());
+    pwiEventLoop::Wakeup();
+    uint32_t start = realMs();
+    CHECK_EQ( pwiEventLoop::Loop( NULL, -1 ), 0 );
+    CHECK( realMs() - start < 500 );
+
+    pwiEventLoop::Close();
+    CHECK_EQ( pwiEventLoop::Loop( NULL, 0 ), -1 );
+}
+
+int main( void )
+{
+    if( pipe( st_pipe ) < 0 ){
+        return( 1 );
+    }
+    scenarioFds();
+    scenarioTimers();
+    scenarioWakeup();
+    close( st_pipe[0] );
+    close( st_pipe[1] );
+    return( checkEnd( "eventloop" ));
+}
@@ -0,0 +1,125 @@
+/*
+ * Deterministic tests of the change detection of pwiFilteredSensor.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <pwiFilteredSensor.h>
+
+/* a filtered sensor without filter, which reads a value set by the test
+ */
+class testSensor : public pwiFilteredSensor<uint16_t> {
+    public:
+        testSensor( uint8_t id ) : pwiFilteredSensor<uint16_t>( id ), raw( 0 ), sends( 0 ) {}
+        uint16_t    raw;
+        uint32_t    sends;
+    protected:
+        bool vRead( uint16_t &raw ) { raw = this->raw; return( true ); }
+        void vSend() { this->sends += 1; }
+};
+
+/* the same with signed samples
+ */
+class testSignedSensor : public pwiFilteredSensor<int8_t> {
+    public:
+        testSignedSensor( uint8_t id ) : pwiFilteredSensor<int8_t>( id ), raw( 0 ), sends( 0 ) {}
+        int8_t      raw;
+        uint32_t    sends;
+    protected:
+        bool vRead( int8_t &raw ) { raw = this->raw; return( true ); }
+        void vSend() { this->sends += 1; }
+};
+
+static testSensor       st_sensor( 1 );
+static testSignedSensor st_signed( 2 );
+
+/* set the raw value, and run one min period
+ */
+static void measure( uint16_t raw )
+{
+    st_sensor.raw = raw;
+    checkRun( 100000, 1000 );
+}
+
+/* with the default zero threshold, any change is sent, and an unchanged
+ * value is not
+ */
+static void scenarioAnyChange( void )
+{
+    checkBegin( "any change" );
+    CHECK_EQ( st_sensor.getThreshold(), 0 );
+    st_sensor.setTimers( 100, 0 );
+    // the first measure is always sent
+    measure( 10 );
+    CHECK_EQ( st_sensor.sends, 1 );
+    measure( 10 );
+    measure( 10 );
+    CHECK_EQ( st_sensor.sends, 1 );
+    measure( 11 );
+    CHECK_EQ( st_sensor.sends, 2 );
+    measure( 11 );
+    CHECK_EQ( st_sensor.sends, 2 );
+    measure( 10 );
+    CHECK_EQ( st_sensor.sends, 3 );
+    st_sensor.setTimers( 0, 0 );
+}
+
+/* with a threshold, a change is sent when |value - sent| >= threshold, the
+ * small changes being accumulated against the last sent value
+ */
+static void scenarioThreshold( void )
+{
+    checkBegin( "threshold" );
+    st_sensor.setThreshold( 4 );
+    st_sensor.setTimers( 100, 0 );
+    st_sensor.sends = 0;
+    measure( 10 );
+    CHECK_EQ( st_sensor.sends, 0 );
+    measure( 13 );
+    CHECK_EQ( st_sensor.sends, 0 );
+    measure( 14 );
+    CHECK_EQ( st_sensor.sends, 1 );
+    CHECK_EQ( st_sensor.getValue(), 14 );
+    measure( 11 );
+    CHECK_EQ( st_sensor.sends, 1 );
+    measure( 10 );
+    CHECK_EQ( st_sensor.sends, 2 );
+    st_sensor.setTimers( 0, 0 );
+    st_sensor.setThreshold( 0 );
+}
+
+/* with signed samples, a swing wider than half the range of the type is
+ * still a change
+ */
+static void scenarioSigned( void )
+{
+    checkBegin( "signed" );
+    st_signed.setThreshold( 4 );
+    st_signed.setTimers( 100, 0 );
+    st_signed.raw = -100;
+    checkRun( 100000, 1000 );
+    CHECK_EQ( st_signed.sends, 1 );
+    st_signed.raw = 100;
+    checkRun( 100000, 1000 );
+    CHECK_EQ( st_signed.sends, 2 );
+    CHECK_EQ( st_signed.getValue(), 100 );
+    st_signed.raw = -128;
+    checkRun( 100000, 1000 );
+    CHECK_EQ( st_signed.sends, 3 );
+    st_signed.raw = -125;
+    checkRun( 100000, 1000 );
+    CHECK_EQ( st_signed.sends, 3 );
+    st_signed.raw = 127;
+    checkRun( 100000, 1000 );
+    CHECK_EQ( st_signed.sends, 4 );
+    st_signed.setTimers( 0, 0 );
+}
+
+int main( void )
+{
+    scenarioAnyChange();
+    scenarioThreshold();
+    scenarioSigned();
+    return( checkEnd( "filtered" ));
+}
@@ -0,0 +1,143 @@
+/*
+ * Deterministic tests of pwiSensorGroup on the simulated clock.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <pwiSensorGroup.h>
+
+static uint32_t st_conversions;
+static uint32_t st_conversion_ms;
+
+/* the order of the measures of the members
+ */
+static uint8_t  st_order[8];
+static uint8_t  st_ordered;
+
+static void convertCb( void *user_data )
+{
+    st_conversions += 1;
+    st_conversion_ms = millis();
+}
+
+/* a member which records when it is measured
+ */
+class testSensor : public pwiSensor {
+    public:
+        testSensor( uint8_t id ) : pwiSensor( id ), measures( 0 ), measure_ms( 0 ), converted( 0 ) {}
+        uint32_t    measures;
+        uint32_t    measure_ms;
+        uint32_t    converted;
+        bool        isGrouped() { return( this->getGroup() != NULL ); }
+    protected:
+        bool vMeasure() {
+            this->measures += 1;
+            this->measure_ms = millis();
+            this->converted = st_conversions;
+            if( st_ordered < sizeof( st_order )){
+                st_order[st_ordered++] = this->getId();
+            }
+            return( false );
+        }
+        void vSend() {}
+};
+
+static testSensor     st_sensor_a( 21 );
+static testSensor     st_sensor_b( 22 );
+static testSensor     st_sensor_c( 23 );
+static testSensor     st_sensor_d( 24 );
+static pwiSensorGroup st_group;
+static pwiSensorGroup st_immediate;
+
+/* the group does one conversion per period, then reads each member once
+ * the conversion time has elapsed
+ */
+static void scenarioConversion( void )
+{
+    checkBegin( "conversion" );
+    st_sensor_a.setTimers( 100, 0 );
+    st_sensor_b.setTimers( 100, 0 );
+    st_sensor_c.setTimers( 100, 0 );
+    CHECK( !st_sensor_a.isGrouped());
+    st_group.setup( 1000, 100, convertCb );
+    st_group.add( st_sensor_a );
+    st_group.add( st_sensor_b );
+    st_group.add( st_sensor_c );
+    CHECK_EQ( st_group.getCount(), 3 );
+    CHECK( st_sensor_a.isGrouped());
+    CHECK( !st_sensor_a.getMinTimer().isStarted());
+    st_group.start();
+
+    // the min timers of the members do not run anymore
+    checkRun( 999000, 1000 );
+    CHECK_EQ( st_conversions, 0 );
+    CHECK_EQ( st_sensor_a.measures + st_sensor_b.measures + st_sensor_c.measures, 0 );
+
+    checkRun( 1000, 1000 );
+    CHECK_EQ( st_conversions, 1 );
+    CHECK_EQ( st_sensor_a.measures, 0 );
+
+    checkRun( 100000, 1000 );
+    CHECK_EQ( st_conversions, 1 );
+    CHECK_EQ( st_ordered, 3 );
+    CHECK_EQ( st_order[0], 21 );
+    CHECK_EQ( st_order[1], 22 );
+    CHECK_EQ( st_order[2], 23 );
+    CHECK_EQ( st_sensor_a.measure_ms - st_conversion_ms, 100 );
+    CHECK_EQ( st_sensor_c.measure_ms - st_conversion_ms, 100 );
+    CHECK_EQ( st_sensor_c.converted, 1 );
+}
+
+/* a later setMinPeriod() on a member only records the period
+ */
+static void scenarioMinPeriod( void )
+{
+    checkBegin( "min period" );
+    // restart the period on the reset clock
+    st_group.start();
+    CHECK_EQ( st_sensor_b.setMinPeriod( 50 ), PWI_SENSOR_OK );
+    CHECK( !st_sensor_b.getMinTimer().isStarted());
+
+    checkRun( 900000, 1000 );
+    CHECK_EQ( st_conversions, 1 );
+    CHECK_EQ( st_sensor_b.measures, 1 );
+    checkRun( 100000, 1000 );
+    CHECK_EQ( st_conversions, 2 );
+    checkRun( 100000, 1000 );
+    CHECK_EQ( st_sensor_a.measures, 2 );
+    CHECK_EQ( st_sensor_b.measures, 2 );
+    CHECK_EQ( st_sensor_c.measures, 2 );
+    CHECK_EQ( st_sensor_b.converted, 2 );
+    st_group.stop();
+
+    // nothing runs once the group is stopped
+    checkRun( 2000000, 1000 );
+    CHECK_EQ( st_conversions, 2 );
+    CHECK_EQ( st_sensor_b.measures, 2 );
+}
+
+/* without conversion time, the members are read right after the conversion
+ */
+static void scenarioImmediate( void )
+{
+    checkBegin( "immediate" );
+    st_conversions = 0;
+    st_immediate.setup( 500, 0, convertCb );
+    st_immediate.add( st_sensor_d );
+    st_immediate.start();
+    checkRun( 1000000, 1000 );
+    CHECK_EQ( st_conversions, 2 );
+    CHECK_EQ( st_sensor_d.measures, 2 );
+    CHECK_EQ( st_sensor_d.measure_ms, st_conversion_ms );
+    CHECK_EQ( st_sensor_d.converted, st_conversions );
+    st_immediate.stop();
+}
+
+int main( void )
+{
+    scenarioConversion();
+    scenarioMinPeriod();
+    scenarioImmediate();
+    return( checkEnd( "group" ));
+}
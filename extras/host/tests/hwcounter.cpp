@@ -0,0 +1,155 @@
+/*
+ * Deterministic tests of pwiHwCounter and of the hardware mode of
+ * pwiPulseSensor, with a simulated 16-bits counter register.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <pwiPulseSensor.h>
+
+#define INPUT_PIN           5
+
+/* a simulated counter: the register counts the edges of a scripted input
+ * frequency, and the overflow flag is raised on each wrap of the register;
+ * service() plays the overflow interrupt service routine
+ */
+class testCounter : public pwiHwCounter {
+    public:
+        testCounter() : hz( 0 ), started( false ), start_us( 0 ), base( 0 ), serviced( 0 ) {}
+
+        /* the input frequency from now on
+         */
+        void setFrequency( uint32_t hz ) {
+            this->base = this->edges();
+            this->start_us = hostClockMicros();
+            this->hz = hz;
+        }
+        uint64_t edges( void ) {
+            return( this->started ? this->base + ( hostClockMicros() - this->start_us ) * this->hz / 1000000 : 0 );
+        }
+        void service( void ) {
+            while( this->isOverflowPending()){
+                this->onOverflow();
+            }
+        }
+    protected:
+        void clearOverflow( void ) { this->serviced += 1; }
+        bool isOverflowPending( void ) { return(( this->edges() >> 16 ) > this->serviced ); }
+        uint16_t readRegister( void ) { return( this->edges() & 0xffff ); }
+        bool startCounter( uint8_t edge ) {
+            this->started = true;
+            this->start_us = hostClockMicros();
+            this->base = 0;
+            this->serviced = 0;
+            return( true );
+        }
+        void stopCounter( void ) {
+            this->base = this->edges();
+            this->started = false;
+        }
+    private:
+        uint32_t    hz;
+        bool        started;
+        uint64_t    start_us;
+        uint64_t    base;
+        uint64_t    serviced;
+};
+
+/* a pulse sensor which neither measures nor sends anything
+ */
+class testSensor : public pwiPulseSensor {
+    public:
+        testSensor( uint8_t id, uint8_t input_pin, uint8_t edge ) : pwiPulseSensor( id, input_pin, edge ) {}
+    protected:
+        bool vMeasure() { return( false ); }
+        void vSend() {}
+};
+
+static testCounter  st_counter;
+static pwiHwCounter st_none;
+static testSensor   st_sensor( 1, INPUT_PIN, FALLING );
+
+/* call loopInput() for @duration_us, each @step_us, the overflows being
+ * serviced before each call
+ */
+static void loop( uint64_t duration_us, uint32_t step_us )
+{
+    uint64_t end_us = hostClockMicros() + duration_us;
+    while( hostClockMicros() < end_us ){
+        hostClockAdvance( step_us );
+        st_counter.service();
+        st_sensor.loopInput();
+    }
+}
+
+/* the 16-bits register is extended to 32 bits, even when an overflow has not
+ * been serviced yet
+ */
+static void scenarioOverflow( void )
+{
+    checkBegin( "overflow" );
+    CHECK( st_counter.begin( FALLING ));
+    st_counter.setFrequency( 50000 );
+    hostClockAdvance( 3000000 );
+    st_counter.service();
+    CHECK_EQ( st_counter.getCount(), 150000 );
+    // an overflow is pending while the interrupts are masked
+    hostClockAdvance( 1000000 );
+    CHECK_EQ( st_counter.edges(), 200000 );
+    CHECK_EQ( st_counter.getCount(), 200000 );
+    st_counter.service();
+    CHECK_EQ( st_counter.getCount(), 200000 );
+    // begin() resets the count
+    CHECK( st_counter.begin( FALLING ));
+    CHECK_EQ( st_counter.getCount(), 0 );
+    st_counter.end();
+}
+
+/* the pulse sensor keeps its count and its API with a hardware counter
+ */
+static void scenarioSensor( void )
+{
+    checkBegin( "sensor" );
+    st_sensor.setInputPin( INPUT_PIN );
+    uint32_t base = st_sensor.getPulsesCount();
+    CHECK( st_sensor.setHardwareCounter( &st_counter ));
+    CHECK_EQ( st_sensor.getMode(), PWI_PULSE_HARDWARE );
+    // 20 kHz during 10 s, i.e. several overflows
+    st_counter.setFrequency( 20000 );
+    loop( 10000000, 1000 );
+    CHECK_EQ( st_sensor.getPulsesCount() - base, 200000 );
+    // in mHz, over the default one second window
+    CHECK_EQ( st_sensor.getRate(), 20000000 );
+
+    // the count is kept when going back to polling
+    CHECK( st_sensor.setHardwareCounter( NULL ));
+    CHECK_EQ( st_sensor.getMode(), PWI_PULSE_POLLING );
+    CHECK_EQ( st_sensor.getPulsesCount() - base, 200000 );
+    // the interrupt mode cannot be set while a hardware counter is used
+    CHECK( st_sensor.setHardwareCounter( &st_counter ));
+    CHECK( !st_sensor.setInterruptMode( true ));
+    st_counter.setFrequency( 1000 );
+    loop( 1000000, 1000 );
+    CHECK_EQ( st_sensor.getPulsesCount() - base, 201000 );
+    st_sensor.setHardwareCounter( NULL );
+}
+
+/* without hardware, the counter cannot be started, and the sensor stays in
+ * polling mode
+ */
+static void scenarioNoHardware( void )
+{
+    checkBegin( "no hardware" );
+    CHECK( !st_none.begin( FALLING ));
+    CHECK( !st_sensor.setHardwareCounter( &st_none ));
+    CHECK_EQ( st_sensor.getMode(), PWI_PULSE_POLLING );
+}
+
+int main( void )
+{
+    scenarioOverflow();
+    scenarioSensor();
+    scenarioNoHardware();
+    return( checkEnd( "hwcounter" ));
+}
@@ -0,0 +1,108 @@
+/*
+ * Tests of the accounting of pwiMemory::Stats() on the host: the registries
+ * of the library, and the fragmentation of the heap (the stack high-water
+ * mark is AVR only).
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <pwiMemory.h>
+#include <pwiSensor.h>
+
+class testSensor : public pwiSensor {
+    public:
+        testSensor( uint8_t id ) : pwiSensor( id ) {}
+    protected:
+        bool vMeasure() { return( false ); }
+        void vSend() {}
+};
+
+static testSensor st_sensor_a( 1 );
+static testSensor st_sensor_b( 2 );
+static pwiTimer   st_timer;
+static pwiTimer   st_other;
+
+static const char st_label[] = "Own";
+
+/* the instances and their list nodes are counted, the first element of each
+ * list being in its static head
+ */
+static void scenarioRegistries( void )
+{
+    pwiMemoryStats stats;
+
+    checkBegin( "registries" );
+    pwiMemory::Stats( stats );
+    CHECK_EQ( stats.sensors, 2 );
+    CHECK_EQ( stats.timers, 2*2+2 );
+    CHECK_EQ( stats.list_nodes, ( stats.sensors-1 ) + ( stats.timers-1 ));
+    CHECK( stats.list_bytes >= stats.list_nodes * sizeof( pwiList ));
+    CHECK_EQ( stats.timer_bytes, stats.timers * sizeof( pwiTimer ));
+    // the sensors hold no label, their timers being accounted as timers
+    CHECK_EQ( stats.sensor_bytes, stats.sensors * ( sizeof( pwiSensor ) - 2*sizeof( pwiTimer )));
+    CHECK_EQ( stats.label_bytes, 0 );
+    CHECK_EQ( stats.library_bytes, stats.list_bytes + stats.timer_bytes + stats.sensor_bytes + stats.label_bytes );
+}
+
+/* each distinct label is counted once, whatever the count of timers which
+ * share it
+ */
+static void scenarioLabels( void )
+{
+    pwiMemoryStats stats;
+
+    checkBegin( "labels" );
+    st_sensor_a.setTimers( 100, 1000 );
+    pwiMemory::Stats( stats );
+    CHECK_EQ( stats.label_bytes, sizeof( "MinTimer" ) + sizeof( "MaxTimer" ));
+
+    // the labels of the sensors are shared, and do not depend on the id
+    st_sensor_b.setTimers( 100, 1000 );
+    st_sensor_b.setId( 200 );
+    pwiMemory::Stats( stats );
+    CHECK_EQ( stats.label_bytes, sizeof( "MinTimer" ) + sizeof( "MaxTimer" ));
+
+    st_timer.setup( st_label, 100 );
+    st_other.setup( st_label, 200 );
+    pwiMemory::Stats( stats );
+    CHECK_EQ( stats.label_bytes, sizeof( "MinTimer" ) + sizeof( "MaxTimer" ) + sizeof( st_label ));
+    CHECK_EQ( stats.library_bytes, stats.list_bytes + stats.timer_bytes + stats.sensor_bytes + stats.label_bytes );
+
+    st_sensor_a.setTimers( 0, 0 );
+    st_sensor_b.setTimers( 0, 0 );
+}
+
+/* the fragmentation is the share of the free heap outside of its largest
+ * block
+ */
+static void scenarioHeap( void )
+{
+    pwiMemoryStats stats;
+
+    checkBegin( "heap" );
+    memset( &stats, '\0', sizeof( stats ));
+    CHECK_EQ( pwiMemory::GetFragmentation( stats ), 0 );
+    stats.heap_free_bytes = 1000;
+    stats.heap_largest_free = 1000;
+    CHECK_EQ( pwiMemory::GetFragmentation( stats ), 0 );
+    stats.heap_largest_free = 250;
+    CHECK_EQ( pwiMemory::GetFragmentation( stats ), 75 );
+    stats.heap_free_bytes = 100000;
+    stats.heap_largest_free = 1;
+    CHECK_EQ( pwiMemory::GetFragmentation( stats ), 100 );
+
+    // the list nodes come from the heap
+    pwiMemory::Stats( stats );
+    CHECK( stats.heap_bytes >= stats.list_bytes );
+    CHECK( stats.heap_free_bytes <= stats.heap_bytes );
+    CHECK( pwiMemory::GetFragmentation( stats ) <= 100 );
+}
+
+int main( void )
+{
+    scenarioRegistries();
+    scenarioLabels();
+    scenarioHeap();
+    return( checkEnd( "memory" ));
+}
@@ -0,0 +1,238 @@
+/*
+ * Tests of the varint and zig-zag primitives of pwiPack, of the frame
+ * builder and of the edge cases of the decoder; the lossy link itself is
+ * simulated by 'packdecode -s' (see the check target of the Makefile).
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <pwiPack.h>
+
+/* the fields of the last decoded frame
+ */
+#define MAX_FIELDS      16
+
+typedef struct {
+    uint8_t  count;
+    uint8_t  channel[MAX_FIELDS];
+    uint8_t  type[MAX_FIELDS];
+    uint32_t value[MAX_FIELDS];
+}
+    sFields;
+
+static sFields st_fields;
+
+static void fieldCb( uint8_t channel, uint8_t type, uint32_t value, sFields *fields )
+{
+    if( fields->count < MAX_FIELDS ){
+        fields->channel[fields->count] = channel;
+        fields->type[fields->count] = type;
+        fields->value[fields->count] = value;
+        fields->count += 1;
+    }
+}
+
+static uint8_t decode( pwiPackDecoder &decoder, const uint8_t *frame, uint8_t length )
+{
+    memset( &st_fields, '\0', sizeof( st_fields ));
+    return( decoder.decode( frame, length, ( pwiPackDecoderCb ) fieldCb, &st_fields ));
+}
+
+static pwiPackChannel st_chan_a( 1 );
+static pwiPackChannel st_chan_b( 2 );
+static pwiPackDecoder st_decoder;
+
+/* the varint sizes change at each 7 bits boundary, and the value round
+ * trips up to the full 32 bits
+ */
+static void scenarioVarint( void )
+{
+    static const uint32_t values[] = { 0, 1, 127, 128, 16383, 16384, 2097151, 2097152, 268435455, 268435456, 0xffffffff };
+    static const uint8_t sizes[] = { 1, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5 };
+    uint8_t buffer[8];
+    uint32_t value;
+
+    checkBegin( "varint" );
+    for( uint8_t i=0 ; i<sizeof( sizes ) ; ++i ){
+        CHECK_EQ( pwiVarintSize( values[i] ), sizes[i] );
+        CHECK_EQ( pwiVarintPut( buffer, sizeof( buffer ), values[i] ), sizes[i] );
+        CHECK_EQ( pwiVarintGet( buffer, sizeof( buffer ), value ), sizes[i] );
+        CHECK_EQ( value, values[i] );
+    }
+    CHECK_EQ( pwiVarintPut( buffer, sizeof( buffer ), 300 ), 2 );
+    CHECK_EQ( buffer[0], 0xac );
+    CHECK_EQ( buffer[1], 0x02 );
+
+    // too small a buffer is left untouched
+    buffer[0] = 0x55;
+    CHECK_EQ( pwiVarintPut( buffer, 1, 128 ), 0 );
+    CHECK_EQ( buffer[0], 0x55 );
+    CHECK_EQ( pwiVarintPut( buffer, 0, 0 ), 0 );
+
+    // a truncated varint, or one longer than five bytes, is rejected
+    CHECK_EQ( pwiVarintPut( buffer, sizeof( buffer ), 0xffffffff ), 5 );
+    CHECK_EQ( pwiVarintGet( buffer, 4, value ), 0 );
+    CHECK_EQ( pwiVarintGet( buffer, 0, value ), 0 );
+    memset( buffer, 0x80, sizeof( buffer ));
+    CHECK_EQ( pwiVarintGet( buffer, sizeof( buffer ), value ), 0 );
+}
+
+/* zig-zag interleaves the signed values, up to the limits of the type
+ */
+static void scenarioZigzag( void )
+{
+    static const int32_t values[] = { 0, -1, 1, -2, 2, 63, -64, 64, INT32_MAX, INT32_MIN };
+    static const uint32_t encoded[] = { 0, 1, 2, 3, 4, 126, 127, 128, 0xfffffffe, 0xffffffff };
+
+    checkBegin( "zig-zag" );
+    for( uint8_t i=0 ; i<sizeof( encoded )/sizeof( encoded[0] ) ; ++i ){
+        CHECK_EQ( pwiZigzag( values[i] ), encoded[i] );
+        CHECK( pwiUnzigzag( encoded[i] ) == values[i] );
+    }
+    // a small negative value stays a one byte varint
+    CHECK_EQ( pwiVarintSize( pwiZigzag( -64 )), 1 );
+}
+
+/* the fields of a frame are decoded in order, with their types
+ */
+static void scenarioFrame( void )
+{
+    checkBegin( "frame" );
+    st_decoder.reset();
+    pwiPack pack;
+    CHECK( pack.addUnsigned( 5, 300 ));
+    CHECK( pack.addSigned( 6, -3 ));
+    CHECK( pack.addDelta( st_chan_a, 1000000 ));
+    CHECK_EQ( pack.getLength(), 1+3+2+4 );
+    CHECK_EQ( pwiPack::GetSeq( pack.getBuffer()), pack.getSeq());
+
+    CHECK_EQ( decode( st_decoder, pack.getBuffer(), pack.getLength()), PWI_PACK_OK );
+    CHECK_EQ( st_fields.count, 3 );
+    CHECK_EQ( st_fields.channel[0], 5 );
+    CHECK_EQ( st_fields.type[0], PWI_PACK_UNSIGNED );
+    CHECK_EQ( st_fields.value[0], 300 );
+    CHECK_EQ( st_fields.type[1], PWI_PACK_SIGNED );
+    CHECK_EQ(( int32_t ) st_fields.value[1], -3 );
+    CHECK_EQ( st_fields.type[2], PWI_PACK_ABSOLUTE );
+    CHECK_EQ( st_fields.value[2], 1000000 );
+
+    // a frame without any field is valid
+    pwiPack empty;
+    CHECK_EQ( empty.getSeq(), ( uint8_t )( pack.getSeq()+1 ));
+    CHECK_EQ( decode( st_decoder, empty.getBuffer(), empty.getLength()), PWI_PACK_OK );
+    CHECK_EQ( st_fields.count, 0 );
+
+    // the fields which do not fit are refused, the frame staying valid
+    pwiPack full;
+    uint8_t added = 0;
+    while( full.addUnsigned( added, 0xffffffff )){
+        added += 1;
+    }
+    CHECK_EQ( added, ( MAX_PAYLOAD-1 ) / 6 );
+    CHECK_EQ( full.getLength(), 1+6*added );
+    CHECK( !full.addUnsigned( 0, 1 ));
+    CHECK_EQ( full.getLength(), 1+6*added );
+}
+
+/* once acknowledged, a counter is sent as a delta, which may be negative,
+ * until its base gets older than the history
+ */
+static void scenarioDelta( void )
+{
+    checkBegin( "delta" );
+    st_decoder.reset();
+    pwiPack first;
+    first.addDelta( st_chan_b, 5000 );
+    CHECK_EQ( decode( st_decoder, first.getBuffer(), first.getLength()), PWI_PACK_OK );
+    CHECK( !st_chan_b.isAcked());
+
+    // the acknowledge of a frame without the channel is ignored
+    pwiPack other;
+    other.addUnsigned( 0, 1 );
+    pwiPackChannel::Ack( other.getSeq());
+    CHECK( !st_chan_b.isAcked());
+    pwiPackChannel::Ack( first.getSeq());
+    CHECK( st_chan_b.isAcked());
+
+    pwiPack second;
+    second.addDelta( st_chan_b, 4990 );
+    CHECK_EQ( second.getBuffer()[1] >> 6, PWI_PACK_DELTA );
+    CHECK_EQ( second.getBuffer()[2], first.getSeq());
+    CHECK_EQ( second.getLength(), 1+2+1 );
+    CHECK_EQ( decode( st_decoder, second.getBuffer(), second.getLength()), PWI_PACK_OK );
+    CHECK_EQ( st_fields.type[0], PWI_PACK_DELTA );
+    CHECK_EQ( st_fields.value[0], 4990 );
+
+    // a late acknowledge does not move the base backwards
+    pwiPackChannel::Ack( second.getSeq());
+    pwiPackChannel::Ack( first.getSeq());
+    pwiPack third;
+    third.addDelta( st_chan_b, 5000 );
+    CHECK_EQ( third.getBuffer()[2], second.getSeq());
+
+    // without any acknowledge, the base gets too old and is forgotten, even
+    // when the sequence number wraps
+    for( uint16_t i=0 ; i<256 ; ++i ){
+        pwiPack pack;
+        pack.addDelta( st_chan_b, 6000+i );
+    }
+    CHECK( !st_chan_b.isAcked());
+    pwiPack wrapped;
+    wrapped.addDelta( st_chan_b, 7000 );
+    CHECK_EQ( wrapped.getBuffer()[1] >> 6, PWI_PACK_ABSOLUTE );
+}
+
+/* the malformed frames and the unknown bases are reported, the fields which
+ * can be decoded being still delivered
+ */
+static void scenarioDecoder( void )
+{
+    checkBegin( "decoder" );
+    st_decoder.reset();
+
+    CHECK_EQ( decode( st_decoder, NULL, 0 ), PWI_PACK_ERR01 );
+
+    // a delta field without its base sequence number
+    const uint8_t no_base[] = { 10, ( PWI_PACK_DELTA << 6 ) | 1 };
+    CHECK_EQ( decode( st_decoder, no_base, sizeof( no_base )), PWI_PACK_ERR01 );
+
+    // a truncated varint, after a valid field
+    const uint8_t truncated[] = { 11, ( PWI_PACK_UNSIGNED << 6 ) | 1, 0x05, ( PWI_PACK_UNSIGNED << 6 ) | 2, 0x80 };
+    CHECK_EQ( decode( st_decoder, truncated, sizeof( truncated )), PWI_PACK_ERR01 );
+    CHECK_EQ( st_fields.count, 1 );
+    CHECK_EQ( st_fields.value[0], 5 );
+
+    // an unknown base skips the field, not the next ones
+    const uint8_t unknown[] = { 12, ( PWI_PACK_DELTA << 6 ) | 3, 11, 0x02, ( PWI_PACK_UNSIGNED << 6 ) | 4, 0x07 };
+    CHECK_EQ( decode( st_decoder, unknown, sizeof( unknown )), PWI_PACK_ERR02 );
+    CHECK_EQ( st_fields.count, 1 );
+    CHECK_EQ( st_fields.channel[0], 4 );
+
+    // an absolute value sets the base, a repeated frame does not consume
+    // the history
+    const uint8_t absolute[] = { 13, ( PWI_PACK_ABSOLUTE << 6 ) | 3, 100 };
+    for( uint8_t i=0 ; i<PWI_PACK_HISTORY+1 ; ++i ){
+        CHECK_EQ( decode( st_decoder, absolute, sizeof( absolute )), PWI_PACK_OK );
+    }
+    const uint8_t delta[] = { 14, ( PWI_PACK_DELTA << 6 ) | 3, 13, 0x03 };
+    CHECK_EQ( decode( st_decoder, delta, sizeof( delta )), PWI_PACK_OK );
+    CHECK_EQ( st_fields.value[0], 98 );
+
+    // the bases are per channel, and forgotten on reset
+    const uint8_t other_channel[] = { 15, ( PWI_PACK_DELTA << 6 ) | 5, 13, 0x03 };
+    CHECK_EQ( decode( st_decoder, other_channel, sizeof( other_channel )), PWI_PACK_ERR02 );
+    st_decoder.reset();
+    CHECK_EQ( decode( st_decoder, delta, sizeof( delta )), PWI_PACK_ERR02 );
+    CHECK_EQ( st_fields.count, 0 );
+}
+
+int main( void )
+{
+    scenarioVarint();
+    scenarioZigzag();
+    scenarioFrame();
+    scenarioDelta();
+    scenarioDecoder();
+    return( checkEnd( "pack" ));
+}
@@ -0,0 +1,147 @@
+/*
+ * Deterministic tests of the vertical counter debounce of
+ * pwiPortPulseCounter on the simulated pins.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <pwiPortPulseCounter.h>
+
+#define FALLING_PIN         8
+#define RISING_PIN          9
+
+static pwiPortPulseCounter st_counter;
+static pwiPortPulseCounter st_full;
+static pwiPortPulseCounter st_sampled;
+
+/* set the level of @pin, then sample the port @count times
+ *
+ * Returns: the count of pulses detected by the last sample.
+ */
+static uint8_t sample( pwiPortPulseCounter &counter, uint8_t pin, uint8_t level, uint8_t count )
+{
+    uint8_t detected = 0;
+    hostPinSet( pin, level );
+    for( uint8_t i=0 ; i<count ; ++i ){
+        detected = counter.loopInput();
+    }
+    return( detected );
+}
+
+/* the channels must all be on the same port, eight at most
+ */
+static void scenarioChannels( void )
+{
+    checkBegin( "channels" );
+    CHECK_EQ( st_full.loopInput(), 0 );
+    CHECK_EQ( st_full.addChannel( HOST_PINS_COUNT, FALLING ), PWI_PORT_ERR02 );
+    for( uint8_t i=0 ; i<PWI_PORT_CHANNELS ; ++i ){
+        CHECK_EQ( st_full.addChannel( 16+i, FALLING ), i );
+    }
+    CHECK_EQ( st_full.addChannel( 16, FALLING ), PWI_PORT_ERR03 );
+    CHECK_EQ( st_full.getChannelsCount(), PWI_PORT_CHANNELS );
+    CHECK_EQ( st_full.getPulsesCount( PWI_PORT_CHANNELS ), 0 );
+
+    CHECK_EQ( st_counter.addChannel( FALLING_PIN, FALLING ), 0 );
+    CHECK_EQ( st_counter.addChannel( 0, FALLING ), PWI_PORT_ERR01 );
+    CHECK_EQ( st_counter.addChannel( RISING_PIN, RISING ), 1 );
+    CHECK_EQ( st_counter.getChannelsCount(), 2 );
+}
+
+/* a level is only taken into account after four identical samples, and only
+ * the configured edge is counted
+ */
+static void scenarioDebounce( void )
+{
+    checkBegin( "debounce" );
+    // the pins start high, which is the debounced state of both channels
+    CHECK_EQ( sample( st_counter, FALLING_PIN, HIGH, 4 ), 0 );
+
+    CHECK_EQ( sample( st_counter, FALLING_PIN, LOW, 3 ), 0 );
+    CHECK_EQ( st_counter.getPulsesCount( 0 ), 0 );
+    CHECK_EQ( st_counter.loopInput(), 1 );
+    CHECK_EQ( st_counter.getPulsesCount( 0 ), 1 );
+    // staying low does not count again, nor does the rising edge
+    CHECK_EQ( sample( st_counter, FALLING_PIN, LOW, 10 ), 0 );
+    CHECK_EQ( sample( st_counter, FALLING_PIN, HIGH, 4 ), 0 );
+    CHECK_EQ( st_counter.getPulsesCount( 0 ), 1 );
+
+    // the rising channel only counts the rising edges
+    CHECK_EQ( sample( st_counter, RISING_PIN, LOW, 4 ), 0 );
+    CHECK_EQ( sample( st_counter, RISING_PIN, HIGH, 3 ), 0 );
+    CHECK_EQ( st_counter.loopInput(), 1 );
+    CHECK_EQ( st_counter.getPulsesCount( 1 ), 1 );
+    CHECK_EQ( st_counter.getPulsesCount( 0 ), 1 );
+}
+
+/* a glitch shorter than four samples restarts the count of its bit
+ */
+static void scenarioGlitch( void )
+{
+    checkBegin( "glitch" );
+    uint32_t before = st_counter.getPulsesCount( 0 );
+    for( uint8_t i=0 ; i<5 ; ++i ){
+        CHECK_EQ( sample( st_counter, FALLING_PIN, LOW, 3 ), 0 );
+        CHECK_EQ( sample( st_counter, FALLING_PIN, HIGH, 1 ), 0 );
+    }
+    CHECK_EQ( st_counter.getPulsesCount( 0 ), before );
+
+    // a bounce of the other channel does not delay this one
+    hostPinSet( FALLING_PIN, LOW );
+    CHECK_EQ( sample( st_counter, RISING_PIN, LOW, 2 ), 0 );
+    CHECK_EQ( sample( st_counter, RISING_PIN, HIGH, 1 ), 0 );
+    CHECK_EQ( st_counter.loopInput(), 1 );
+    CHECK_EQ( st_counter.getPulsesCount( 0 ), before+1 );
+    CHECK_EQ( sample( st_counter, FALLING_PIN, HIGH, 4 ), 0 );
+}
+
+/* the channels are debounced in parallel, and counted in the same pass
+ */
+static void scenarioParallel( void )
+{
+    checkBegin( "parallel" );
+    uint32_t falling = st_counter.getPulsesCount( 0 );
+    uint32_t rising = st_counter.getPulsesCount( 1 );
+    CHECK_EQ( sample( st_counter, RISING_PIN, LOW, 4 ), 0 );
+
+    hostPinSet( FALLING_PIN, LOW );
+    hostPinSet( RISING_PIN, HIGH );
+    CHECK_EQ( sample( st_counter, RISING_PIN, HIGH, 3 ), 0 );
+    CHECK_EQ( st_counter.loopInput(), 2 );
+    CHECK_EQ( st_counter.getPulsesCount( 0 ), falling+1 );
+    CHECK_EQ( st_counter.getPulsesCount( 1 ), rising+1 );
+}
+
+/* with a sample period, the debounce time is four periods whatever the
+ * count of loopInput() calls
+ */
+static void scenarioSamplePeriod( void )
+{
+    checkBegin( "sample period" );
+    st_sampled.addChannel( FALLING_PIN, FALLING );
+    st_sampled.setSamplePeriod( 1000 );
+    hostPinSet( FALLING_PIN, LOW );
+    uint32_t detected = 0;
+    uint64_t detected_us = 0;
+    for( uint32_t i=0 ; i<100 ; ++i ){
+        hostClockAdvance( 100 );
+        if( st_sampled.loopInput() && !detected++ ){
+            detected_us = hostClockMicros();
+        }
+    }
+    CHECK_EQ( detected, 1 );
+    CHECK_EQ( st_sampled.getPulsesCount( 0 ), 1 );
+    // the first sample at 1 ms, then at 2, 3 and 4 ms
+    CHECK_EQ( detected_us, 4000 );
+}
+
+int main( void )
+{
+    scenarioChannels();
+    scenarioDebounce();
+    scenarioGlitch();
+    scenarioParallel();
+    scenarioSamplePeriod();
+    return( checkEnd( "port" ));
+}
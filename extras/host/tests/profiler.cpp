@@ -0,0 +1,145 @@
+/*
+ * Deterministic tests of pwiProfiler on the simulated clock.
+ * The checks are only run when built with PWI_PROFILER, which is the case of
+ * the second pass of 'make check'.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <pwiProfiler.h>
+#include <pwiSensor.h>
+
+#ifdef PWI_PROFILER
+
+/* a timer callback which blocks the main loop during @user_data us
+ */
+static void stallCb( void *user_data )
+{
+    hostClockAdvance(( uint32_t )( uintptr_t ) user_data );
+}
+
+/* a sensor whose measure blocks the main loop during @stall_us us
+ */
+class testSensor : public pwiSensor {
+    public:
+        testSensor( uint8_t id, uint32_t stall_us ) : pwiSensor( id ), stall_us( stall_us ) {}
+    protected:
+        bool vMeasure() { hostClockAdvance( this->stall_us ); return( false ); }
+        void vSend() {}
+    private:
+        uint32_t    stall_us;
+};
+
+static pwiTimer st_short;
+static pwiTimer st_long;
+static pwiTimer st_other;
+
+static testSensor st_sensor_a( 7, 1000 );
+static testSensor st_sensor_b( 12, 3000 );
+
+/* two timers which share a same label are recorded as two distinct stalls,
+ * each one with its own user data
+ */
+static void scenarioShared( void )
+{
+    checkBegin( "shared label" );
+    pwiProfiler::Reset();
+    st_short.setup( "Shared", 100, false, stallCb, ( void * ) 2000 );
+    st_long.setup( "Shared", 100, false, stallCb, ( void * ) 5000 );
+    st_other.setup( "Other", 100, false, stallCb, ( void * ) 3000 );
+    st_short.start();
+    st_long.start();
+    st_other.start();
+    checkRun( 1000000, 1000 );
+
+    const char *label;
+    void *user_data;
+    CHECK_EQ( pwiProfiler::GetStall( 0, &label, &user_data ), 5000 );
+    CHECK( !strcmp( label, "Shared" ));
+    CHECK_EQ(( uintptr_t ) user_data, 5000 );
+    CHECK_EQ( pwiProfiler::GetStall( 1, &label, &user_data ), 3000 );
+    CHECK( !strcmp( label, "Other" ));
+    CHECK_EQ( pwiProfiler::GetStall( 2, &label, &user_data ), 2000 );
+    CHECK( !strcmp( label, "Shared" ));
+    CHECK_EQ(( uintptr_t ) user_data, 2000 );
+    // each timer is recorded once
+    CHECK_EQ( pwiProfiler::GetStall( 3 ), 0 );
+
+    st_short.stop();
+    st_long.stop();
+    st_other.stop();
+}
+
+/* the stall of a timer is updated in place when it gets longer
+ */
+static void scenarioUpdate( void )
+{
+    checkBegin( "update" );
+    pwiProfiler::Reset();
+    st_short.setup( "Shared", 100, false, stallCb, ( void * ) 2000 );
+    st_long.setup( "Shared", 100, false, stallCb, ( void * ) 1000 );
+    st_short.start();
+    st_long.start();
+    checkRun( 500000, 1000 );
+    CHECK_EQ( pwiProfiler::GetStall( 0 ), 2000 );
+    CHECK_EQ( pwiProfiler::GetStall( 1 ), 1000 );
+
+    st_long.setup( "Shared", 100, false, stallCb, ( void * ) 4000 );
+    st_long.start();
+    checkRun( 500000, 1000 );
+    void *user_data;
+    CHECK_EQ( pwiProfiler::GetStall( 0, NULL, &user_data ), 4000 );
+    CHECK_EQ(( uintptr_t ) user_data, 4000 );
+    CHECK_EQ( pwiProfiler::GetStall( 1 ), 2000 );
+    CHECK_EQ( pwiProfiler::GetStall( 2 ), 0 );
+
+    st_short.stop();
+    st_long.stop();
+}
+
+/* the min timers of the sensors share a same label, and are told apart by
+ * their user data; the reported label is built with the current sensor id
+ */
+static void scenarioSensors( void )
+{
+    checkBegin( "sensors" );
+    pwiProfiler::Reset();
+    st_sensor_a.setTimers( 100, 0 );
+    st_sensor_b.setTimers( 100, 0 );
+    checkRun( 500000, 1000 );
+
+    const char *label;
+    void *user_data;
+    char buffer[PWI_SENSOR_LABEL_SIZE];
+    CHECK_EQ( pwiProfiler::GetStall( 0, &label, &user_data ), 3000 );
+    CHECK( !strcmp( label, "MinTimer" ));
+    CHECK( user_data == &st_sensor_b );
+    CHECK( !strcmp( pwiSensor::GetTimerLabel( label, user_data, buffer, sizeof( buffer )), "MinTimer #12" ));
+    CHECK_EQ( pwiProfiler::GetStall( 1, &label, &user_data ), 1000 );
+    CHECK( user_data == &st_sensor_a );
+    CHECK( !strcmp( pwiSensor::GetTimerLabel( label, user_data, buffer, sizeof( buffer )), "MinTimer #7" ));
+
+    st_sensor_a.setId( 255 );
+    CHECK( !strcmp( pwiSensor::GetTimerLabel( label, user_data, buffer, sizeof( buffer )), "MinTimer #255" ));
+
+    // the other timers keep their own label
+    CHECK( pwiSensor::GetTimerLabel( "Other", &st_sensor_a, buffer, sizeof( buffer )) != buffer );
+
+    st_sensor_a.setTimers( 0, 0 );
+    st_sensor_b.setTimers( 0, 0 );
+}
+
+#endif // PWI_PROFILER
+
+int main( void )
+{
+#ifdef PWI_PROFILER
+    scenarioShared();
+    scenarioUpdate();
+    scenarioSensors();
+    return( checkEnd( "profiler" ));
+#else
+    return( checkSkip( "profiler", "PWI_PROFILER" ));
+#endif
+}
@@ -0,0 +1,176 @@
+/*
+ * Deterministic tests of pwiPulseSensor on the simulated clock and pins.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <pwiPulseSensor.h>
+
+#define INPUT_PIN           1
+#define EDGES_MAX           256
+
+/* a pulse sensor which neither measures nor sends anything
+ */
+class testSensor : public pwiPulseSensor {
+    public:
+        testSensor( uint8_t id, uint8_t input_pin, uint8_t edge ) : pwiPulseSensor( id, input_pin, edge ) {}
+    protected:
+        bool vMeasure() { return( false ); }
+        void vSend() {}
+};
+
+static testSensor st_sensor( 1, INPUT_PIN, FALLING );
+
+static hostEdge st_edges[EDGES_MAX];
+static size_t   st_count;
+
+static void addEdge( uint64_t t_us, uint8_t level )
+{
+    if( st_count < EDGES_MAX ){
+        st_edges[st_count].t_us = t_us;
+        st_edges[st_count].level = level;
+        st_count += 1;
+    }
+}
+
+/* script @count active-low pulses of @width_us each @period_us, starting at
+ * @start_us, each transition being preceded by @bounces 100 us glitches
+ */
+static void script( uint64_t start_us, uint32_t count, uint32_t period_us, uint32_t width_us, uint32_t bounces )
+{
+    st_count = 0;
+    for( uint32_t i=0 ; i<count ; ++i ){
+        uint64_t t = start_us + ( uint64_t ) i * period_us;
+        for( uint8_t level=LOW ; level<=HIGH ; ++level ){
+            for( uint32_t b=0 ; b<bounces ; ++b ){
+                addEdge( t, level );
+                addEdge( t+100, !level );
+                t += 200;
+            }
+            addEdge( t, level );
+            t += width_us;
+        }
+    }
+    hostPinSet( INPUT_PIN, HIGH );
+    hostPinScript( INPUT_PIN, st_edges, st_count );
+}
+
+/* call loopInput() for @duration_us, each @step_us
+ */
+static void loop( uint64_t duration_us, uint32_t step_us )
+{
+    uint64_t end_us = hostClockMicros() + duration_us;
+    while( hostClockMicros() < end_us ){
+        hostClockAdvance( step_us );
+        st_sensor.loopInput();
+    }
+}
+
+/* reset the sensor to a fresh polling mode with the given @lockout_ms
+ */
+static void reset( uint8_t lockout_ms )
+{
+    st_sensor.setInterruptMode( false );
+    st_sensor.setInputPin( INPUT_PIN );
+    st_sensor.setPulseLength( lockout_ms );
+}
+
+/* clean pulses are all counted in polling mode
+ */
+static void scenarioPolling( void )
+{
+    checkBegin( "polling" );
+    reset( 0 );
+    uint32_t base = st_sensor.getPulsesCount();
+    script( 10000, 10, 100000, 30000, 0 );
+    loop( 950000, 1000 );
+    CHECK_EQ( st_sensor.getPulsesCount() - base, 10 );
+    // 10 Hz, in mHz
+    CHECK_EQ( st_sensor.getRate(), 10000 );
+    // decays when no more pulse is detected
+    loop( 150000, 1000 );
+    CHECK( st_sensor.getRate() < 10000 );
+    CHECK_EQ( st_sensor.getPulsesCount() - base, 10 );
+}
+
+/* contact bounces are absorbed by a lockout which covers the pulse, and
+ * double counted without it
+ */
+static void scenarioBounce( void )
+{
+    checkBegin( "bounce" );
+    reset( 35 );
+    uint32_t base = st_sensor.getPulsesCount();
+    script( 10000, 10, 100000, 30000, 3 );
+    loop( 1100000, 50 );
+    CHECK_EQ( st_sensor.getPulsesCount() - base, 10 );
+
+    checkBegin( "no lockout" );
+    reset( 0 );
+    base = st_sensor.getPulsesCount();
+    script( 10000, 10, 100000, 30000, 3 );
+    loop( 1100000, 50 );
+    CHECK( st_sensor.getPulsesCount() - base > 10 );
+}
+
+/* the lockout only starts on the counted edge: pulses longer than the
+ * lockout are all counted, as long as their period is longer
+ */
+static void scenarioLongPulses( void )
+{
+    checkBegin( "long pulses" );
+    reset( 60 );
+    uint32_t base = st_sensor.getPulsesCount();
+    script( 10000, 10, 100000, 70000, 0 );
+    loop( 1100000, 1000 );
+    CHECK_EQ( st_sensor.getPulsesCount() - base, 10 );
+}
+
+/* a slow main loop misses short pulses in polling mode, while the interrupt
+ * mode counts them all
+ */
+static void scenarioInterrupt( void )
+{
+    checkBegin( "slow polling" );
+    reset( 0 );
+    uint32_t base = st_sensor.getPulsesCount();
+    script( 10000, 10, 100000, 5000, 0 );
+    loop( 1100000, 20000 );
+    CHECK( st_sensor.getPulsesCount() - base < 10 );
+
+    checkBegin( "interrupt" );
+    reset( 0 );
+    CHECK( st_sensor.setInterruptMode( true ));
+    CHECK_EQ( st_sensor.getMode(), PWI_PULSE_INTERRUPT );
+    base = st_sensor.getPulsesCount();
+    script( 10000, 10, 100000, 5000, 0 );
+    loop( 1100000, 20000 );
+    CHECK_EQ( st_sensor.getPulsesCount() - base, 10 );
+    st_sensor.setInterruptMode( false );
+}
+
+/* the micros() rollover is harmless to the debounce engine
+ */
+static void scenarioRollover( void )
+{
+    checkBegin( "rollover" );
+    // micros() is 250 ms before its rollover
+    uint64_t start = ( 1ULL << 32 ) - 250000;
+    hostClockSet( start );
+    reset( 20 );
+    uint32_t base = st_sensor.getPulsesCount();
+    script( start + 10000, 5, 100000, 30000, 2 );
+    loop( 600000, 1000 );
+    CHECK_EQ( st_sensor.getPulsesCount() - base, 5 );
+}
+
+int main( void )
+{
+    scenarioPolling();
+    scenarioBounce();
+    scenarioLongPulses();
+    scenarioInterrupt();
+    scenarioRollover();
+    return( checkEnd( "pulse" ));
+}
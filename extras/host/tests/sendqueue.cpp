@@ -0,0 +1,178 @@
+/*
+ * Deterministic tests of pwiSendQueue with a simulated failing transport.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <core/MySensorsCore.h>
+#include <pwiSendQueue.h>
+
+#define QUEUE_SIZE          4
+
+/* a transport which fails while the link is down, and records the attempts
+ * and the delivered messages
+ */
+typedef struct {
+    bool        up;
+    uint32_t    attempts;
+    uint32_t    attempts_ms[16];
+    uint32_t    delivered;
+    uint8_t     last_length;
+    uint32_t    last_ts_ms;
+    MyMessage   last;
+}
+    testLink;
+
+static testLink st_link;
+
+static bool testTransport( MyMessage &msg, uint32_t ts_ms, void *user_data )
+{
+    testLink *link = ( testLink * ) user_data;
+    if( link->attempts < 16 ){
+        link->attempts_ms[link->attempts] = millis();
+    }
+    link->attempts += 1;
+    if( !link->up ){
+        return( false );
+    }
+    link->delivered += 1;
+    link->last = msg;
+    link->last_length = msg.getLength();
+    link->last_ts_ms = ts_ms;
+    return( true );
+}
+
+static pwiSendQueueItem st_items[QUEUE_SIZE];
+static pwiSendQueue     st_queue( st_items, QUEUE_SIZE );
+
+static pwiSendQueue     st_unbuffered( NULL, 0 );
+
+/* reset the link and empty the queue
+ */
+static void reset( bool up )
+{
+    st_link = testLink();
+    st_link.up = true;
+    st_queue.setTransport( testTransport, &st_link );
+    st_queue.setBackoff( 1000, 8000 );
+    st_queue.setBatch( QUEUE_SIZE );
+    while( st_queue.getCount() && st_queue.flush());
+    checkRun( 10000000, 10000 );
+    st_link = testLink();
+    st_link.up = up;
+}
+
+/* a float measure is queued while the link is down, and delivered unchanged
+ * with its original timestamp when the link is back
+ */
+static void scenarioFloat( void )
+{
+    checkBegin( "float" );
+    reset( false );
+    MyMessage msg( 3, V_TEMP );
+    CHECK_EQ( st_queue.send( msg.set( 21.5f, 1 )), PWI_SEND_QUEUE_QUEUED );
+    CHECK_EQ( st_queue.getCount(), 1 );
+    uint32_t ts_ms = millis();
+    checkRun( 1500000, 10000 );
+    st_link.up = true;
+    checkRun( 2000000, 10000 );
+    CHECK_EQ( st_queue.getCount(), 0 );
+    CHECK_EQ( st_link.delivered, 1 );
+    CHECK_EQ( st_link.last_length, 5 );
+    CHECK_EQ( st_link.last.getSensor(), 3 );
+    CHECK_EQ( st_link.last.getType(), V_TEMP );
+    CHECK_EQ( st_link.last.getPayloadType(), P_FLOAT32 );
+    CHECK( st_link.last.getFloat() == 21.5f );
+    CHECK_EQ( st_link.last_ts_ms, ts_ms );
+}
+
+/* the retry delay doubles on each failure, up to the max backoff
+ */
+static void scenarioBackoff( void )
+{
+    checkBegin( "backoff" );
+    reset( false );
+    MyMessage msg( 1, V_VAR1 );
+    st_queue.send( msg.set(( uint32_t ) 1 ));
+    checkRun( 40000000, 10000 );
+    // immediate attempt, then +1, +2, +4, +8, +8, +8, +8 seconds
+    CHECK_EQ( st_link.attempts, 8 );
+    CHECK_EQ( st_link.attempts_ms[1] - st_link.attempts_ms[0], 1000 );
+    CHECK_EQ( st_link.attempts_ms[2] - st_link.attempts_ms[1], 2000 );
+    CHECK_EQ( st_link.attempts_ms[3] - st_link.attempts_ms[2], 4000 );
+    CHECK_EQ( st_link.attempts_ms[4] - st_link.attempts_ms[3], 8000 );
+    CHECK_EQ( st_link.attempts_ms[5] - st_link.attempts_ms[4], 8000 );
+    // the backoff is reset after a success
+    st_link.up = true;
+    checkRun( 8000000, 10000 );
+    CHECK_EQ( st_queue.getCount(), 0 );
+    st_link.up = false;
+    st_link.attempts = 0;
+    st_queue.send( msg.set(( uint32_t ) 2 ));
+    checkRun( 1000000, 10000 );
+    CHECK_EQ( st_link.attempts, 2 );
+}
+
+/* when the queue is full, the oldest measures are dropped, and the others
+ * are flushed in order by batches
+ */
+static void scenarioOverflow( void )
+{
+    checkBegin( "overflow" );
+    reset( false );
+    st_queue.setBatch( 2 );
+    uint32_t dropped = st_queue.getDropped();
+    MyMessage msg( 1, V_VAR1 );
+    for( uint32_t i=1 ; i<=6 ; ++i ){
+        st_queue.send( msg.set( i ));
+    }
+    CHECK_EQ( st_queue.getCount(), QUEUE_SIZE );
+    CHECK_EQ( st_queue.getDropped() - dropped, 2 );
+    st_link.up = true;
+    st_link.attempts = 0;
+    // the first retry sends the two oldest remaining measures
+    checkRun( 1000000, 10000 );
+    CHECK_EQ( st_link.delivered, 2 );
+    CHECK_EQ( st_link.last.getULong(), 4 );
+    CHECK_EQ( st_queue.getCount(), 2 );
+    checkRun( 1000000, 10000 );
+    CHECK_EQ( st_link.delivered, 4 );
+    CHECK_EQ( st_link.last.getULong(), 6 );
+    CHECK_EQ( st_queue.getCount(), 0 );
+}
+
+/* the messages which cannot be queued still go through the transport
+ */
+static void scenarioUnqueued( void )
+{
+    checkBegin( "unqueued" );
+    reset( false );
+    MyMessage msg( 2, V_TEXT );
+    CHECK_EQ( st_queue.send( msg.set( "too long to be queued" )), PWI_SEND_QUEUE_ERR01 );
+    CHECK_EQ( st_link.attempts, 1 );
+    CHECK_EQ( st_queue.getCount(), 0 );
+    st_link.up = true;
+    CHECK_EQ( st_queue.send( msg ), PWI_SEND_QUEUE_SENT );
+    CHECK_EQ( st_link.delivered, 1 );
+    CHECK_EQ( st_link.last_length, 21 );
+
+    // a queue without storage only relays to its transport
+    st_unbuffered.setTransport( testTransport, &st_link );
+    msg.set(( uint8_t ) 1 );
+    CHECK_EQ( st_unbuffered.send( msg ), PWI_SEND_QUEUE_SENT );
+    CHECK_EQ( st_link.delivered, 2 );
+    st_link.up = false;
+    CHECK_EQ( st_unbuffered.send( msg ), PWI_SEND_QUEUE_ERR01 );
+    // the MySensors transport is not used
+    CHECK_EQ( hostTransportSentCount(), 0 );
+}
+
+int main( void )
+{
+    scenarioFloat();
+    scenarioBackoff();
+    scenarioOverflow();
+    scenarioUnqueued();
+    return( checkEnd( "sendqueue" ));
+}
@@ -0,0 +1,106 @@
+/*
+ * Deterministic tests of pwiSensor on the simulated clock.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <core/MySensorsCore.h>
+#include <pwiSensor.h>
+
+/* a sensor which sends a value changed by the test
+ */
+class testSensor : public pwiSensor {
+    public:
+        testSensor( uint8_t id ) : pwiSensor( id ), value( 0 ), sent_value( 0 ), measures( 0 ), sends( 0 ) {}
+        uint32_t    value;
+        uint32_t    sent_value;
+        uint32_t    measures;
+        uint32_t    sends;
+        bool        trigger() { return( this->measureAndSend()); }
+    protected:
+        bool vMeasure() {
+            this->measures += 1;
+            return( this->value != this->sent_value );
+        }
+        void vSend() {
+            MyMessage msg( this->getId(), V_VAR1 );
+            this->sent_value = this->value;
+            this->sends += 1;
+            this->sendMessage( msg.set( this->value ));
+        }
+};
+
+static testSensor st_sensor( 1 );
+
+/* the measure is taken each min period, only sent when it has changed, and
+ * unconditionally sent each max period
+ */
+static void scenarioPeriods( void )
+{
+    checkBegin( "periods" );
+    CHECK_EQ( st_sensor.setTimers( 100, 1000 ), PWI_SENSOR_OK );
+    checkRun( 450000, 1000 );
+    CHECK_EQ( st_sensor.measures, 4 );
+    CHECK_EQ( st_sensor.sends, 0 );
+    st_sensor.value = 42;
+    checkRun( 100000, 1000 );
+    CHECK_EQ( st_sensor.measures, 5 );
+    CHECK_EQ( st_sensor.sends, 1 );
+    CHECK_EQ( hostTransportSentCount(), 1 );
+    // the heartbeat
+    checkRun( 450000, 1000 );
+    CHECK_EQ( st_sensor.measures, 10 );
+    CHECK_EQ( st_sensor.sends, 2 );
+    CHECK_EQ( st_sensor.sent_value, 42 );
+}
+
+/* measureAndSend() sends immediately, and restarts the min period
+ */
+static void scenarioTrigger( void )
+{
+    checkBegin( "trigger" );
+    st_sensor.setTimers( 100, 0 );
+    st_sensor.measures = 0;
+    st_sensor.sends = 0;
+    checkRun( 50000, 1000 );
+    st_sensor.value += 1;
+    CHECK( st_sensor.trigger());
+    CHECK_EQ( st_sensor.sends, 1 );
+    CHECK( !st_sensor.trigger());
+    CHECK_EQ( st_sensor.measures, 2 );
+    CHECK_EQ( st_sensor.getMinTimer().getRemaining(), 100 );
+    checkRun( 99000, 1000 );
+    CHECK_EQ( st_sensor.measures, 2 );
+    checkRun( 1000, 1000 );
+    CHECK_EQ( st_sensor.measures, 3 );
+    // the max timer is disabled
+    CHECK( !st_sensor.getMaxTimer().isStarted());
+    checkRun( 5000000, 1000 );
+    CHECK_EQ( st_sensor.sends, 1 );
+}
+
+/* inconsistent periods are rejected, and leave the previous ones unchanged
+ */
+static void scenarioErrors( void )
+{
+    checkBegin( "errors" );
+    CHECK_EQ( st_sensor.setTimers( 100, 1000 ), PWI_SENSOR_OK );
+    CHECK_EQ( st_sensor.setMinPeriod( 2000 ), PWI_SENSOR_ERR02 );
+    CHECK_EQ( st_sensor.getMinTimer().getDelay(), 100 );
+    CHECK_EQ( st_sensor.setMaxPeriod( 50 ), PWI_SENSOR_ERR01 );
+    CHECK_EQ( st_sensor.getMaxTimer().getDelay(), 1000 );
+    CHECK_EQ( st_sensor.setMaxPeriod( 0 ), PWI_SENSOR_OK );
+    CHECK_EQ( st_sensor.setMinPeriod( 2000 ), PWI_SENSOR_OK );
+    st_sensor.setTimers( 0, 0 );
+    CHECK( !st_sensor.getMinTimer().isStarted());
+    CHECK( !st_sensor.getMaxTimer().isStarted());
+}
+
+int main( void )
+{
+    scenarioPeriods();
+    scenarioTrigger();
+    scenarioErrors();
+    return( checkEnd( "sensor" ));
+}
@@ -0,0 +1,153 @@
+/*
+ * Deterministic tests of the load shedding hysteresis of pwiSensor on the
+ * simulated clock.
+ *
+ * The load of the main loop is made by a timer whose callback blocks during
+ * a given time on each 10 ms period.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <pwiSensor.h>
+
+#define SHED_HIGH           80
+#define SHED_LOW            50
+#define SHED_PERIOD_MS      5000
+
+/* a sensor which neither measures nor sends anything
+ */
+class testSensor : public pwiSensor {
+    public:
+        testSensor( uint8_t id, uint8_t priority ) : pwiSensor( id ) { this->setPriority( priority ); }
+    protected:
+        bool vMeasure() { return( false ); }
+        void vSend() {}
+};
+
+static testSensor st_low( 1, PWI_SENSOR_PRIORITY_LOW );
+static testSensor st_normal( 2, PWI_SENSOR_PRIORITY_NORMAL );
+static testSensor st_critical( 3, PWI_SENSOR_PRIORITY_CRITICAL );
+
+static pwiTimer st_shed_timer;
+static pwiTimer st_burner;
+
+/* the callback of the load timer blocks during @user_data us
+ */
+static void burnCb( void *user_data )
+{
+    hostClockAdvance(( uint32_t )( uintptr_t ) user_data );
+}
+
+/* let the main loop be busy during @burn_us each 10 ms
+ */
+static void setLoad( uint32_t burn_us )
+{
+    if( burn_us ){
+        st_burner.setup( "Burner", 10, false, burnCb, ( void * )( uintptr_t ) burn_us );
+        st_burner.start();
+    } else {
+        st_burner.stop();
+    }
+}
+
+/* run the main loop until the next check of the load, which is detected by
+ * the restart of the shedding timer
+ */
+static void runCheck( void )
+{
+    unsigned long before;
+    do {
+        before = st_shed_timer.getRemaining();
+        checkRun( 1000, 1000 );
+    } while( st_shed_timer.getRemaining() < before );
+}
+
+/* the min periods of the lower priority sensors are doubled for each level
+ * of difference, the heartbeats bounding them
+ */
+static void checkPeriods( unsigned long low_ms, unsigned long normal_ms )
+{
+    CHECK_EQ( st_low.getMinTimer().getDelay(), low_ms );
+    CHECK_EQ( st_normal.getMinTimer().getDelay(), normal_ms );
+    CHECK_EQ( st_critical.getMinTimer().getDelay(), 100 );
+}
+
+/* the level is raised by one step per check above the high threshold, held
+ * between the two thresholds, and lowered by one step per check below the
+ * low threshold
+ */
+static void scenarioHysteresis( void )
+{
+    checkBegin( "hysteresis" );
+    st_low.setTimers( 100, 300 );
+    st_normal.setTimers( 100, 0 );
+    st_critical.setTimers( 100, 0 );
+    pwiSensor::SetupShedding( st_shed_timer, SHED_HIGH, SHED_LOW, SHED_PERIOD_MS );
+
+    // idle: nothing is shed
+    runCheck();
+    runCheck();
+    CHECK( pwiTimer::GetLoad() < SHED_LOW );
+    CHECK_EQ( pwiSensor::GetShedLevel(), 0 );
+    checkPeriods( 100, 100 );
+
+    // overloaded: one more level per check, up to the critical priority
+    setLoad( 90000 );
+    runCheck();
+    CHECK( pwiTimer::GetLoad() >= SHED_HIGH );
+    CHECK_EQ( pwiSensor::GetShedLevel(), 1 );
+    CHECK_EQ( pwiSensor::GetShedEvents(), 1 );
+    checkPeriods( 200, 100 );
+    runCheck();
+    CHECK_EQ( pwiSensor::GetShedLevel(), 2 );
+    // 400 ms is bounded by the 300 ms heartbeat
+    checkPeriods( 300, 200 );
+    runCheck();
+    runCheck();
+    CHECK_EQ( pwiSensor::GetShedLevel(), PWI_SENSOR_PRIORITY_CRITICAL );
+    CHECK_EQ( pwiSensor::GetShedEvents(), 3 );
+    checkPeriods( 300, 400 );
+
+    // between the thresholds: the level is held
+    setLoad( 15000 );
+    runCheck();
+    CHECK( pwiTimer::GetLoad() > SHED_LOW && pwiTimer::GetLoad() < SHED_HIGH );
+    runCheck();
+    runCheck();
+    CHECK_EQ( pwiSensor::GetShedLevel(), PWI_SENSOR_PRIORITY_CRITICAL );
+
+    // idle again: one less level per check
+    setLoad( 0 );
+    runCheck();
+    CHECK_EQ( pwiSensor::GetShedLevel(), 2 );
+    checkPeriods( 300, 200 );
+    runCheck();
+    CHECK_EQ( pwiSensor::GetShedLevel(), 1 );
+    checkPeriods( 200, 100 );
+    runCheck();
+    runCheck();
+    CHECK_EQ( pwiSensor::GetShedLevel(), 0 );
+    CHECK_EQ( pwiSensor::GetShedEvents(), 3 );
+    checkPeriods( 100, 100 );
+
+    // a load which oscillates between the thresholds does not shed
+    for( uint8_t i=0 ; i<4 ; ++i ){
+        setLoad( i%2 ? 15000 : 5000 );
+        runCheck();
+        CHECK_EQ( pwiSensor::GetShedLevel(), 0 );
+    }
+    CHECK_EQ( pwiSensor::GetShedEvents(), 3 );
+
+    setLoad( 0 );
+    st_shed_timer.stop();
+    st_low.setTimers( 0, 0 );
+    st_normal.setTimers( 0, 0 );
+    st_critical.setTimers( 0, 0 );
+}
+
+int main( void )
+{
+    scenarioHysteresis();
+    return( checkEnd( "shedding" ));
+}
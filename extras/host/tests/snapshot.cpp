@@ -0,0 +1,157 @@
+/*
+ * Deterministic tests of the save/restore round trip of pwiSnapshot, in RAM
+ * and through the simulated EEPROM.
+ *
+ * A "reboot" is simulated by clearing the state of the sensors and
+ * configuring their timers again, as setup() would.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <EEPROM.h>
+#include <pwiSensor.h>
+#include <pwiSnapshot.h>
+
+#define EEPROM_ADDRESS      200
+
+/* a sensor which saves a counter as its state, and counts its measures
+ */
+class testSensor : public pwiSensor {
+    public:
+        testSensor( uint8_t id ) : pwiSensor( id ), counter( 0 ), measures( 0 ) {}
+        uint32_t    counter;
+        uint32_t    measures;
+    protected:
+        bool vMeasure() { this->measures += 1; return( false ); }
+        void vSend() {}
+        void vRestoreState( const uint8_t *buffer, uint8_t size ) {
+            if( size == sizeof( this->counter )){
+                memcpy( &this->counter, buffer, size );
+            }
+        }
+        uint8_t vSaveState( uint8_t *buffer, uint8_t size ) {
+            memcpy( buffer, &this->counter, sizeof( this->counter ));
+            return( sizeof( this->counter ));
+        }
+};
+
+/* a sensor without state
+ */
+class plainSensor : public pwiSensor {
+    public:
+        plainSensor( uint8_t id ) : pwiSensor( id ), measures( 0 ) {}
+        uint32_t    measures;
+    protected:
+        bool vMeasure() { this->measures += 1; return( false ); }
+        void vSend() {}
+};
+
+static testSensor  st_counter( 1 );
+static plainSensor st_plain( 2 );
+
+/* configure the sensors as setup() would, and run them for @run_ms
+ */
+static void boot( uint32_t run_ms )
+{
+    st_counter.counter = 0;
+    st_counter.measures = 0;
+    st_plain.measures = 0;
+    st_counter.setTimers( 1000, 10000 );
+    st_plain.setTimers( 500, 0 );
+    checkRun( run_ms*1000, 1000 );
+}
+
+/* the remaining times of the timers and the state of the derived class are
+ * restored, and the schedule is resumed
+ */
+static void scenarioRam( void )
+{
+    checkBegin( "ram" );
+    boot( 300 );
+    st_counter.counter = 1234;
+    CHECK_EQ( pwiSnapshot::Save(), 2 );
+
+    boot( 0 );
+    CHECK_EQ( st_counter.counter, 0 );
+    CHECK_EQ( st_plain.getMinTimer().getRemaining(), 500 );
+    CHECK_EQ( pwiSnapshot::Restore(), 2 );
+    CHECK_EQ( st_counter.counter, 1234 );
+    CHECK_EQ( st_counter.getMinTimer().getRemaining(), 700 );
+    CHECK_EQ( st_counter.getMaxTimer().getRemaining(), 9700 );
+    CHECK_EQ( st_plain.getMinTimer().getRemaining(), 200 );
+    // a stopped timer stays stopped
+    CHECK( !st_plain.getMaxTimer().isStarted());
+
+    // the schedule goes on from the restored phase, then at the configured
+    // periods
+    checkRun( 200000, 1000 );
+    CHECK_EQ( st_plain.measures, 1 );
+    CHECK_EQ( st_counter.measures, 0 );
+    checkRun( 500000, 1000 );
+    CHECK_EQ( st_plain.measures, 2 );
+    CHECK_EQ( st_counter.measures, 1 );
+
+    // a restore may be repeated, the image being kept until the next save
+    CHECK_EQ( pwiSnapshot::Restore(), 2 );
+    pwiSnapshot::Invalidate();
+    CHECK_EQ( pwiSnapshot::Restore(), 0 );
+}
+
+/* only the sensors found in the image are restored
+ */
+static void scenarioIds( void )
+{
+    checkBegin( "ids" );
+    boot( 100 );
+    st_counter.counter = 99;
+    CHECK_EQ( pwiSnapshot::Save(), 2 );
+    boot( 0 );
+    st_plain.setId( 3 );
+    CHECK_EQ( pwiSnapshot::Restore(), 1 );
+    CHECK_EQ( st_counter.counter, 99 );
+    CHECK_EQ( st_plain.getMinTimer().getRemaining(), 500 );
+    st_plain.setId( 2 );
+}
+
+/* the image round trips through the EEPROM, and a corrupted or blank one is
+ * ignored
+ */
+static void scenarioEeprom( void )
+{
+    checkBegin( "eeprom" );
+    CHECK_EQ( pwiSnapshot::Restore( EEPROM_ADDRESS ), 0 );
+
+    boot( 400 );
+    st_counter.counter = 0xdeadbeef;
+    CHECK_EQ( pwiSnapshot::Save( EEPROM_ADDRESS ), 2 );
+    uint32_t writes = hostEepromTotalWrites();
+    CHECK( writes > 0 );
+    // saving the same image again does not wear the EEPROM
+    CHECK_EQ( pwiSnapshot::Save( EEPROM_ADDRESS ), 2 );
+    CHECK_EQ( hostEepromTotalWrites(), writes );
+
+    // a cold start: the RAM image is lost
+    pwiSnapshot::Invalidate();
+    boot( 0 );
+    CHECK_EQ( pwiSnapshot::Restore( EEPROM_ADDRESS ), 2 );
+    CHECK_EQ( st_counter.counter, 0xdeadbeef );
+    CHECK_EQ( st_counter.getMinTimer().getRemaining(), 600 );
+    CHECK_EQ( st_plain.getMinTimer().getRemaining(), 100 );
+
+    // a flipped bit is caught by the crc
+    pwiSnapshot::Invalidate();
+    boot( 0 );
+    EEPROM.write( EEPROM_ADDRESS+10, EEPROM.read( EEPROM_ADDRESS+10 ) ^ 0x04 );
+    CHECK_EQ( pwiSnapshot::Restore( EEPROM_ADDRESS ), 0 );
+    CHECK_EQ( st_counter.counter, 0 );
+    CHECK_EQ( pwiSnapshot::Restore(), 0 );
+}
+
+int main( void )
+{
+    scenarioRam();
+    scenarioIds();
+    scenarioEeprom();
+    return( checkEnd( "snapshot" ));
+}
@@ -0,0 +1,146 @@
+/*
+ * Deterministic tests of the runtime statistics of pwiSensor.
+ * The checks are only run when built with PWI_SENSOR_STATS, which is the
+ * case of the second pass of 'make check'.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <core/MySensorsCore.h>
+#include <pwiSensor.h>
+
+#ifdef PWI_SENSOR_STATS
+
+#define MEASURE_US          200
+#define SEND_US             500
+
+/* a sensor whose measure and send last a known duration on the simulated
+ * clock
+ */
+class testSensor : public pwiSensor {
+    public:
+        testSensor( uint8_t id ) : pwiSensor( id ), changed( false ) {}
+        bool        changed;
+    protected:
+        bool vMeasure() { hostClockAdvance( MEASURE_US ); return( this->changed ); }
+        void vSend() { hostClockAdvance( SEND_US ); }
+};
+
+static testSensor st_sensor( 3 );
+static testSensor st_other( 4 );
+static pwiTimer   st_stats_timer;
+
+/* the messages sent to the diagnostic child
+ */
+static uint8_t st_sent;
+static uint8_t st_child[8];
+static char    st_text[8][1+MAX_PAYLOAD];
+
+static void sendCb( const MyMessage &msg, void *user_data )
+{
+    if( st_sent < 8 ){
+        st_child[st_sent] = msg.getSensor();
+        strncpy( st_text[st_sent], msg.getString(), MAX_PAYLOAD );
+        st_sent += 1;
+    }
+}
+
+/* the measures, suppressed measures, sends and their durations are counted;
+ * as the min timer restarts after the stall of the measure, the periods are
+ * run with some margin
+ */
+static void scenarioCounters( void )
+{
+    checkBegin( "counters" );
+    st_sensor.resetStats();
+    st_sensor.setTimers( 100, 0 );
+    checkRun( 550000, 1000 );
+    const pwiSensorStats &stats = st_sensor.getStats();
+    CHECK_EQ( stats.measures, 5 );
+    CHECK_EQ( stats.suppressed, 5 );
+    CHECK_EQ( stats.sends, 0 );
+
+    st_sensor.changed = true;
+    checkRun( 300000, 1000 );
+    CHECK_EQ( stats.measures, 8 );
+    CHECK_EQ( stats.suppressed, 5 );
+    CHECK_EQ( stats.sends, 3 );
+    CHECK_EQ( stats.heartbeats, 0 );
+    CHECK_EQ( stats.measure_max_us, MEASURE_US );
+    CHECK_EQ( stats.measure_total_us, 8*MEASURE_US );
+    CHECK_EQ( stats.send_max_us, SEND_US );
+    CHECK_EQ( stats.send_total_us, 3*SEND_US );
+    st_sensor.setTimers( 0, 0 );
+    st_sensor.changed = false;
+
+    st_sensor.resetStats();
+    CHECK_EQ( stats.measures, 0 );
+    CHECK_EQ( stats.send_max_us, 0 );
+}
+
+/* the sends of the max period are counted as heartbeats
+ */
+static void scenarioHeartbeats( void )
+{
+    checkBegin( "heartbeats" );
+    st_sensor.resetStats();
+    st_sensor.setTimers( 0, 1000 );
+    checkRun( 2000000, 1000 );
+    const pwiSensorStats &stats = st_sensor.getStats();
+    CHECK_EQ( stats.measures, 0 );
+    CHECK_EQ( stats.sends, 2 );
+    CHECK_EQ( stats.heartbeats, 2 );
+    st_sensor.setTimers( 0, 0 );
+}
+
+/* the statistics timer publishes two messages per sensor to the diagnostic
+ * child, then resets the statistics
+ */
+static void scenarioSend( void )
+{
+    checkBegin( "send" );
+    st_sensor.resetStats();
+    st_other.resetStats();
+    st_sensor.changed = true;
+    st_sensor.setTimers( 100, 0 );
+    checkRun( 450000, 1000 );
+    st_sensor.setTimers( 0, 0 );
+    st_sensor.changed = false;
+    st_sensor.setTimers( 100, 0 );
+    checkRun( 150000, 1000 );
+    st_sensor.setTimers( 0, 0 );
+
+    hostTransportHook( sendCb, NULL );
+    st_sent = 0;
+    pwiSensor::SetupStats( st_stats_timer, 200, 1000 );
+    checkRun( 1000000, 1000 );
+    CHECK_EQ( st_sent, 4 );
+    CHECK_EQ( st_child[0], 200 );
+    CHECK_EQ( st_child[3], 200 );
+    CHECK( !strcmp( st_text[0], "#3 m5 s4 x1 h0" ));
+    CHECK( !strcmp( st_text[1], "#3 M200/200 S500/500" ));
+    CHECK( !strcmp( st_text[2], "#4 m0 s0 x0 h0" ));
+    CHECK( !strcmp( st_text[3], "#4 M0/0 S0/0" ));
+    CHECK_EQ( st_sensor.getStats().measures, 0 );
+
+    // the next publication starts from zero
+    checkRun( 1000000, 1000 );
+    CHECK_EQ( st_sent, 8 );
+    CHECK( !strcmp( st_text[4], "#3 m0 s0 x0 h0" ));
+    st_stats_timer.stop();
+}
+
+#endif // PWI_SENSOR_STATS
+
+int main( void )
+{
+#ifdef PWI_SENSOR_STATS
+    scenarioCounters();
+    scenarioHeartbeats();
+    scenarioSend();
+    return( checkEnd( "stats" ));
+#else
+    return( checkSkip( "stats", "PWI_SENSOR_STATS" ));
+#endif
+}
@@ -0,0 +1,214 @@
+/*
+ * Tests of the PWI_THREADS dispatch: the timer callbacks run on a worker,
+ * while the sends are serialized onto the radio thread, which is the main
+ * thread of this program.
+ * The checks are only run when built with PWI_THREADS, which is the case of
+ * the second pass of 'make check'.
+ *
+ * The workers run in real time against the simulated clock: after each
+ * pwiTimer::Loop(), the main thread waits for the single worker to have run
+ * all the submitted jobs (see settle()), so that the scenarios stay
+ * deterministic.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+#include <core/MySensorsCore.h>
+#include <pwiSendQueue.h>
+#include <pwiSensor.h>
+
+#ifdef PWI_THREADS
+
+#include <unistd.h>
+
+#define SETTLE_TIMEOUT_US       2000000
+
+static pthread_t st_main;
+
+/* the sentinel job: as the single worker runs the jobs in order, the jobs
+ * submitted before it have all been run when it runs
+ */
+static void sentinelCb( volatile bool *done )
+{
+    __atomic_store_n( done, true, __ATOMIC_RELEASE );
+}
+
+/* wait for the worker to have run all the submitted jobs, then run the jobs
+ * posted to the radio thread
+ *
+ * Returns: %FALSE on timeout.
+ */
+static bool settle( void )
+{
+    volatile bool done = false;
+    if( !pwiThreads::Submit(( pwiThreadsJobCb ) sentinelCb, ( void * ) &done )){
+        return( false );
+    }
+    for( uint32_t waited=0 ; !__atomic_load_n( &done, __ATOMIC_ACQUIRE ) ; waited+=100 ){
+        if( waited >= SETTLE_TIMEOUT_US ){
+            return( false );
+        }
+        usleep( 100 );
+    }
+    pwiThreads::RadioLoop();
+    return( true );
+}
+
+/* run the main loop for @duration_us, advancing the clock by @step_us
+ * between two iterations
+ *
+ * Returns: %FALSE if the worker has not been able to keep up.
+ */
+static bool run( uint64_t duration_us, uint32_t step_us )
+{
+    uint64_t end_us = hostClockMicros() + duration_us;
+    bool ok = true;
+    while( hostClockMicros() < end_us ){
+        hostClockAdvance( step_us );
+        pwiTimer::Loop();
+        ok &= settle();
+    }
+    return( ok );
+}
+
+/* a periodic timer whose callback records the calling thread
+ */
+static pwiTimer     st_timer;
+static uint32_t     st_calls;
+static uint32_t     st_calls_on_main;
+
+static void timerCb( void *user_data )
+{
+    st_calls += 1;
+    if( pthread_equal( pthread_self(), st_main )){
+        st_calls_on_main += 1;
+    }
+}
+
+/* a sensor which changes on each measure, and records the threads of its
+ * measures and sends
+ */
+class testSensor : public pwiSensor {
+    public:
+        testSensor( uint8_t id ) : pwiSensor( id ), measures( 0 ), measures_on_main( 0 ), sends( 0 ), sends_on_main( 0 ) {}
+        uint32_t    measures;
+        uint32_t    measures_on_main;
+        uint32_t    sends;
+        uint32_t    sends_on_main;
+    protected:
+        bool vMeasure() {
+            this->measures += 1;
+            this->measures_on_main += pthread_equal( pthread_self(), st_main ) ? 1 : 0;
+            return( true );
+        }
+        void vSend() {
+            this->sends += 1;
+            this->sends_on_main += pthread_equal( pthread_self(), st_main ) ? 1 : 0;
+        }
+};
+
+static testSensor st_sensor( 1 );
+
+/* a transport which is down, and records the time and the thread of the
+ * attempts
+ */
+static uint32_t st_attempts;
+static uint32_t st_attempts_on_main;
+static uint32_t st_attempts_ms[16];
+
+static bool downTransport( MyMessage &msg, uint32_t ts_ms, void *user_data )
+{
+    if( st_attempts < 16 ){
+        st_attempts_ms[st_attempts] = millis();
+    }
+    st_attempts += 1;
+    st_attempts_on_main += pthread_equal( pthread_self(), st_main ) ? 1 : 0;
+    return( false );
+}
+
+static pwiSendQueueItem st_items[4];
+static pwiSendQueue     st_queue( st_items, 4 );
+
+/* the timer callbacks run on the worker, one after the other
+ */
+static void scenarioWorkers( void )
+{
+    checkBegin( "workers" );
+    CHECK( pwiThreads::StartWorkers( 1 ));
+    CHECK_EQ( pwiThreads::GetWorkersCount(), 1 );
+    pwiThreads::RadioLoop();
+    CHECK( pwiThreads::IsRadioThread());
+
+    st_timer.setup( "Worker", 100, false, timerCb );
+    st_timer.start();
+    CHECK( run( 1000000, 1000 ));
+    CHECK_EQ( st_calls, 10 );
+    CHECK_EQ( st_calls_on_main, 0 );
+    st_timer.stop();
+}
+
+/* the measures are taken on the worker, and sent from the radio thread
+ */
+static void scenarioRadio( void )
+{
+    checkBegin( "radio" );
+    st_sensor.setTimers( 100, 0 );
+    // the post to the radio thread is only run by RadioLoop()
+    hostClockAdvance( 100000 );
+    pwiTimer::Loop();
+    volatile bool done = false;
+    CHECK( pwiThreads::Submit(( pwiThreadsJobCb ) sentinelCb, ( void * ) &done ));
+    for( uint32_t waited=0 ; !done && waited<SETTLE_TIMEOUT_US ; waited+=100 ){
+        usleep( 100 );
+    }
+    CHECK_EQ( st_sensor.measures, 1 );
+    CHECK_EQ( st_sensor.sends, 0 );
+    pwiThreads::RadioLoop();
+    CHECK_EQ( st_sensor.sends, 1 );
+
+    CHECK( run( 900000, 1000 ));
+    CHECK_EQ( st_sensor.measures, 10 );
+    CHECK_EQ( st_sensor.measures_on_main, 0 );
+    CHECK_EQ( st_sensor.sends, 10 );
+    CHECK_EQ( st_sensor.sends_on_main, 10 );
+    st_sensor.setTimers( 0, 0 );
+}
+
+/* the send queue is flushed from the radio thread, and the retries follow
+ * the exponential backoff without lagging behind
+ */
+static void scenarioSendQueue( void )
+{
+    checkBegin( "send queue" );
+    st_queue.setTransport( downTransport );
+    st_queue.setBackoff( 1000, 8000 );
+    MyMessage msg( 1, V_VAR1 );
+    CHECK_EQ( st_queue.send( msg.set(( uint32_t ) 1 )), PWI_SEND_QUEUE_QUEUED );
+    CHECK( run( 16000000, 10000 ));
+    // immediate attempt, then +1, +2, +4, +8 seconds
+    CHECK_EQ( st_attempts, 5 );
+    CHECK_EQ( st_attempts_on_main, 5 );
+    CHECK_EQ( st_attempts_ms[1] - st_attempts_ms[0], 1000 );
+    CHECK_EQ( st_attempts_ms[2] - st_attempts_ms[1], 2000 );
+    CHECK_EQ( st_attempts_ms[3] - st_attempts_ms[2], 4000 );
+    CHECK_EQ( st_attempts_ms[4] - st_attempts_ms[3], 8000 );
+    CHECK_EQ( pwiThreads::GetDropped(), 0 );
+}
+
+#endif // PWI_THREADS
+
+int main( void )
+{
+#ifdef PWI_THREADS
+    st_main = pthread_self();
+    scenarioWorkers();
+    scenarioRadio();
+    scenarioSendQueue();
+    pwiThreads::StopWorkers();
+    CHECK_EQ( pwiThreads::GetWorkersCount(), 0 );
+    return( checkEnd( "threads" ));
+#else
+    return( checkSkip( "threads", "PWI_THREADS" ));
+#endif
+}
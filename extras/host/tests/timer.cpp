@@ -0,0 +1,137 @@
+/*
+ * Deterministic tests of pwiTimer on the simulated clock.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "check.h"
+
+static pwiTimer st_once;
+static pwiTimer st_periodic;
+static pwiTimer st_other;
+
+static void countCb( void *user_data )
+{
+    *( uint32_t * ) user_data += 1;
+}
+
+/* a once timer fires exactly once, when its delay has elapsed
+ */
+static void scenarioOnce( void )
+{
+    uint32_t count = 0;
+    checkBegin( "once" );
+    st_once.setup( "once", 100, true, countCb, &count );
+    st_once.start();
+    CHECK( st_once.isStarted());
+    checkRun( 99000, 1000 );
+    CHECK_EQ( count, 0 );
+    CHECK_EQ( st_once.getRemaining(), 1 );
+    checkRun( 1000, 1000 );
+    CHECK_EQ( count, 1 );
+    CHECK( !st_once.isStarted());
+    checkRun( 500000, 1000 );
+    CHECK_EQ( count, 1 );
+}
+
+/* a periodic timer fires each period, and is restarted from the time it has
+ * been detected as expired
+ */
+static void scenarioPeriodic( void )
+{
+    uint32_t count = 0;
+    checkBegin( "periodic" );
+    st_periodic.setup( "periodic", 50, false, countCb, &count );
+    st_periodic.start();
+    checkRun( 1000000, 1000 );
+    CHECK_EQ( count, 20 );
+    CHECK( st_periodic.isStarted());
+
+    // a loop slower than the period cannot fire it more than once per loop
+    count = 0;
+    st_periodic.restart();
+    checkRun( 1000000, 120000 );
+    CHECK_EQ( count, 9 );
+
+    st_periodic.stop();
+    count = 0;
+    checkRun( 1000000, 1000 );
+    CHECK_EQ( count, 0 );
+}
+
+/* the millis() rollover neither fires a timer too early, nor delays it
+ */
+static void scenarioRollover( void )
+{
+    uint32_t count = 0;
+    checkBegin( "rollover" );
+    // millis() is 30 ms before its rollover
+    hostClockSet(( 1ULL << 32 ) * 1000 - 30000 );
+    CHECK_EQ( millis(), 0xffffffffUL - 29 );
+    st_periodic.setup( "rollover", 20, false, countCb, &count );
+    st_periodic.start();
+    checkRun( 19000, 1000 );
+    CHECK_EQ( count, 0 );
+    checkRun( 81000, 1000 );
+    CHECK_EQ( count, 5 );
+    st_periodic.stop();
+}
+
+/* the remaining delay and the next deadline
+ */
+static void scenarioDeadline( void )
+{
+    uint32_t count = 0, remaining = 0;
+    checkBegin( "deadline" );
+    CHECK( !pwiTimer::NextDeadline( remaining ));
+    st_once.setup( "long", 100, true, countCb, &count );
+    st_other.setup( "short", 40, true, countCb, &count );
+    st_once.start();
+    st_other.start();
+    checkRun( 30000, 1000 );
+    CHECK_EQ( st_once.getRemaining(), 70 );
+    CHECK( pwiTimer::NextDeadline( remaining ));
+    CHECK_EQ( remaining, 10 );
+    checkRun( 10000, 1000 );
+    CHECK_EQ( count, 1 );
+    CHECK( pwiTimer::NextDeadline( remaining ));
+    CHECK_EQ( remaining, 60 );
+
+    // a timer without delay cannot be started
+    st_other.setup( "unset", 0, true, countCb, &count );
+    st_other.start();
+    CHECK( !st_other.isStarted());
+    st_once.stop();
+    CHECK( !pwiTimer::NextDeadline( remaining ));
+
+    // an overdue timer has a zero remaining delay until it is run
+    st_once.setup( "overdue", 20, true, countCb, &count );
+    st_once.start();
+    hostClockAdvance( 50000 );
+    CHECK( pwiTimer::NextDeadline( remaining ));
+    CHECK_EQ( remaining, 0 );
+    pwiTimer::Loop();
+    CHECK_EQ( count, 2 );
+    CHECK( !pwiTimer::NextDeadline( remaining ));
+
+    // the deadline across the millis() rollover
+    hostClockSet(( 1ULL << 32 ) * 1000 - 10000 );
+    st_once.setup( "rollover", 30, true, countCb, &count );
+    st_once.start();
+    hostClockAdvance( 15000 );
+    CHECK( pwiTimer::NextDeadline( remaining ));
+    CHECK_EQ( remaining, 15 );
+
+    // the timers of another type are ignored
+    CHECK( !pwiTimer::NextDeadline( remaining, "pwiOtherTimer" ));
+    st_once.stop();
+}
+
+int main( void )
+{
+    scenarioOnce();
+    scenarioPeriodic();
+    scenarioRollover();
+    scenarioDeadline();
+    return( checkEnd( "timer" ));
+}
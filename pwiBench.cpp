@@ -0,0 +1,277 @@
+/*
+ * pwi 2026-10-18 creation
+ */
+
+#include "pwiBench.h"
+
+#if defined( __AVR__ ) && defined( TCNT1 ) && defined( TIFR1 )
+#define HAVE_TIMER1
+#elif defined( __linux__ )
+#define HAVE_MONOTONIC
+#include <time.h>
+#endif
+
+/**
+ * pwiBench::pwiBench:
+ * @name: the name of the bench, as printed in the first CSV column; the
+ *  string is not copied.
+ *
+ * Constructor.
+ *
+ * Public.
+ */
+pwiBench::pwiBench( const char *name )
+{
+    this->name = name;
+    this->reset();
+    this->start_us = 0;
+    this->start_ticks = 0;
+}
+
+/**
+ * pwiBench::getCount:
+ *
+ * Returns: the count of measured runs.
+ *
+ * Public.
+ */
+uint32_t pwiBench::getCount( void )
+{
+    return( this->count );
+}
+
+/**
+ * pwiBench::getMax:
+ *
+ * Returns: the longest run.
+ *
+ * Public.
+ */
+uint32_t pwiBench::getMax( void )
+{
+    return( this->max );
+}
+
+/**
+ * pwiBench::getMean:
+ *
+ * Returns: the mean duration of a run.
+ *
+ * Public.
+ */
+uint32_t pwiBench::getMean( void )
+{
+    return( this->count ? ( uint32_t )( this->total / this->count ) : 0 );
+}
+
+/**
+ * pwiBench::getMin:
+ *
+ * Returns: the shortest run.
+ *
+ * Public.
+ */
+uint32_t pwiBench::getMin( void )
+{
+    return( this->count ? this->min : 0 );
+}
+
+/**
+ * pwiBench::getTotal:
+ *
+ * Returns: the cumulated duration of the runs.
+ *
+ * Public.
+ */
+uint64_t pwiBench::getTotal( void )
+{
+    return( this->total );
+}
+
+/**
+ * pwiBench::add:
+ * @elapsed: the duration of a run, in Unit().
+ *
+ * Account for a run which has been measured by the caller.
+ *
+ * Public.
+ */
+void pwiBench::add( uint32_t elapsed )
+{
+    this->count += 1;
+    this->total += elapsed;
+    if( elapsed < this->min ){
+        this->min = elapsed;
+    }
+    if( elapsed > this->max ){
+        this->max = elapsed;
+    }
+}
+
+/**
+ * pwiBench::csv:
+ * @param: the value of the parameter the bench has been run with (e.g. the
+ *  count of timers).
+ *
+ * Print the results as a CSV row to the Serial (see CsvHeader()).
+ *
+ * Public.
+ */
+void pwiBench::csv( uint32_t param )
+{
+    Serial.print( this->name );
+    Serial.print( ',' );
+    Serial.print(( unsigned long ) param );
+    Serial.print( ',' );
+    Serial.print(( unsigned long ) this->count );
+    Serial.print( ',' );
+    Serial.print(( unsigned long ) this->getMin());
+    Serial.print( ',' );
+    Serial.print(( unsigned long ) this->max );
+    Serial.print( ',' );
+    Serial.print(( unsigned long ) this->getMean());
+    Serial.print( ',' );
+    Serial.println( Unit());
+}
+
+/**
+ * pwiBench::reset:
+ *
+ * Reset the accumulated results.
+ *
+ * Public.
+ */
+void pwiBench::reset( void )
+{
+    this->count = 0;
+    this->min = 0xffffffff;
+    this->max = 0;
+    this->total = 0;
+}
+
+/**
+ * pwiBench::start:
+ *
+ * Start measuring a run.
+ *
+ * Public.
+ */
+void pwiBench::start( void )
+{
+#ifdef HAVE_TIMER1
+    TIFR1 = _BV( TOV1 );
+#endif
+    this->start_us = micros();
+    this->start_ticks = Ticks();
+}
+
+/**
+ * pwiBench::stop:
+ *
+ * End measuring the run, and account for it.
+ *
+ * Returns: the duration of the run, in Unit().
+ *
+ * Public.
+ */
+uint32_t pwiBench::stop( void )
+{
+    uint32_t ticks = Ticks();
+    uint32_t elapsed;
+#ifdef HAVE_TIMER1
+    if( TIFR1 & _BV( TOV1 )){
+        elapsed = ( micros() - this->start_us ) * ( F_CPU / 1000000UL );
+    } else {
+        elapsed = ( uint16_t )( ticks - this->start_ticks );
+    }
+#else
+    elapsed = ticks - this->start_ticks;
+#endif
+    this->add( elapsed );
+    return( elapsed );
+}
+
+/**
+ * pwiBench::Begin:
+ *
+ * Acquire the time base. On AVR, this reconfigures Timer1 as a free-running
+ * counter of the CPU cycles.
+ *
+ * Public Static.
+ */
+void pwiBench::Begin( void )
+{
+#ifdef HAVE_TIMER1
+    noInterrupts();
+    TIMSK1 = 0;
+    TCCR1A = 0;
+    TCCR1B = _BV( CS10 );
+    TCNT1 = 0;
+    TIFR1 = _BV( TOV1 );
+    interrupts();
+#endif
+}
+
+/**
+ * pwiBench::CsvHeader:
+ *
+ * Print the header of the CSV rows to the Serial.
+ *
+ * Public Static.
+ */
+void pwiBench::CsvHeader( void )
+{
+    Serial.println( F( "bench,param,count,min,max,mean,unit" ));
+}
+
+/**
+ * pwiBench::End:
+ *
+ * Release the time base.
+ *
+ * Public Static.
+ */
+void pwiBench::End( void )
+{
+#ifdef HAVE_TIMER1
+    TCCR1B = 0;
+#endif
+}
+
+/**
+ * pwiBench::Unit:
+ *
+ * Returns: the unit of the measures.
+ *
+ * Public Static.
+ */
+const char *pwiBench::Unit( void )
+{
+#if defined( HAVE_TIMER1 )
+    return( "cycles" );
+#elif defined( HAVE_MONOTONIC )
+    return( "ns" );
+#else
+    return( "us" );
+#endif
+}
+
+/**
+ * pwiBench::Ticks:
+ *
+ * Returns: the current value of the time base, in Unit().
+ *
+ * Private Static.
+ */
+uint32_t pwiBench::Ticks( void )
+{
+#if defined( HAVE_TIMER1 )
+    return( TCNT1 );
+#elif defined( HAVE_MONOTONIC )
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return(( uint32_t )(( uint64_t ) ts.tv_sec * 1000000000ULL + ts.tv_nsec ));
+#else
+    return( micros());
+#endif
+}
@@ -0,0 +1,84 @@
+#ifndef __PWI_BENCH_H__
+#define __PWI_BENCH_H__
+
+/*
+ * A minimal benchmark accumulator.
+ *
+ * Each start()/stop() pair measures one run of the code under test; the
+ * count, min, max and total of the runs are accumulated, and may be printed
+ * as a CSV row so that the results can be tracked across versions.
+ *
+ * The time unit depends on the target:
+ * - on AVR, CPU cycles, read from the Timer1 running without prescaler; as
+ *   the overflow interrupt is not used, a run longer than 65535 cycles (4 ms
+ *   at 16 MHz) falls back to micros() converted to cycles; this so conflicts
+ *   with any other user of Timer1 (e.g. pwiHwCounter) while the bench runs;
+ * - on Linux, nanoseconds of the monotonic clock (the real time, not the
+ *   simulated one of extras/host);
+ * - elsewhere, micros().
+ *
+ * Usage synopsys:
+ *
+ * a) define the bench:
+ *    pwiBench myBench( "loop" );
+ *
+ * b) measure the code:
+ *    pwiBench::Begin();
+ *    for( i=0 ; i<n ; ++i ){
+ *        myBench.start();
+ *        code_under_test();
+ *        myBench.stop();
+ *    }
+ *
+ * c) print the results:
+ *    pwiBench::CsvHeader();
+ *    myBench.csv( param );
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <Arduino.h>
+
+class pwiBench {
+    public:
+                                  pwiBench( const char *name );
+
+		/* getters
+		 */
+                uint32_t          getCount( void );
+                uint32_t          getMax( void );
+                uint32_t          getMean( void );
+                uint32_t          getMin( void );
+                uint64_t          getTotal( void );
+
+		/* actors
+		 */
+                void              add( uint32_t elapsed );
+                void              csv( uint32_t param );
+                void              reset( void );
+                void              start( void );
+                uint32_t          stop( void );
+
+        /* static methods
+         */
+        static  void              Begin( void );
+        static  void              CsvHeader( void );
+        static  void              End( void );
+        static  const char       *Unit( void );
+
+    private:
+                const char       *name;
+                uint32_t          count;
+                uint32_t          min;
+                uint32_t          max;
+                uint64_t          total;
+
+        /* runtime
+         */
+                uint32_t          start_us;
+                uint32_t          start_ticks;
+
+        static  uint32_t          Ticks( void );
+};
+
+#endif // __PWI_BENCH_H__
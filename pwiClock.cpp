@@ -0,0 +1,89 @@
+/*
+ * pwi 2026-10-18 creation
+ */
+
+#include "pwiClock.h"
+
+uint32_t          pwiMicrosClock::last_us = 0;
+uint32_t          pwiMicrosClock::rest_us = 0;
+uint32_t          pwiMicrosClock::now_ms = 0;
+
+volatile uint32_t pwiRtcClock::seconds = 0;
+volatile uint32_t pwiRtcClock::tick_ms = 0;
+uint32_t          pwiRtcClock::last = 0;
+
+uint32_t          pwiManualClock::now_ms = 0;
+
+/**
+ * pwiMicrosClock::Now:
+ *
+ * Returns: the count of ms, as accumulated from the micros() increments.
+ *
+ * Public Static.
+ */
+uint32_t pwiMicrosClock::Now( void )
+{
+    noInterrupts();
+    uint32_t now_us = micros();
+    pwiMicrosClock::rest_us += pwiElapsed( pwiMicrosClock::last_us, now_us );
+    pwiMicrosClock::last_us = now_us;
+    pwiMicrosClock::now_ms += pwiMicrosClock::rest_us / 1000;
+    pwiMicrosClock::rest_us %= 1000;
+    uint32_t now_ms = pwiMicrosClock::now_ms;
+    interrupts();
+    return( now_ms );
+}
+
+/**
+ * pwiRtcClock::Now:
+ *
+ * Returns: the count of ms, as the count of seconds of the RTC, plus the
+ * ms elapsed since the last tick (bounded to 999 ms so that a missed or late
+ * tick does not make the clock jump back).
+ *
+ * Public Static.
+ */
+uint32_t pwiRtcClock::Now( void )
+{
+    noInterrupts();
+    uint32_t seconds = pwiRtcClock::seconds;
+    uint32_t tick_ms = pwiRtcClock::tick_ms;
+    interrupts();
+    uint32_t now = 1000UL * seconds + min( pwiElapsed( tick_ms, millis()), ( uint32_t ) 999 );
+    if( pwiBefore( now, pwiRtcClock::last )){
+        now = pwiRtcClock::last;
+    }
+    pwiRtcClock::last = now;
+    return( now );
+}
+
+/**
+ * pwiRtcClock::Set:
+ * @seconds: the count of seconds read from the RTC.
+ *
+ * Synchronize the clock with the RTC, e.g. at startup or after a deep sleep
+ * during which the ticks have not been counted.
+ *
+ * Public Static.
+ */
+void pwiRtcClock::Set( uint32_t seconds )
+{
+    noInterrupts();
+    pwiRtcClock::seconds = seconds;
+    pwiRtcClock::tick_ms = millis();
+    interrupts();
+}
+
+/**
+ * pwiRtcClock::Tick:
+ *
+ * Account for a new second. This is expected to be called from the
+ * interrupt service routine of the 1 Hz output of the RTC.
+ *
+ * Public Static.
+ */
+void pwiRtcClock::Tick( void )
+{
+    pwiRtcClock::seconds += 1;
+    pwiRtcClock::tick_ms = millis();
+}
@@ -0,0 +1,115 @@
+#ifndef __PWI_CLOCK_H__
+#define __PWI_CLOCK_H__
+
+/*
+ * Time sources and wrap-safe time arithmetic.
+ *
+ * A clock is a class with a static Now() method which returns a 32-bits
+ * count of milliseconds. The count is free to wrap around: all comparisons
+ * must be made through the helpers below, which only rely on the difference
+ * of two timestamps, and are so correct as long as the compared instants are
+ * less than 2^31 ms (about 24 days) apart.
+ *
+ * The following clocks are provided:
+ * - pwiMillisClock: the Arduino millis(), this is the default;
+ * - pwiMicrosClock: milliseconds derived from micros(), which are more
+ *   regular than millis() on AVR (the latter jumps by 2 ms from time to
+ *   time); Now() must be called at least once per micros() period (about
+ *   71 minutes), which is the case as soon as a timer is checked from the
+ *   main loop;
+ * - pwiRtcClock: milliseconds derived from a seconds counter maintained by
+ *   a RTC (e.g. from its 1 Hz square wave output), interpolated with
+ *   millis() inside the current second; this keeps the time across deep
+ *   sleep, during which millis() does not run;
+ * - pwiManualClock: a clock explicitly set or advanced by the program, e.g.
+ *   for simulations or tests.
+ *
+ * The pwiTimer class (and so pwiSensor and the other timer users) is bound
+ * to one clock at build time through the PWI_TIMER_CLOCK macro, e.g. with
+ * -DPWI_TIMER_CLOCK=pwiRtcClock. As Now() is static and inlined, the default
+ * build does not pay for any indirection.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <Arduino.h>
+
+/* wrap-safe helpers
+ */
+
+/* the time elapsed from @since to @now
+ */
+static inline uint32_t pwiElapsed( uint32_t since, uint32_t now )
+{
+    return( now - since );
+}
+
+/* whether @delay has elapsed from @since to @now
+ */
+static inline bool pwiReached( uint32_t since, uint32_t delay, uint32_t now )
+{
+    return( now - since >= delay );
+}
+
+/* the time remaining from @now until @delay has elapsed since @since, zero
+ * when already reached
+ */
+static inline uint32_t pwiRemaining( uint32_t since, uint32_t delay, uint32_t now )
+{
+    uint32_t elapsed = now - since;
+    return( elapsed >= delay ? 0 : delay - elapsed );
+}
+
+/* whether @a is before @b
+ */
+static inline bool pwiBefore( uint32_t a, uint32_t b )
+{
+    return(( int32_t )( a - b ) < 0 );
+}
+
+/* clocks
+ */
+class pwiMillisClock {
+    public:
+        static inline uint32_t    Now( void ) { return( millis()); }
+};
+
+class pwiMicrosClock {
+    public:
+        static  uint32_t          Now( void );
+
+    private:
+        static  uint32_t          last_us;
+        static  uint32_t          rest_us;
+        static  uint32_t          now_ms;
+};
+
+class pwiRtcClock {
+    public:
+        static  uint32_t          Now( void );
+        static  void              Set( uint32_t seconds );
+        static  void              Tick( void );
+
+    private:
+        static  volatile uint32_t seconds;
+        static  volatile uint32_t tick_ms;          // millis() at the last tick
+        static  uint32_t          last;             // last returned value, so that Now() never goes back
+};
+
+class pwiManualClock {
+    public:
+        static inline uint32_t    Now( void ) { return( now_ms ); }
+        static inline void        Advance( uint32_t delta_ms ) { now_ms += delta_ms; }
+        static inline void        Set( uint32_t ms ) { now_ms = ms; }
+
+    private:
+        static  uint32_t          now_ms;
+};
+
+/* the clock of the pwiTimer's
+ */
+#ifndef PWI_TIMER_CLOCK
+#define PWI_TIMER_CLOCK                 pwiMillisClock
+#endif
+
+#endif // __PWI_CLOCK_H__
@@ -5,6 +5,8 @@
  * pwi 2019-10- 5 v191001 creation
  * pwi 2019-10-14 v191002
  *                 get rid of <drivers/Linux/Arduino.h> include file
+ * pwi 2026-10-18 the library may be built on a Linux host against the
+ *                 simulated Arduino environment of extras/host/
  */
 
 /*
@@ -0,0 +1,34 @@
+#include "pwiCrc.h"
+
+/*
+ * pwi 2026-10-18 creation
+ */
+
+/**
+ * pwiCrc8:
+ * @data: the data to be checksummed.
+ * @size: the size of @data in bytes.
+ * @crc: the initial value, which may be a previously computed crc so that
+ *  the checksum of non-contiguous data can be computed.
+ *
+ * Compute a CRC-8 (Dallas/Maxim polynomial, as used by 1-Wire devices),
+ * bit by bit, so that no lookup table is needed.
+ *
+ * Returns: the crc of @data.
+ */
+uint8_t pwiCrc8( const void *data, uint16_t size, uint8_t crc )
+{
+    const uint8_t *ptr = ( const uint8_t * ) data;
+    while( size-- ){
+        uint8_t byte = *ptr++;
+        for( uint8_t i=0 ; i<8 ; ++i ){
+            uint8_t mix = ( crc ^ byte ) & 0x01;
+            crc >>= 1;
+            if( mix ){
+                crc ^= 0x8c;
+            }
+            byte >>= 1;
+        }
+    }
+    return( crc );
+}
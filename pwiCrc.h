@@ -0,0 +1,12 @@
+#ifndef __PWI_CRC_H__
+#define __PWI_CRC_H__
+
+#include <Arduino.h>
+
+/*
+ * pwi 2026-10-18 creation
+ */
+
+uint8_t pwiCrc8( const void *data, uint16_t size, uint8_t crc=0 );
+
+#endif // __PWI_CRC_H__
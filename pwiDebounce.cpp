@@ -0,0 +1,236 @@
+/*
+ * pwi 2026-10-18 creation
+ *                use the pwiClock wrap-safe helpers
+ *                the lockout may only be started by the active level
+ */
+
+#include "pwiDebounce.h"
+#include "pwiClock.h"
+
+/**
+ * pwiDebounce::pwiDebounce:
+ *
+ * Constructor.
+ * The default is a lockout strategy without any lockout delay, i.e. no
+ * debounce at all.
+ *
+ * Public.
+ */
+pwiDebounce::pwiDebounce( void )
+{
+    /* setup
+     */
+    this->strategy = PWI_DEBOUNCE_LOCKOUT;
+    this->threshold = 1;
+    this->active = PWI_DEBOUNCE_ANY_LEVEL;
+    this->lockout_us = 0;
+    this->sample_us = 0;
+
+    /* runtime
+     */
+    this->state = LOW;
+    this->counter = 0;
+    this->primed = false;
+    this->last_us = 0;
+}
+
+/**
+ * pwiDebounce::getLockout:
+ *
+ * Returns: the lockout delay in us.
+ *
+ * Public.
+ */
+uint32_t pwiDebounce::getLockout( void )
+{
+    return( this->lockout_us );
+}
+
+/**
+ * pwiDebounce::getState:
+ *
+ * Returns: the debounced state, LOW or HIGH.
+ *
+ * Public.
+ */
+uint8_t pwiDebounce::getState( void )
+{
+    return( this->state );
+}
+
+/**
+ * pwiDebounce::getStrategy:
+ *
+ * Returns: the debounce strategy.
+ *
+ * Public.
+ */
+uint8_t pwiDebounce::getStrategy( void )
+{
+    return( this->strategy );
+}
+
+/**
+ * pwiDebounce::accept:
+ * @now_us: the micros() timestamp of an edge.
+ *
+ * Apply the lockout delay to an edge which has been detected elsewhere,
+ * typically by an interrupt service routine: the edge is accepted if it
+ * happens after the lockout delay since the last accepted one.
+ *
+ * Returns: %TRUE if the edge is accepted.
+ *
+ * Public.
+ */
+bool pwiDebounce::accept( uint32_t now_us )
+{
+    if( !this->primed || pwiReached( this->last_us, this->lockout_us, now_us )){
+        this->primed = true;
+        this->last_us = now_us;
+        return( true );
+    }
+    return( false );
+}
+
+/**
+ * pwiDebounce::reset:
+ * @state: the current state of the input.
+ * @now_us: the current micros() timestamp.
+ *
+ * Reset the engine to a known stable @state.
+ *
+ * Public.
+ */
+void pwiDebounce::reset( uint8_t state, uint32_t now_us )
+{
+    this->state = state ? HIGH : LOW;
+    this->counter = ( this->strategy == PWI_DEBOUNCE_INTEGRATOR && this->state ) ? this->threshold : 0;
+    // so that a first change may be accepted immediately
+    this->primed = false;
+    this->last_us = now_us;
+}
+
+/**
+ * pwiDebounce::sample:
+ * @raw: the raw level of the input.
+ * @now_us: the micros() timestamp of the sample.
+ *
+ * Feed the engine with a new sample.
+ *
+ * Returns: %TRUE if the debounced state has changed.
+ *
+ * Public.
+ */
+bool pwiDebounce::sample( uint8_t raw, uint32_t now_us )
+{
+    raw = raw ? HIGH : LOW;
+
+    if( this->strategy == PWI_DEBOUNCE_LOCKOUT ){
+        if( raw == this->state ){
+            return( false );
+        }
+        // a change to the inactive level is accepted out of the lockout,
+        // but does not restart it
+        if( this->active != PWI_DEBOUNCE_ANY_LEVEL && raw != this->active ){
+            if( this->primed && !pwiReached( this->last_us, this->lockout_us, now_us )){
+                return( false );
+            }
+        } else if( !this->accept( now_us )){
+            return( false );
+        }
+        this->state = raw;
+        return( true );
+    }
+
+    if( this->sample_us ){
+        if( this->primed && !pwiReached( this->last_us, this->sample_us, now_us )){
+            return( false );
+        }
+        this->primed = true;
+        this->last_us = now_us;
+    }
+
+    if( this->strategy == PWI_DEBOUNCE_INTEGRATOR ){
+        if( raw ){
+            if( this->counter < this->threshold ){
+                this->counter += 1;
+            }
+        } else if( this->counter ){
+            this->counter -= 1;
+        }
+        if( this->state == LOW && this->counter == this->threshold ){
+            this->state = HIGH;
+            return( true );
+        }
+        if( this->state == HIGH && this->counter == 0 ){
+            this->state = LOW;
+            return( true );
+        }
+        return( false );
+    }
+
+    // PWI_DEBOUNCE_CONSECUTIVE
+    if( raw == this->state ){
+        this->counter = 0;
+        return( false );
+    }
+    this->counter += 1;
+    if( this->counter >= this->threshold ){
+        this->state = raw;
+        this->counter = 0;
+        return( true );
+    }
+    return( false );
+}
+
+/**
+ * pwiDebounce::setActiveLevel:
+ * @level: the level whose changes start the lockout, LOW or HIGH, or
+ *  PWI_DEBOUNCE_ANY_LEVEL (the default).
+ *
+ * With the lockout strategy, let only the changes to the @level (i.e. the
+ * counted edges of a pulse input) start the lockout delay: the changes back
+ * to the other level are accepted as soon as the lockout is over, without
+ * restarting it. The lockout so bounds the period of the pulses, rather than
+ * their width and their spacing, as accept() does in an interrupt service
+ * routine which only sees the active edges.
+ *
+ * Public.
+ */
+void pwiDebounce::setActiveLevel( uint8_t level )
+{
+    this->active = ( level == PWI_DEBOUNCE_ANY_LEVEL ) ? level : ( level ? HIGH : LOW );
+}
+
+/**
+ * pwiDebounce::setSamplePeriod:
+ * @period_us: the min period between two samples taken into account by the
+ *  integrator and consecutive strategies; zero to take all samples.
+ *
+ * Public.
+ */
+void pwiDebounce::setSamplePeriod( uint32_t period_us )
+{
+    this->sample_us = period_us;
+}
+
+/**
+ * pwiDebounce::setup:
+ * @strategy: the debounce strategy.
+ * @param: the lockout delay in us for the lockout strategy, or the count of
+ *  samples for the integrator and consecutive strategies (at most 255).
+ *
+ * Configure the engine. The current state is kept.
+ *
+ * Public.
+ */
+void pwiDebounce::setup( uint8_t strategy, uint32_t param )
+{
+    this->strategy = strategy;
+    if( strategy == PWI_DEBOUNCE_LOCKOUT ){
+        this->lockout_us = param;
+    } else {
+        this->threshold = param ? min( param, ( uint32_t ) 255 ) : 1;
+    }
+    this->counter = ( strategy == PWI_DEBOUNCE_INTEGRATOR && this->state ) ? this->threshold : 0;
+}
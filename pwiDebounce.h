@@ -0,0 +1,100 @@
+#ifndef __PWI_DEBOUNCE_H__
+#define __PWI_DEBOUNCE_H__
+
+/*
+ * A debounce engine for digital inputs.
+ *
+ * The engine is fed with raw samples of the input and their micros()
+ * timestamp, and maintains the debounced state according to one of the
+ * following strategies:
+ *
+ * - PWI_DEBOUNCE_LOCKOUT: a change is accepted immediately, then the input
+ *   is ignored during the lockout delay (in us); this is the cheapest, but
+ *   any glitch outside of the lockout window is taken as a change;
+ *   when an active level is set, only the changes to this level start the
+ *   lockout, as an interrupt service routine which only sees these edges
+ *   (see setActiveLevel());
+ *
+ * - PWI_DEBOUNCE_INTEGRATOR: an integrator is incremented for each high
+ *   sample and decremented for each low sample, saturating between zero and
+ *   the threshold; the state only changes when a bound is reached, so that
+ *   isolated glitches are absorbed wherever they happen;
+ *
+ * - PWI_DEBOUNCE_CONSECUTIVE: the state only changes after N consecutive
+ *   samples which differ from it.
+ *
+ * As the integrator and consecutive strategies count samples, a min sample
+ * period may be set so that the debounce time does not depend on the caller
+ * rate (see setSamplePeriod()).
+ *
+ * All time computations are made with wrap-safe unsigned arithmetic, so that
+ * the micros() rollover (about each 71 minutes) is harmless.
+ *
+ * Usage synopsys:
+ *
+ * a) define and configure the engine:
+ *    pwiDebounce myDebounce;
+ *    myDebounce.setup( PWI_DEBOUNCE_INTEGRATOR, 4 );
+ *    myDebounce.reset( digitalRead( pin ), micros());
+ *
+ * b) feed it from the main loop:
+ *    if( myDebounce.sample( digitalRead( pin ), micros())){
+ *        // the debounced state has changed
+ *    }
+ *
+ * pwi 2026-10-18 creation
+ *                new setActiveLevel() method
+ */
+
+#include <Arduino.h>
+
+enum {
+    PWI_DEBOUNCE_LOCKOUT = 0,
+    PWI_DEBOUNCE_INTEGRATOR,
+    PWI_DEBOUNCE_CONSECUTIVE
+};
+
+/* the changes to both levels start the lockout, see setActiveLevel()
+ */
+#define PWI_DEBOUNCE_ANY_LEVEL          0xff
+
+class pwiDebounce {
+    public:
+                                  pwiDebounce( void );
+
+		/* getters
+		 */
+                uint32_t          getLockout( void );
+                uint8_t           getState( void );
+                uint8_t           getStrategy( void );
+
+		/* actors
+		 */
+                bool              accept( uint32_t now_us );
+                void              reset( uint8_t state, uint32_t now_us );
+                bool              sample( uint8_t raw, uint32_t now_us );
+
+		/* setters
+		 */
+                void              setActiveLevel( uint8_t level );
+                void              setSamplePeriod( uint32_t period_us );
+                void              setup( uint8_t strategy, uint32_t param );
+
+    private:
+        /* setup
+         */
+                uint8_t           strategy;
+                uint8_t           threshold;        // integrator and consecutive strategies
+                uint8_t           active;           // lockout strategy: the level which starts the lockout
+                uint32_t          lockout_us;       // lockout strategy
+                uint32_t          sample_us;
+
+        /* runtime
+         */
+                uint8_t           state;
+                uint8_t           counter;
+                bool              primed;           // whether last_us is meaningful
+                uint32_t          last_us;          // start of the lockout, or last sample
+};
+
+#endif // __PWI_DEBOUNCE_H__
@@ -0,0 +1,170 @@
+/*
+ * pwi 2026-10-18 creation
+ *                debug traces are written to the pwiLog binary ring
+ */
+
+#include <EEPROM.h>
+#include "pwiEepromRing.h"
+#include "pwiLog.h"
+#include "pwiCrc.h"
+
+/* a slot of the ring: the crc is the last written byte, so that an
+ * interrupted write is detected
+ */
+typedef struct __attribute__(( packed )) {
+    uint16_t    seq;
+    uint32_t    value;
+    uint8_t     crc;
+}
+    pwiEepromSlot;
+
+// the sequence number of an erased slot
+#define SEQ_ERASED      0xffff
+
+/**
+ * pwiEepromRing::pwiEepromRing:
+ *
+ * Constructor.
+ *
+ * Public.
+ */
+pwiEepromRing::pwiEepromRing( void )
+{
+    /* setup
+     */
+    this->address = 0;
+    this->slots = 0;
+
+    /* runtime
+     */
+    this->next = 0;
+    this->seq = 0;
+    this->writes = 0;
+    this->restore_us = 0;
+}
+
+/**
+ * pwiEepromRing::getAddress:
+ *
+ * Returns: the EEPROM address of the ring.
+ *
+ * Public.
+ */
+uint16_t pwiEepromRing::getAddress( void )
+{
+    return( this->address );
+}
+
+/**
+ * pwiEepromRing::getRestoreDuration:
+ *
+ * Returns: the duration of the last restore() in us.
+ *
+ * Public.
+ */
+uint32_t pwiEepromRing::getRestoreDuration( void )
+{
+    return( this->restore_us );
+}
+
+/**
+ * pwiEepromRing::getSize:
+ *
+ * Returns: the size of the ring in EEPROM, in bytes.
+ *
+ * Public.
+ */
+uint16_t pwiEepromRing::getSize( void )
+{
+    return( this->slots * sizeof( pwiEepromSlot ));
+}
+
+/**
+ * pwiEepromRing::getWritesCount:
+ *
+ * Returns: the count of write() since startup.
+ *
+ * Public.
+ */
+uint32_t pwiEepromRing::getWritesCount( void )
+{
+    return( this->writes );
+}
+
+/**
+ * pwiEepromRing::restore:
+ * @value: [out]: the restored value.
+ *
+ * Scan the ring for the most recent valid slot. Subsequent writes will
+ * continue after it.
+ * The duration is bounded by the count of slots.
+ *
+ * Returns: %TRUE if a valid slot has been found, and @value set.
+ *
+ * Public.
+ */
+bool pwiEepromRing::restore( uint32_t &value )
+{
+    unsigned long start_us = micros();
+    bool found = false;
+    pwiEepromSlot slot;
+
+    for( uint8_t i=0 ; i<this->slots ; ++i ){
+        EEPROM.get( this->address + i*sizeof( pwiEepromSlot ), slot );
+        if( slot.seq == SEQ_ERASED || slot.crc != pwiCrc8( &slot, sizeof( slot )-1 )){
+            continue;
+        }
+        // serial number arithmetic, so that the sequence may wrap
+        if( !found || ( int16_t )( slot.seq - this->seq ) > 0 ){
+            found = true;
+            this->seq = slot.seq;
+            this->next = ( i+1 ) % this->slots;
+            value = slot.value;
+        }
+    }
+    this->restore_us = micros() - start_us;
+    PWI_LOG( EEPROM_RESTORE, found, this->seq, this->restore_us );
+    return( found );
+}
+
+/**
+ * pwiEepromRing::setup:
+ * @address: the EEPROM address of the ring.
+ * @slots: the count of slots.
+ *
+ * Configure the ring, which will occupy getSize() bytes in EEPROM.
+ *
+ * Public.
+ */
+void pwiEepromRing::setup( uint16_t address, uint8_t slots )
+{
+    this->address = address;
+    this->slots = slots;
+    this->next = 0;
+}
+
+/**
+ * pwiEepromRing::write:
+ * @value: the value to be saved.
+ *
+ * Save the @value in the next slot of the ring.
+ *
+ * Public.
+ */
+void pwiEepromRing::write( uint32_t value )
+{
+    if( !this->slots ){
+        return;
+    }
+    pwiEepromSlot slot;
+    this->seq += 1;
+    if( this->seq == SEQ_ERASED ){
+        this->seq += 1;
+    }
+    slot.seq = this->seq;
+    slot.value = value;
+    slot.crc = pwiCrc8( &slot, sizeof( slot )-1 );
+    EEPROM.put( this->address + this->next*sizeof( pwiEepromSlot ), slot );
+    this->next = ( this->next+1 ) % this->slots;
+    this->writes += 1;
+}
@@ -0,0 +1,75 @@
+#ifndef __PWI_EEPROM_RING_H__
+#define __PWI_EEPROM_RING_H__
+
+/*
+ * A wear-leveled persistent 32-bits value.
+ *
+ * Each write goes to the next slot of a ring of EEPROM slots, together with
+ * a sequence number and a crc. At startup, restore() scans the ring and
+ * returns the value of the most recent valid slot. A write which has been
+ * interrupted (e.g. by a brownout) is so just ignored, the previous value
+ * being restored.
+ *
+ * With N slots, each EEPROM cell is written N times less often than with a
+ * single location. As EEPROM.update() is used, unchanged bytes are not even
+ * written.
+ *
+ * Both the write count and the restore duration are measured, so that the
+ * ring can be sized against the expected lifetime and the boot time budget.
+ *
+ * Usage synopsys:
+ *
+ * a) define the ring:
+ *    pwiEepromRing myRing;
+ *
+ * b) configure it at startup (with MySensors, the user area starts at
+ *    EEPROM_LOCAL_CONFIG_ADDRESS):
+ *    myRing.setup( address, 16 );
+ *
+ * c) restore the last saved value:
+ *    uint32_t value;
+ *    if( myRing.restore( value )){ ... }
+ *
+ * d) save a new value:
+ *    myRing.write( value );
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <Arduino.h>
+
+class pwiEepromRing {
+    public:
+                                  pwiEepromRing( void );
+
+		/* getters
+		 */
+                uint16_t          getAddress( void );
+                uint32_t          getRestoreDuration( void );
+                uint16_t          getSize( void );
+                uint32_t          getWritesCount( void );
+
+		/* actors
+		 */
+                bool              restore( uint32_t &value );
+                void              write( uint32_t value );
+
+		/* setters
+		 */
+                void              setup( uint16_t address, uint8_t slots );
+
+    private:
+        /* setup
+         */
+                uint16_t          address;
+                uint8_t           slots;
+
+        /* runtime
+         */
+                uint8_t           next;             // index of the next slot to be written
+                uint16_t          seq;              // sequence number of the last written slot
+                uint32_t          writes;
+                uint32_t          restore_us;
+};
+
+#endif // __PWI_EEPROM_RING_H__
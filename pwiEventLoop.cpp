@@ -0,0 +1,247 @@
+/*
+ * pwi 2026-10-18 creation
+ */
+
+#include "pwiEventLoop.h"
+
+#ifdef __linux__
+
+#include "pwiTimer.h"
+#ifdef PWI_THREADS
+#include "pwiThreads.h"
+#endif
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// epoll data of the internal file descriptors
+#define TIMER_TAG               (( uint64_t ) -1 )
+#define WAKEUP_TAG              (( uint64_t ) -2 )
+
+int                                 pwiEventLoop::epoll_fd = -1;
+int                                 pwiEventLoop::timer_fd = -1;
+int                                 pwiEventLoop::wakeup_fd = -1;
+pwiEventLoop::pwiEventLoopSource    pwiEventLoop::sources[PWI_EVENT_LOOP_MAX_FDS];
+
+/**
+ * pwiEventLoop::AddFd:
+ * @fd: the file descriptor to watch.
+ * @events: the epoll events to watch, e.g. EPOLLIN.
+ * @cb: the callback to be called when the @fd is ready.
+ * @user_data: [allow-none]: the user data to be passed to the @cb.
+ *
+ * Returns: %TRUE if the @fd has been registered.
+ *
+ * Public Static.
+ */
+bool pwiEventLoop::AddFd( int fd, uint32_t events, pwiEventLoopCb cb, void *user_data )
+{
+    if( pwiEventLoop::epoll_fd < 0 || !cb ){
+        return( false );
+    }
+    for( uint8_t i=0 ; i<PWI_EVENT_LOOP_MAX_FDS ; ++i ){
+        if( !pwiEventLoop::sources[i].cb ){
+            struct epoll_event ev;
+            ev.events = events;
+            ev.data.u64 = i;
+            if( epoll_ctl( pwiEventLoop::epoll_fd, EPOLL_CTL_ADD, fd, &ev ) < 0 ){
+                return( false );
+            }
+            pwiEventLoop::sources[i].fd = fd;
+            pwiEventLoop::sources[i].cb = cb;
+            pwiEventLoop::sources[i].user_data = user_data;
+            return( true );
+        }
+    }
+    return( false );
+}
+
+/**
+ * pwiEventLoop::Close:
+ *
+ * Release the resources allocated by Setup().
+ *
+ * Public Static.
+ */
+void pwiEventLoop::Close( void )
+{
+#ifdef PWI_THREADS
+    pwiThreads::SetWakeup( NULL, NULL );
+#endif
+    int *fds[] = { &pwiEventLoop::wakeup_fd, &pwiEventLoop::timer_fd, &pwiEventLoop::epoll_fd };
+    for( uint8_t i=0 ; i<sizeof( fds )/sizeof( fds[0] ) ; ++i ){
+        if( *fds[i] >= 0 ){
+            close( *fds[i] );
+            *fds[i] = -1;
+        }
+    }
+    memset( pwiEventLoop::sources, '\0', sizeof( pwiEventLoop::sources ));
+}
+
+/**
+ * pwiEventLoop::Loop:
+ * @type: the type name of the timers to be addressed, see pwiTimer::Loop().
+ * @max_wait_ms: the max time to sleep, or -1 to only be woken up by an event.
+ *
+ * Sleep until the next timer is due, or a registered file descriptor is
+ * ready, or @max_wait_ms have elapsed; then run the callbacks of the ready
+ * file descriptors, and of the expired timers.
+ *
+ * Returns: the count of file descriptors callbacks which have been called,
+ * or -1 on error.
+ *
+ * Public Static.
+ */
+int pwiEventLoop::Loop( const char *type, int max_wait_ms )
+{
+    struct epoll_event events[PWI_EVENT_LOOP_MAX_FDS+2];
+    uint32_t remaining_ms;
+    int dispatched = 0;
+
+    if( pwiEventLoop::epoll_fd < 0 ){
+        return( -1 );
+    }
+    bool armed = pwiTimer::NextDeadline( remaining_ms, type );
+    pwiEventLoop::Arm( armed, remaining_ms );
+
+    int timeout = ( armed && !remaining_ms ) ? 0 : max_wait_ms;
+    int count = epoll_wait( pwiEventLoop::epoll_fd, events, sizeof( events )/sizeof( events[0] ), timeout );
+
+    for( int i=0 ; i<count ; ++i ){
+        uint64_t tag = events[i].data.u64;
+        if( tag == TIMER_TAG ){
+            pwiEventLoop::Drain( pwiEventLoop::timer_fd );
+        } else if( tag == WAKEUP_TAG ){
+            pwiEventLoop::Drain( pwiEventLoop::wakeup_fd );
+        } else if( tag < PWI_EVENT_LOOP_MAX_FDS && pwiEventLoop::sources[tag].cb ){
+            pwiEventLoopSource *source = &pwiEventLoop::sources[tag];
+            source->cb( source->fd, events[i].events, source->user_data );
+            dispatched += 1;
+        }
+    }
+    pwiTimer::Loop( type );
+
+    return( count < 0 ? -1 : dispatched );
+}
+
+/**
+ * pwiEventLoop::RemoveFd:
+ * @fd: a registered file descriptor.
+ *
+ * Returns: %TRUE if the @fd has been unregistered.
+ *
+ * Public Static.
+ */
+bool pwiEventLoop::RemoveFd( int fd )
+{
+    for( uint8_t i=0 ; i<PWI_EVENT_LOOP_MAX_FDS ; ++i ){
+        if( pwiEventLoop::sources[i].cb && pwiEventLoop::sources[i].fd == fd ){
+            epoll_ctl( pwiEventLoop::epoll_fd, EPOLL_CTL_DEL, fd, NULL );
+            pwiEventLoop::sources[i].cb = NULL;
+            return( true );
+        }
+    }
+    return( false );
+}
+
+/**
+ * pwiEventLoop::Setup:
+ *
+ * Allocate the epoll instance, the timerfd and the wakeup eventfd.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Public Static.
+ */
+bool pwiEventLoop::Setup( void )
+{
+    struct epoll_event ev;
+
+    if( pwiEventLoop::epoll_fd >= 0 ){
+        return( true );
+    }
+    pwiEventLoop::epoll_fd = epoll_create1( EPOLL_CLOEXEC );
+    pwiEventLoop::timer_fd = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+    pwiEventLoop::wakeup_fd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+    if( pwiEventLoop::epoll_fd < 0 || pwiEventLoop::timer_fd < 0 || pwiEventLoop::wakeup_fd < 0 ){
+        pwiEventLoop::Close();
+        return( false );
+    }
+    ev.events = EPOLLIN;
+    ev.data.u64 = TIMER_TAG;
+    epoll_ctl( pwiEventLoop::epoll_fd, EPOLL_CTL_ADD, pwiEventLoop::timer_fd, &ev );
+    ev.data.u64 = WAKEUP_TAG;
+    epoll_ctl( pwiEventLoop::epoll_fd, EPOLL_CTL_ADD, pwiEventLoop::wakeup_fd, &ev );
+#ifdef PWI_THREADS
+    pwiThreads::SetWakeup( pwiEventLoop::WakeupCb, NULL );
+#endif
+    return( true );
+}
+
+/**
+ * pwiEventLoop::Wakeup:
+ *
+ * Wake up the loop, e.g. after a timer has been started from another thread.
+ * This may be called from any thread.
+ *
+ * Public Static.
+ */
+void pwiEventLoop::Wakeup( void )
+{
+    uint64_t one = 1;
+    if( pwiEventLoop::wakeup_fd >= 0 ){
+        ( void ) write( pwiEventLoop::wakeup_fd, &one, sizeof( one ));
+    }
+}
+
+/*
+ * pwiEventLoop::Arm:
+ * @armed: whether there is a deadline.
+ * @remaining_ms: the delay until the deadline.
+ *
+ * Arm (or disarm) the timerfd as a one-shot timer.
+ *
+ * Private Static.
+ */
+void pwiEventLoop::Arm( bool armed, uint32_t remaining_ms )
+{
+    struct itimerspec its;
+    memset( &its, '\0', sizeof( its ));
+    if( armed ){
+        its.it_value.tv_sec = remaining_ms / 1000;
+        its.it_value.tv_nsec = ( long )( remaining_ms % 1000 ) * 1000000L;
+        // a zero it_value would disarm the timer
+        if( !remaining_ms ){
+            its.it_value.tv_nsec = 1;
+        }
+    }
+    timerfd_settime( pwiEventLoop::timer_fd, 0, &its, NULL );
+}
+
+/*
+ * pwiEventLoop::Drain:
+ * @fd: a timerfd or an eventfd.
+ *
+ * Read the counter of the @fd, so that it is no more readable.
+ *
+ * Private Static.
+ */
+void pwiEventLoop::Drain( int fd )
+{
+    uint64_t value;
+    ( void ) read( fd, &value, sizeof( value ));
+}
+
+/*
+ * pwiEventLoop::WakeupCb:
+ *
+ * pwiThreads wakeup callback.
+ *
+ * Private Static.
+ */
+void pwiEventLoop::WakeupCb( void *data )
+{
+    pwiEventLoop::Wakeup();
+}
+
+#endif // __linux__
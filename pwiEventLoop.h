@@ -0,0 +1,83 @@
+#ifndef __PWI_EVENT_LOOP_H__
+#define __PWI_EVENT_LOOP_H__
+
+/*
+ * A blocking main loop for the Linux hosts.
+ *
+ * Rather than busy-polling pwiTimer::Loop(), which burns a full core only to
+ * check the clock, Loop() arms a timerfd with the next deadline of the timer
+ * registry (see pwiTimer::NextDeadline()), then sleeps in epoll_wait() until
+ * either a timer is due, or one of the registered file descriptors (e.g. a
+ * radio or a socket) becomes ready. The expired timers are then run as by
+ * pwiTimer::Loop().
+ *
+ * When built with PWI_THREADS, the loop is also woken up when a job is
+ * posted to the radio thread, or when a worker has terminated a timer
+ * callback (see pwiThreads::SetWakeup()).
+ *
+ * The timerfd is based on CLOCK_MONOTONIC, and so expects the timers to be
+ * driven by a clock which runs at the same rate (the default millis() on
+ * Linux, or pwiMicrosClock).
+ *
+ * Usage synopsys:
+ *
+ * a) setup the loop, and register the file descriptors to watch:
+ *    pwiEventLoop::Setup();
+ *    pwiEventLoop::AddFd( fd, EPOLLIN, myReadCb, myData );
+ *
+ * b) run it:
+ *    while( true ){
+ *        pwiEventLoop::Loop();
+ *    }
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#ifdef __linux__
+
+#include <Arduino.h>
+#include <sys/epoll.h>
+
+/* the max count of registered file descriptors
+ */
+#ifndef PWI_EVENT_LOOP_MAX_FDS
+#define PWI_EVENT_LOOP_MAX_FDS          16
+#endif
+
+/* The prototype of the callback called when a registered file descriptor is
+ * ready; @events is the epoll events mask.
+ */
+typedef void ( *pwiEventLoopCb )( int fd, uint32_t events, void *user_data );
+
+class pwiEventLoop {
+    public:
+        /* static methods
+         */
+        static  bool              AddFd( int fd, uint32_t events, pwiEventLoopCb cb, void *user_data=NULL );
+        static  void              Close( void );
+        static  int               Loop( const char *type=NULL, int max_wait_ms=-1 );
+        static  bool              RemoveFd( int fd );
+        static  bool              Setup( void );
+        static  void              Wakeup( void );
+
+    private:
+        typedef struct {
+            int                   fd;
+            pwiEventLoopCb        cb;
+            void                 *user_data;
+        }
+            pwiEventLoopSource;
+
+        static  int               epoll_fd;
+        static  int               timer_fd;
+        static  int               wakeup_fd;
+        static  pwiEventLoopSource sources[PWI_EVENT_LOOP_MAX_FDS];
+
+        static  void              Arm( bool armed, uint32_t remaining_ms );
+        static  void              Drain( int fd );
+        static  void              WakeupCb( void *data );
+};
+
+#endif // __linux__
+
+#endif // __PWI_EVENT_LOOP_H__
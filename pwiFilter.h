@@ -0,0 +1,195 @@
+#ifndef __PWI_FILTER_H__
+#define __PWI_FILTER_H__
+
+/*
+ * Fixed-point signal filters, to be composed at compile time.
+ *
+ * All the filters are templates on the integer type T of the samples, and
+ * use an accumulator twice as wide (see pwiFilterWide), so that there is no
+ * float math, nor any overflow:
+ * - pwiEmaFilter<T, SHIFT>: an exponential moving average, whose alpha is
+ *   1/2^SHIFT;
+ * - pwiMedianFilter<T, N>: the median of the last N samples, N being odd;
+ * - pwiMovingAverage<T, N>: the mean of the last N samples, over a ring
+ *   buffer; a power of two N saves the division on unsigned types;
+ * - pwiRateLimiter<T, STEP>: the output moves by at most STEP per sample.
+ *
+ * Each filter provides:
+ *    T    filter( T sample );        // feed a sample, returns the output
+ *    void reset( void );             // forget the history
+ * and pwiFilterChain<T, F1, F2, ...> applies the filters in sequence.
+ *
+ * Usage synopsys:
+ *
+ *    pwiFilterChain<int16_t, pwiMedianFilter<int16_t, 5>, pwiEmaFilter<int16_t, 3> > myFilter;
+ *    int16_t value = myFilter.filter( analogRead( A0 ));
+ *
+ * or see pwiFilteredSensor to have the filters run by a pwiSensor.
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <Arduino.h>
+
+/* the accumulator type of a sample type
+ */
+template<typename T> struct pwiFilterWide;
+template<> struct pwiFilterWide<int8_t>   { typedef int16_t  type; };
+template<> struct pwiFilterWide<uint8_t>  { typedef uint16_t type; };
+template<> struct pwiFilterWide<int16_t>  { typedef int32_t  type; };
+template<> struct pwiFilterWide<uint16_t> { typedef uint32_t type; };
+template<> struct pwiFilterWide<int32_t>  { typedef int64_t  type; };
+template<> struct pwiFilterWide<uint32_t> { typedef uint64_t type; };
+
+/*
+ * pwiEmaFilter:
+ * an exponential moving average: out += ( in - out ) / 2^SHIFT
+ * The accumulator holds the output scaled by 2^SHIFT, so that the fractional
+ * part is not lost.
+ */
+template<typename T, uint8_t SHIFT>
+class pwiEmaFilter {
+    public:
+        typedef typename pwiFilterWide<T>::type W;
+
+                                  pwiEmaFilter( void ) : acc( 0 ), primed( false ) {}
+
+                T                 filter( T sample ){
+                                      if( !this->primed ){
+                                          this->acc = ( W ) sample * (( W ) 1 << SHIFT );
+                                          this->primed = true;
+                                      } else {
+                                          this->acc += ( W ) sample - ( this->acc >> SHIFT );
+                                      }
+                                      return(( T )( this->acc >> SHIFT ));
+                                  }
+                void              reset( void ){ this->primed = false; }
+
+    private:
+                W                 acc;
+                bool              primed;
+};
+
+/*
+ * pwiMedianFilter:
+ * the median of the last N samples (of the available ones while less than N
+ * samples have been fed).
+ */
+template<typename T, uint8_t N>
+class pwiMedianFilter {
+    static_assert( N % 2 == 1, "pwiMedianFilter: N must be odd" );
+
+    public:
+                                  pwiMedianFilter( void ) : head( 0 ), count( 0 ) {}
+
+                T                 filter( T sample ){
+                                      T sorted[N];
+                                      this->ring[this->head] = sample;
+                                      this->head = ( this->head+1 ) % N;
+                                      if( this->count < N ){
+                                          this->count += 1;
+                                      }
+                                      // insertion sort, which is the fastest for such small arrays
+                                      for( uint8_t i=0 ; i<this->count ; ++i ){
+                                          T v = this->ring[i];
+                                          uint8_t j = i;
+                                          for( ; j>0 && sorted[j-1]>v ; --j ){
+                                              sorted[j] = sorted[j-1];
+                                          }
+                                          sorted[j] = v;
+                                      }
+                                      return( sorted[this->count/2] );
+                                  }
+                void              reset( void ){ this->head = 0; this->count = 0; }
+
+    private:
+                T                 ring[N];
+                uint8_t           head;
+                uint8_t           count;
+};
+
+/*
+ * pwiMovingAverage:
+ * the mean of the last N samples (of the available ones while less than N
+ * samples have been fed).
+ */
+template<typename T, uint8_t N>
+class pwiMovingAverage {
+    public:
+        typedef typename pwiFilterWide<T>::type W;
+
+                                  pwiMovingAverage( void ) : sum( 0 ), head( 0 ), count( 0 ) {}
+
+                T                 filter( T sample ){
+                                      if( this->count < N ){
+                                          this->count += 1;
+                                      } else {
+                                          this->sum -= this->ring[this->head];
+                                      }
+                                      this->ring[this->head] = sample;
+                                      this->sum += sample;
+                                      this->head = ( this->head+1 ) % N;
+                                      return(( T )( this->count == N ? this->sum / N : this->sum / this->count ));
+                                  }
+                void              reset( void ){ this->sum = 0; this->head = 0; this->count = 0; }
+
+    private:
+                T                 ring[N];
+                W                 sum;
+                uint8_t           head;
+                uint8_t           count;
+};
+
+/*
+ * pwiRateLimiter:
+ * the output moves towards the input by at most STEP per sample.
+ */
+template<typename T, T STEP>
+class pwiRateLimiter {
+    public:
+                                  pwiRateLimiter( void ) : last( 0 ), primed( false ) {}
+
+                T                 filter( T sample ){
+                                      if( !this->primed ){
+                                          this->last = sample;
+                                          this->primed = true;
+                                      } else if( sample > this->last ){
+                                          this->last = ( sample - this->last > STEP ) ? ( T )( this->last + STEP ) : sample;
+                                      } else {
+                                          this->last = ( this->last - sample > STEP ) ? ( T )( this->last - STEP ) : sample;
+                                      }
+                                      return( this->last );
+                                  }
+                void              reset( void ){ this->primed = false; }
+
+    private:
+                T                 last;
+                bool              primed;
+};
+
+/*
+ * pwiFilterChain:
+ * apply the filters in sequence; an empty chain lets the samples unchanged.
+ */
+template<typename T, typename... F>
+class pwiFilterChain;
+
+template<typename T>
+class pwiFilterChain<T> {
+    public:
+                T                 filter( T sample ){ return( sample ); }
+                void              reset( void ){}
+};
+
+template<typename T, typename F, typename... R>
+class pwiFilterChain<T, F, R...> {
+    public:
+                T                 filter( T sample ){ return( this->tail.filter( this->head.filter( sample ))); }
+                void              reset( void ){ this->head.reset(); this->tail.reset(); }
+
+    private:
+                F                 head;
+                pwiFilterChain<T, R...> tail;
+};
+
+#endif // __PWI_FILTER_H__
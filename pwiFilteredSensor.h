@@ -0,0 +1,114 @@
+#ifndef __PWI_FILTERED_SENSOR_H__
+#define __PWI_FILTERED_SENSOR_H__
+
+/*
+ * A pwiSensor whose raw readings go through a pwiFilter chain before the
+ * change detection.
+ *
+ * The derived class only has to read the raw value (vRead()), and to send the
+ * filtered one (vSend(), using getValue()): vMeasure() is implemented here,
+ * feeding the raw value to the filter chain F, and reporting a change when
+ * the filtered value differs from the last sent one by at least the
+ * threshold, i.e. when |value - sent| >= threshold. The default threshold
+ * of zero reports any change, i.e. as soon as value != sent; an unchanged
+ * value is never reported (but by the max period heartbeat). As the filters,
+ * the sensor works on the integer types T of pwiFilterWide, the difference
+ * being computed in the wide type.
+ *
+ * The last sent value is saved in the warm-start snapshot (see pwiSnapshot).
+ *
+ * Usage synopsys:
+ *
+ * a) define the derived class:
+ *    class myLight : public pwiFilteredSensor<uint16_t, pwiFilterChain<uint16_t, pwiMedianFilter<uint16_t, 5> > > {
+ *        bool vRead( uint16_t &raw ){ raw = analogRead( A0 ); return true; }
+ *        void vSend(){ MyMessage msg( getId(), V_LIGHT_LEVEL ); sendMessage( msg.set( getValue())); }
+ *    };
+ *
+ * b) configure it:
+ *    mySensor.setThreshold( 4 );
+ *    mySensor.setTimers( min_period, max_period );
+ *
+ * pwi 2026-10-18 creation
+ *                a zero threshold reports any change, not every measure
+ *                the difference of signed values does not wrap
+ */
+
+#include "pwiSensor.h"
+#include "pwiFilter.h"
+
+template<typename T, typename F=pwiFilterChain<T> >
+class pwiFilteredSensor : public pwiSensor {
+    public:
+                                  pwiFilteredSensor( void ) : pwiSensor() { this->init(); }
+                                  pwiFilteredSensor( uint8_t id ) : pwiSensor( id ) { this->init(); }
+
+		/* getters
+		 */
+                F                &getFilter( void ){ return( this->chain ); }
+                T                 getThreshold( void ){ return( this->threshold ); }
+                T                 getValue( void ){ return( this->value ); }
+
+		/* setters
+		 * setThreshold(): the min change of the filtered value to be reported,
+		 * zero meaning any change
+		 */
+                void              setThreshold( T threshold ){ this->threshold = threshold; }
+
+	protected:
+		/* virtuals MUST be implemented by the derived class
+		 * vRead() returns %FALSE if the raw value could not be read
+		 */
+        virtual bool              vRead( T &raw ) = 0;
+
+        virtual bool              vMeasure(){
+                                      T raw;
+                                      if( !this->vRead( raw )){
+                                          return( false );
+                                      }
+                                      this->value = this->chain.filter( raw );
+                                      // computed in the wide type, so that a swing wider than half
+                                      // the range of a signed T does not wrap to a negative delta
+                                      typedef typename pwiFilterWide<T>::type W;
+                                      W delta = ( this->value > this->sent ) ? ( W ) this->value - ( W ) this->sent : ( W ) this->sent - ( W ) this->value;
+                                      bool changed = this->threshold ? delta >= ( W ) this->threshold : delta != 0;
+                                      if( this->has_sent && !changed ){
+                                          return( false );
+                                      }
+                                      this->sent = this->value;
+                                      this->has_sent = true;
+                                      return( true );
+                                  }
+
+        virtual void              vRestoreState( const uint8_t *buffer, uint8_t size ){
+                                      if( size == sizeof( T )){
+                                          memcpy( &this->sent, buffer, sizeof( T ));
+                                          this->value = this->sent;
+                                          this->has_sent = true;
+                                      }
+                                  }
+
+        virtual uint8_t           vSaveState( uint8_t *buffer, uint8_t size ){
+                                      if( !this->has_sent || size < sizeof( T )){
+                                          return( 0 );
+                                      }
+                                      memcpy( buffer, &this->sent, sizeof( T ));
+                                      return( sizeof( T ));
+                                  }
+
+    private:
+                F                 chain;
+                T                 threshold;
+                T                 value;                    // last filtered value
+                T                 sent;                     // last value reported as changed
+                bool              has_sent;
+
+                void              init( void ){
+                                      this->threshold = 0;
+                                      this->value = 0;
+                                      this->sent = 0;
+                                      this->has_sent = false;
+                                  }
+};
+
+#endif // __PWI_FILTERED_SENSOR_H__
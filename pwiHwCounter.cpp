@@ -0,0 +1,198 @@
+/*
+ * pwi 2026-10-18 creation
+ *                the Timer1 backend is opt-in (define PWI_HW_COUNTER)
+ */
+
+#include "pwiHwCounter.h"
+
+#if defined( PWI_HW_COUNTER ) && defined( __AVR__ ) && defined( TCNT1 ) && defined( TIMSK1 )
+#define HAVE_TIMER1
+#endif
+
+#ifdef HAVE_TIMER1
+// the counter which receives the Timer1 overflows
+static pwiHwCounter *st_timer1 = NULL;
+
+ISR( TIMER1_OVF_vect )
+{
+    if( st_timer1 ){
+        st_timer1->onOverflow();
+    }
+}
+#endif
+
+/**
+ * pwiHwCounter::pwiHwCounter:
+ *
+ * Constructor.
+ *
+ * Public.
+ */
+pwiHwCounter::pwiHwCounter( void )
+{
+    this->overflows = 0;
+}
+
+/**
+ * pwiHwCounter::getCount:
+ *
+ * Returns: the 32-bits count of edges since begin().
+ *
+ * An overflow which has happened but has not been serviced yet (because we
+ * are called with interrupts disabled, or the overflow happens while reading)
+ * is taken into account.
+ *
+ * Public.
+ */
+uint32_t pwiHwCounter::getCount( void )
+{
+    noInterrupts();
+    uint16_t overflows = this->overflows;
+    uint16_t reg = this->readRegister();
+    if( this->isOverflowPending() && reg < 0x8000 ){
+        overflows += 1;
+    }
+    interrupts();
+    return((( uint32_t ) overflows << 16 ) | reg );
+}
+
+/**
+ * pwiHwCounter::begin:
+ * @edge: the edge to be counted, FALLING or RISING.
+ *
+ * Reset the count, and start the hardware counter (see startCounter()).
+ *
+ * Returns: %TRUE if the counter has been started.
+ *
+ * Public.
+ */
+bool pwiHwCounter::begin( uint8_t edge )
+{
+    noInterrupts();
+    this->overflows = 0;
+    interrupts();
+    return( this->startCounter( edge ));
+}
+
+/**
+ * pwiHwCounter::end:
+ *
+ * Stop the hardware counter (see stopCounter()).
+ *
+ * Public.
+ */
+void pwiHwCounter::end( void )
+{
+    this->stopCounter();
+}
+
+/**
+ * pwiHwCounter::onOverflow:
+ *
+ * Account for an overflow of the hardware counter.
+ * This is expected to be called from the overflow interrupt service routine,
+ * or by a simulated counter.
+ *
+ * Public.
+ */
+void pwiHwCounter::onOverflow( void )
+{
+    this->overflows += 1;
+    this->clearOverflow();
+}
+
+/**
+ * pwiHwCounter::clearOverflow:
+ *
+ * Clear the pending overflow flag.
+ * On AVR, the flag is automatically cleared when the interrupt vector is
+ * executed.
+ *
+ * Protected.
+ */
+void pwiHwCounter::clearOverflow( void )
+{
+}
+
+/**
+ * pwiHwCounter::isOverflowPending:
+ *
+ * Returns: %TRUE if an overflow has happened, which has not been serviced yet.
+ *
+ * Protected.
+ */
+bool pwiHwCounter::isOverflowPending( void )
+{
+#ifdef HAVE_TIMER1
+    return( TIFR1 & _BV( TOV1 ));
+#else
+    return( false );
+#endif
+}
+
+/**
+ * pwiHwCounter::readRegister:
+ *
+ * Returns: the current value of the 16-bits hardware counter.
+ *
+ * Protected.
+ */
+uint16_t pwiHwCounter::readRegister( void )
+{
+#ifdef HAVE_TIMER1
+    return( TCNT1 );
+#else
+    return( 0 );
+#endif
+}
+
+/**
+ * pwiHwCounter::startCounter:
+ * @edge: the edge to be counted, FALLING or RISING.
+ *
+ * Configure the hardware counter to count the edges on its external input,
+ * from zero, with the overflow interrupt enabled.
+ *
+ * Returns: %TRUE if the counter has been started, %FALSE if there is no
+ * hardware.
+ *
+ * Protected.
+ */
+bool pwiHwCounter::startCounter( uint8_t edge )
+{
+#ifdef HAVE_TIMER1
+    noInterrupts();
+    st_timer1 = this;
+    TCCR1A = 0;
+    TCCR1B = 0;
+    TCNT1 = 0;
+    TIFR1 = _BV( TOV1 );
+    TIMSK1 = _BV( TOIE1 );
+    // external clock source on T1 pin
+    TCCR1B = ( edge == RISING ) ? ( _BV( CS12 ) | _BV( CS11 ) | _BV( CS10 )) : ( _BV( CS12 ) | _BV( CS11 ));
+    interrupts();
+    return( true );
+#else
+    return( false );
+#endif
+}
+
+/**
+ * pwiHwCounter::stopCounter:
+ *
+ * Stop the hardware counter and its overflow interrupt.
+ *
+ * Protected.
+ */
+void pwiHwCounter::stopCounter( void )
+{
+#ifdef HAVE_TIMER1
+    noInterrupts();
+    TCCR1B = 0;
+    TIMSK1 &= ~_BV( TOIE1 );
+    if( st_timer1 == this ){
+        st_timer1 = NULL;
+    }
+    interrupts();
+#endif
+}
@@ -0,0 +1,66 @@
+#ifndef __PWI_HW_COUNTER_H__
+#define __PWI_HW_COUNTER_H__
+
+/*
+ * A pulse counter backed by a MCU hardware timer/counter.
+ *
+ * Polling, and even per-edge interrupts, collapse above a few kHz. Instead,
+ * the timer/counter is clocked from the external pin and counts the edges by
+ * itself, without any CPU involvement. The 16-bits hardware count is extended
+ * to 32 bits in software by counting the overflows.
+ *
+ * On AVR, the Timer1 is used, clocked from its T1 input (pin D5 on an Arduino
+ * Uno or Nano, D47 on a Mega). This so conflicts with any other user of
+ * Timer1 (e.g. the TimerOne and Servo libraries, pwiBench, or PWM on pins 9
+ * and 10 on an Uno). As the Timer1 overflow interrupt vector is taken over
+ * by this backend, it is only compiled in when PWI_HW_COUNTER is defined.
+ *
+ * The hardware accessors are virtual, so that another counter may be used by
+ * a derived class, or simulated on the host. Without PWI_HW_COUNTER, or on
+ * other targets than AVR, the base class has no hardware and begin() fails.
+ *
+ * Usage synopsys:
+ *
+ * a) define the counter:
+ *    pwiHwCounter myCounter;
+ *
+ * b) use it as the backend of a pulse sensor wired to the T1 pin:
+ *    mySensor.setHardwareCounter( &myCounter );
+ *
+ * c) build with -DPWI_HW_COUNTER.
+ *
+ * pwi 2026-10-18 creation
+ *                the Timer1 backend is opt-in (define PWI_HW_COUNTER)
+ *                new startCounter(), stopCounter() hardware accessors
+ */
+
+#include <Arduino.h>
+
+class pwiHwCounter {
+    public:
+                                  pwiHwCounter( void );
+
+		/* getters
+		 */
+                uint32_t          getCount( void );
+
+		/* actors
+		 */
+                bool              begin( uint8_t edge );
+                void              end( void );
+                void              onOverflow( void );
+
+    protected:
+        /* hardware accessors
+         */
+        virtual void              clearOverflow( void );
+        virtual bool              isOverflowPending( void );
+        virtual uint16_t          readRegister( void );
+        virtual bool              startCounter( uint8_t edge );
+        virtual void              stopCounter( void );
+
+    private:
+                volatile uint16_t overflows;
+};
+
+#endif // __PWI_HW_COUNTER_H__
@@ -2,18 +2,33 @@
 
 /*
  * pwi 2019- 9- 5 creation
+ * pwi 2026-10-18 constexpr constructor (see pwiList.h)
+ *                iterative iter() and last()
+ *                lock-free readers when built with PWI_THREADS
+ *                plain accesses without PWI_THREADS
+ *                count the allocated nodes
  */
 
-/**
- * pwiList::pwiList:
- *
- * Constructor.
+#ifdef PWI_THREADS
+#include <pthread.h>
+// a single mutex serializes the writers of all lists
+static pthread_mutex_t st_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define LIST_LOCK()                 pthread_mutex_lock( &st_mutex )
+#define LIST_UNLOCK()               pthread_mutex_unlock( &st_mutex )
+/* as the list is append-only, a node is published by a single pointer store,
+ * after having been fully initialized: readers never need any lock
  */
-pwiList::pwiList( void )
-{
-    data = NULL;
-    next = NULL;
-}
+#define LIST_LOAD( p )              __atomic_load_n( &( p ), __ATOMIC_ACQUIRE )
+#define LIST_STORE( p, v )          __atomic_store_n( &( p ), ( v ), __ATOMIC_RELEASE )
+#else
+#define LIST_LOCK()
+#define LIST_UNLOCK()
+#define LIST_LOAD( p )              ( p )
+#define LIST_STORE( p, v )          ( p ) = ( v )
+#endif
+
+// count of the nodes allocated from the heap, for all lists
+uint16_t pwiList::nodes = 0;
 
 /**
  * pwiList::add:
@@ -25,16 +40,19 @@ pwiList::pwiList( void )
  */
 void pwiList::add( void *element )
 {
+    LIST_LOCK();
     // relevant items in the list are those which hold a non-null 'data' member.
     // taking this into account is needed because the list may be statically
     // allocated.
     if( !this->data ){
-        this->data = element;
+        LIST_STORE( this->data, element );
     } else {
-        pwiList *last = this->last();
-        last->next = new pwiList;
-        (( pwiList * ) last->next )->data = element;
+        pwiList *node = new pwiList;
+        node->data = element;
+        LIST_STORE( this->last()->next, ( void * ) node );
+        pwiList::nodes += 1;
     }
+    LIST_UNLOCK();
 }
 
 /**
@@ -45,16 +63,18 @@ void pwiList::add( void *element )
  * Calls the @cb callback function for each item which have a non-null 'data'
  *  member (which may be zero).
  *
+ * Elements added by the @cb are iterated in the same loop.
+ *
  * Public.
  */
 void pwiList::iter( pwiListIterCb cb, void* user_data )
 {
     if( cb ){
-        if( this->data ){
-            cb( this->data, user_data );
-        }
-        if( this->next ){
-            (( pwiList * ) this->next )->iter( cb, user_data );
+        for( pwiList *it=this ; it ; it=( pwiList * ) LIST_LOAD( it->next )){
+            void *data = LIST_LOAD( it->data );
+            if( data ){
+                cb( data, user_data );
+            }
         }
     }
 }
@@ -68,9 +88,23 @@ void pwiList::iter( pwiListIterCb cb, void* user_data )
  */
 pwiList *pwiList::last()
 {
-    if( !this->next ){
-        return( this );
+    pwiList *it = this;
+    while( it->next ){
+        it = ( pwiList * ) it->next;
     }
-    return((( pwiList * ) this->next )->last());
+    return( it );
 }
 
+/**
+ * pwiList::GetNodesCount:
+ *
+ * Returns: the count of nodes which have been allocated from the heap, for
+ * all the lists (the head of a list is not counted, as it is statically
+ * allocated by its owner).
+ *
+ * Public Static.
+ */
+uint16_t pwiList::GetNodesCount( void )
+{
+    return( pwiList::nodes );
+}
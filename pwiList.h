@@ -24,6 +24,9 @@
  *  it as simple as possible.
  *
  * pwi 2019- 9- 5 creation
+ * pwi 2026-10-18 constexpr constructor so that a statically allocated list is
+ *                initialized before any other static object may register into it
+ *                count the allocated nodes
  */
 
 /* The definition of the callback function to be provided on list iteration.
@@ -32,14 +35,18 @@ typedef void ( pwiListIterCb )( void *element, void *user_data );
 
 class pwiList {
     public:
-                 pwiList( void );
+       constexpr pwiList( void ) : data( NULL ), next( NULL ) {}
         void     add( void *element );
         void     iter( pwiListIterCb cb, void* user_data=NULL );
 
+        static uint16_t GetNodesCount( void );
+
     private:
         void    *data;
         void    *next;
 
+        static uint16_t nodes;
+
         pwiList *last();
 };
 
@@ -0,0 +1,279 @@
+/*
+ * pwi 2026-10-18 creation
+ *                runtime per-module filter
+ *                no ring buffer at PWI_LOG_NONE
+ *                the ring is protected by a mutex with PWI_THREADS
+ */
+
+#include "pwiLog.h"
+
+/* the format strings, in flash, indexed by site id
+ */
+#define PWI_LOG_SITE( id, module, level, format )   static const char st_format_##id[] PROGMEM = format;
+#include "pwiLogSites.h"
+#undef PWI_LOG_SITE
+
+static const char * const st_formats[] PROGMEM = {
+#define PWI_LOG_SITE( id, module, level, format )   st_format_##id,
+#include "pwiLogSites.h"
+#undef PWI_LOG_SITE
+};
+
+uint8_t  pwiLog::masks[PWI_LOG_TRACE+1] = {
+    PWI_LOG_MODULES_ALL, PWI_LOG_MODULES_ALL, PWI_LOG_MODULES_ALL,
+    PWI_LOG_MODULES_ALL, PWI_LOG_MODULES_ALL, PWI_LOG_MODULES_ALL
+};
+
+#if PWI_LOG_LEVEL > PWI_LOG_NONE
+uint8_t  pwiLog::ring[PWI_LOG_SIZE];
+#endif
+uint16_t pwiLog::head = 0;
+uint16_t pwiLog::tail = 0;
+uint16_t pwiLog::used = 0;
+uint16_t pwiLog::dropped = 0;
+
+static const char st_hexa[] = "0123456789abcdef";
+
+/* Push() may be called from an interrupt service routine, and so must not
+ * re-enable the interrupts on exit; with PWI_THREADS, the workers and the
+ * radio thread push to the same ring, which is then protected by a mutex
+ */
+#if defined( PWI_THREADS )
+#include <pthread.h>
+static pthread_mutex_t st_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define LOG_LOCK()                      pthread_mutex_lock( &st_mutex )
+#define LOG_UNLOCK()                    pthread_mutex_unlock( &st_mutex )
+#elif defined( __AVR__ )
+#define LOG_LOCK()                      uint8_t sreg = SREG; cli()
+#define LOG_UNLOCK()                    SREG = sreg
+#else
+#define LOG_LOCK()                      noInterrupts()
+#define LOG_UNLOCK()                    interrupts()
+#endif
+
+/**
+ * pwiLog::Clear:
+ *
+ * Empty the ring buffer.
+ *
+ * Public Static.
+ */
+void pwiLog::Clear( void )
+{
+    LOG_LOCK();
+    pwiLog::head = 0;
+    pwiLog::tail = 0;
+    pwiLog::used = 0;
+    pwiLog::dropped = 0;
+    LOG_UNLOCK();
+}
+
+/**
+ * pwiLog::Dump:
+ *
+ * Drain the ring buffer to the Serial, as hexadecimal text lines to be
+ * rendered by the host decoder:
+ *
+ *    !LOG <version> <pointer size> <dropped records count>
+ *    !L <record>
+ *    ...
+ *    !END
+ *
+ * Public Static.
+ */
+void pwiLog::Dump( void )
+{
+    uint8_t record[PWI_LOG_RECORD_MAX];
+    char line[3+2*PWI_LOG_RECORD_MAX+1];
+    uint8_t length;
+
+    LOG_LOCK();
+    uint16_t dropped = pwiLog::dropped;
+    pwiLog::dropped = 0;
+    LOG_UNLOCK();
+
+    Serial.print( F( "!LOG " ));
+    Serial.print( PWI_LOG_VERSION );
+    Serial.print( ' ' );
+    Serial.print(( unsigned ) sizeof( uintptr_t ));
+    Serial.print( ' ' );
+    Serial.println( dropped );
+
+    while(( length = pwiLog::Pop( record, sizeof( record ))) > 0 ){
+        char *p = line;
+        *p++ = '!';
+        *p++ = 'L';
+        *p++ = ' ';
+        for( uint8_t i=0 ; i<length ; ++i ){
+            *p++ = st_hexa[record[i] >> 4];
+            *p++ = st_hexa[record[i] & 0x0f];
+        }
+        *p = '\0';
+        Serial.println( line );
+    }
+    Serial.println( F( "!END" ));
+}
+
+/**
+ * pwiLog::GetDropped:
+ *
+ * Returns: the count of records dropped because the ring buffer was full,
+ * since the last Dump().
+ *
+ * Public Static.
+ */
+uint16_t pwiLog::GetDropped( void )
+{
+    LOG_LOCK();
+    uint16_t dropped = pwiLog::dropped;
+    LOG_UNLOCK();
+    return( dropped );
+}
+
+/**
+ * pwiLog::GetFormat:
+ * @site: the site id.
+ *
+ * Returns: the format string of the @site, as a PROGMEM pointer, or %NULL.
+ *
+ * Public Static.
+ */
+const char *pwiLog::GetFormat( uint8_t site )
+{
+    return( site < PWI_LOG_SITES_COUNT ? ( const char * ) pgm_read_ptr( &st_formats[site] ) : NULL );
+}
+
+/**
+ * pwiLog::Pop:
+ * @record: the destination buffer.
+ * @size: the size of the @record buffer.
+ *
+ * Extract the oldest record from the ring buffer.
+ *
+ * Returns: the length of the record, or zero if the ring is empty.
+ *
+ * Public Static.
+ */
+uint8_t pwiLog::Pop( uint8_t *record, uint8_t size )
+{
+    uint8_t length = 0;
+
+#if PWI_LOG_LEVEL > PWI_LOG_NONE
+    LOG_LOCK();
+    if( pwiLog::used ){
+        length = pwiLog::ring[pwiLog::tail];
+        for( uint8_t i=0 ; i<length ; ++i ){
+            if( i < size ){
+                record[i] = pwiLog::ring[pwiLog::tail];
+            }
+            pwiLog::tail = ( pwiLog::tail+1 ) % PWI_LOG_SIZE;
+        }
+        pwiLog::used -= length;
+    }
+    LOG_UNLOCK();
+#endif
+
+    return( min( length, size ));
+}
+
+/**
+ * pwiLog::SetLevel:
+ * @module: the module, or PWI_LOG_MODULES_COUNT to address all modules.
+ * @level: the greatest level to be logged for this @module; PWI_LOG_NONE to
+ *  disable the module.
+ *
+ * Filter the compiled-in sites at runtime. Whatever be the @level, the sites
+ * above the PWI_LOG_LEVEL build-time threshold are never logged.
+ *
+ * Public Static.
+ */
+void pwiLog::SetLevel( uint8_t module, uint8_t level )
+{
+    uint8_t bits = ( module < PWI_LOG_MODULES_COUNT ) ? ( 1U << module ) : PWI_LOG_MODULES_ALL;
+    for( uint8_t i=PWI_LOG_ERROR ; i<=PWI_LOG_TRACE ; ++i ){
+        if( i <= level ){
+            pwiLog::masks[i] |= bits;
+        } else {
+            pwiLog::masks[i] &= ~bits;
+        }
+    }
+}
+
+/*
+ * pwiLog::PackInteger:
+ * @record: the record being built.
+ * @length: [in-out]: the current length of the @record.
+ * @value: the value to be appended.
+ *
+ * Private Static.
+ */
+void pwiLog::PackInteger( uint8_t *record, uint8_t &length, uint32_t value )
+{
+    if( length+4 <= PWI_LOG_RECORD_MAX ){
+        for( uint8_t i=0 ; i<4 ; ++i ){
+            record[length++] = value & 0xff;
+            value >>= 8;
+        }
+    }
+}
+
+/*
+ * pwiLog::PackPointer:
+ * @record: the record being built.
+ * @length: [in-out]: the current length of the @record.
+ * @ptr: the pointer to be appended.
+ *
+ * Private Static.
+ */
+void pwiLog::PackPointer( uint8_t *record, uint8_t &length, const void *ptr )
+{
+    uintptr_t value = ( uintptr_t ) ptr;
+    if( length+sizeof( uintptr_t ) <= PWI_LOG_RECORD_MAX ){
+        for( uint8_t i=0 ; i<sizeof( uintptr_t ) ; ++i ){
+            record[length++] = value & 0xff;
+            value >>= 8;
+        }
+    }
+}
+
+/*
+ * pwiLog::Push:
+ * @site: the site id.
+ * @record: the record, whose arguments have been packed after the header.
+ * @length: the length of the @record.
+ *
+ * Fill the header and append the record to the ring buffer, dropping the
+ * oldest records as needed.
+ * There is no ring buffer when the build-time level is PWI_LOG_NONE: the
+ * record is then silently discarded (which never happens as all the sites
+ * are compiled out).
+ *
+ * Private Static.
+ */
+void pwiLog::Push( uint8_t site, uint8_t *record, uint8_t length )
+{
+#if PWI_LOG_LEVEL > PWI_LOG_NONE
+    uint32_t now = micros();
+
+    record[0] = length;
+    record[1] = site;
+    for( uint8_t i=0 ; i<4 ; ++i ){
+        record[2+i] = now & 0xff;
+        now >>= 8;
+    }
+
+    LOG_LOCK();
+    while( PWI_LOG_SIZE - pwiLog::used < length ){
+        uint8_t oldest = pwiLog::ring[pwiLog::tail];
+        pwiLog::tail = ( pwiLog::tail+oldest ) % PWI_LOG_SIZE;
+        pwiLog::used -= oldest;
+        pwiLog::dropped += 1;
+    }
+    for( uint8_t i=0 ; i<length ; ++i ){
+        pwiLog::ring[pwiLog::head] = record[i];
+        pwiLog::head = ( pwiLog::head+1 ) % PWI_LOG_SIZE;
+    }
+    pwiLog::used += length;
+    LOG_UNLOCK();
+#endif
+}
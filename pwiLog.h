@@ -0,0 +1,192 @@
+#ifndef __PWI_LOG_H__
+#define __PWI_LOG_H__
+
+/*
+ * A binary trace log.
+ *
+ * Rather than formatting text with many slow Serial.print() calls at the
+ * time of the event, each log site (see pwiLogSites.h) only writes a small
+ * binary record into a RAM ring buffer:
+ *
+ *    [length] [site id] [micros() timestamp, 4 bytes] [arguments]
+ *
+ * where the integer arguments are recorded as 32 bits, and the pointers with
+ * the pointer width of the target, all little-endian. When the ring is full,
+ * the oldest records are dropped.
+ *
+ * The format strings are not needed on the target, and the records are only
+ * rendered by the host decoder (see extras/host/logdecode.cpp) from the
+ * output of Dump(). Writing a record is interrupt-safe, and thread-safe with
+ * PWI_THREADS.
+ *
+ * Usage synopsys:
+ *
+ * a) add a site to pwiLogSites.h:
+ *    PWI_LOG_SITE( MY_SITE, "mySite value=%u, ptr=%p" )
+ *
+ * b) log the event:
+ *    PWI_LOG( MY_SITE, value, ptr );
+ *
+ * c) from time to time, or on request, dump the ring to the Serial:
+ *    pwiLog::Dump();
+ *
+ * Each site belongs to a module and has a level. The sites above the
+ * PWI_LOG_LEVEL build-time threshold are compiled out, and cost nothing (not
+ * even the evaluation of their arguments). The default threshold is
+ * PWI_LOG_NONE, so that nothing is logged (and no ring buffer is allocated)
+ * unless requested, e.g. with -DPWI_LOG_LEVEL=PWI_LOG_DEBUG.
+ *
+ * The compiled-in sites may then be filtered at runtime, per module and per
+ * level (see SetLevel()); a filtered site costs a single test of a constant
+ * bit in a constant address. By default, all the compiled-in sites are
+ * enabled.
+ *
+ * pwi 2026-10-18 creation
+ *                build-time level threshold and runtime per-module filter
+ *                the ring buffer is not allocated at PWI_LOG_NONE
+ *                thread-safe with PWI_THREADS
+ */
+
+#include <Arduino.h>
+
+/* the size of the ring buffer in bytes
+ */
+#ifndef PWI_LOG_SIZE
+#ifdef __AVR__
+#define PWI_LOG_SIZE                    128
+#else
+#define PWI_LOG_SIZE                    4096
+#endif
+#endif
+
+/* the max size of a record, header included: room for six arguments
+ */
+#ifdef __AVR__
+#define PWI_LOG_RECORD_MAX              32
+#else
+#define PWI_LOG_RECORD_MAX              64
+#endif
+#define PWI_LOG_HEADER                  6
+
+/* the version of the dump format, so that the decoder may check it
+ */
+#define PWI_LOG_VERSION                 1
+
+/* the levels, from the most to the least important
+ */
+#define PWI_LOG_NONE                    0
+#define PWI_LOG_ERROR                   1
+#define PWI_LOG_WARN                    2
+#define PWI_LOG_INFO                    3
+#define PWI_LOG_DEBUG                   4
+#define PWI_LOG_TRACE                   5
+
+/* the build-time threshold: the sites of a greater level are compiled out
+ */
+#ifndef PWI_LOG_LEVEL
+#define PWI_LOG_LEVEL                   PWI_LOG_NONE
+#endif
+
+/* the modules, i.e. the runtime categories (at most 8)
+ */
+enum {
+    PWI_LOG_MODULE_TIMER = 0,
+    PWI_LOG_MODULE_SENSOR,
+    PWI_LOG_MODULE_PULSE,
+    PWI_LOG_MODULE_QUEUE,
+    PWI_LOG_MODULE_EEPROM,
+    PWI_LOG_MODULE_PORT,
+    PWI_LOG_MODULE_APP,                         // free for the sketch
+    PWI_LOG_MODULES_COUNT
+};
+
+#define PWI_LOG_MODULES_ALL             (( 1U << PWI_LOG_MODULES_COUNT )-1 )
+
+/* the ids of the log sites
+ */
+enum {
+#define PWI_LOG_SITE( id, module, level, format )   PWI_LOG_ID_##id,
+#include "pwiLogSites.h"
+#undef PWI_LOG_SITE
+    PWI_LOG_SITES_COUNT
+};
+
+/* the module and the level of each site, as compile-time constants
+ */
+#define PWI_LOG_SITE( id, module, level, format ) \
+    enum { PWI_LOG_SITE_MODULE_##id = PWI_LOG_MODULE_##module, PWI_LOG_SITE_LEVEL_##id = level };
+#include "pwiLogSites.h"
+#undef PWI_LOG_SITE
+
+#define PWI_LOG( site, ... ) \
+    do { \
+        if( PWI_LOG_SITE_LEVEL_##site <= PWI_LOG_LEVEL \
+                && pwiLog::IsEnabled( PWI_LOG_SITE_MODULE_##site, PWI_LOG_SITE_LEVEL_##site )){ \
+            pwiLog::Write( PWI_LOG_ID_##site, ##__VA_ARGS__ ); \
+        } \
+    } while( 0 )
+
+class pwiLog {
+    public:
+        /* static methods
+         */
+        static  void              Clear( void );
+        static  void              Dump( void );
+        static  uint16_t          GetDropped( void );
+        static  const char       *GetFormat( uint8_t site );
+        static  uint8_t           Pop( uint8_t *record, uint8_t size );
+        static  void              SetLevel( uint8_t module, uint8_t level );
+
+        static  inline bool       IsEnabled( uint8_t module, uint8_t level )
+        {
+            return( pwiLog::masks[level] & ( 1U << module ));
+        }
+
+        template<typename... Args>
+        static  void              Write( uint8_t site, Args... args )
+        {
+            uint8_t record[PWI_LOG_RECORD_MAX];
+            uint8_t length = PWI_LOG_HEADER;
+            Pack( record, length, args... );
+            Push( site, record, length );
+        }
+
+    private:
+        // the enabled modules, indexed by level
+        static  uint8_t           masks[PWI_LOG_TRACE+1];
+
+#if PWI_LOG_LEVEL > PWI_LOG_NONE
+        static  uint8_t           ring[PWI_LOG_SIZE];
+#endif
+        static  uint16_t          head;                     // index of the next byte to be written
+        static  uint16_t          tail;                     // index of the oldest record
+        static  uint16_t          used;
+        static  uint16_t          dropped;
+
+        static  void              PackInteger( uint8_t *record, uint8_t &length, uint32_t value );
+        static  void              PackPointer( uint8_t *record, uint8_t &length, const void *ptr );
+        static  void              Push( uint8_t site, uint8_t *record, uint8_t length );
+
+        static  void              Pack( uint8_t *record, uint8_t &length ) {}
+
+        template<typename T, typename... Args>
+        static  void              Pack( uint8_t *record, uint8_t &length, T value, Args... args )
+        {
+            PackOne( record, length, value );
+            Pack( record, length, args... );
+        }
+
+        template<typename T>
+        static  void              PackOne( uint8_t *record, uint8_t &length, T *ptr )
+        {
+            PackPointer( record, length, ( const void * ) ptr );
+        }
+
+        template<typename T>
+        static  void              PackOne( uint8_t *record, uint8_t &length, T value )
+        {
+            PackInteger( record, length, ( uint32_t ) value );
+        }
+};
+
+#endif // __PWI_LOG_H__
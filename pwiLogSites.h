@@ -0,0 +1,62 @@
+/*
+ * The log sites of the pwiCommon library.
+ *
+ * Each site is identified by a compile-time id, and associated with:
+ * - the module it belongs to (see PWI_LOG_MODULE_xxx in pwiLog.h),
+ * - its level (see PWI_LOG_xxx levels in pwiLog.h),
+ * - the format string used by the decoder to render its records.
+ *
+ * This file is included several times with different definitions of
+ * PWI_LOG_SITE(), and so has no include guard.
+ *
+ * The format strings only accept the following conversions, which must
+ * match the arguments given to PWI_LOG():
+ * - %u, %d, %x: an integer, recorded as 32 bits ('l' modifiers are ignored);
+ * - %p: a pointer, recorded with the pointer width of the target.
+ *
+ * New sites must be added at the end of the list, so that the ids of the
+ * existing ones do not change.
+ *
+ * pwi 2026-10-18 creation
+ *                add module and level
+ */
+
+/* pwiTimer
+ */
+PWI_LOG_SITE( TIMER_REMAINING,      TIMER,  PWI_LOG_TRACE,  "pwiTimer::getRemaining() this=%p, delay_ms=%lu, start_ms=%lu, now=%lu, duration=%lu, remaining=%lu" )
+PWI_LOG_SITE( TIMER_SETUP,          TIMER,  PWI_LOG_DEBUG,  "pwiTimer::setup() this=%p, delay_ms=%lu, once=%u, cb=%p, user_data=%p" )
+PWI_LOG_SITE( TIMER_START_UNSET,    TIMER,  PWI_LOG_WARN,   "pwiTimer::start() this=%p: unable to start the timer while delay is not set" )
+PWI_LOG_SITE( TIMER_LOOP_IDLE,      TIMER,  PWI_LOG_TRACE,  "pwiTimer::loop() this=%p, delay_ms=%lu not started" )
+PWI_LOG_SITE( TIMER_LOOP_WAIT,      TIMER,  PWI_LOG_TRACE,  "pwiTimer::loop() this=%p, delay_ms=%lu, start_ms=%lu, duration=%lu not yet reached" )
+PWI_LOG_SITE( TIMER_LOOP_FIRE,      TIMER,  PWI_LOG_DEBUG,  "pwiTimer::loop() this=%p, delay_ms=%lu, start_ms=%lu, duration=%lu triggered" )
+
+/* pwiSensor
+ */
+PWI_LOG_SITE( SENSOR_MAX_PERIOD,    SENSOR, PWI_LOG_DEBUG,  "pwiSensor::OnMaxPeriodCb() id=%u" )
+PWI_LOG_SITE( SENSOR_MIN_PERIOD,    SENSOR, PWI_LOG_DEBUG,  "pwiSensor::OnMinPeriodCb() id=%u" )
+
+/* pwiPulseSensor
+ */
+PWI_LOG_SITE( PULSE_CHECKPOINT,     PULSE,  PWI_LOG_INFO,   "pwiPulseSensor::checkpoint() id=%u, count=%lu" )
+PWI_LOG_SITE( PULSE_EDGE,           PULSE,  PWI_LOG_TRACE,  "pwiPulseSensor::loopInput() id=%u, edge detected count=%lu" )
+PWI_LOG_SITE( PULSE_TRIGGER,        PULSE,  PWI_LOG_DEBUG,  "pwiPulseSensor::loopTrigger() id=%u, count=%lu" )
+
+/* pwiSendQueue
+ */
+PWI_LOG_SITE( QUEUE_FLUSH,          QUEUE,  PWI_LOG_DEBUG,  "pwiSendQueue::flush() this=%p, sent=%u, remaining=%u" )
+
+/* pwiEepromRing
+ */
+PWI_LOG_SITE( EEPROM_RESTORE,       EEPROM, PWI_LOG_INFO,   "pwiEepromRing::restore() found=%u, seq=%u, duration_us=%lu" )
+
+/* pwiPortPulseCounter
+ */
+PWI_LOG_SITE( PORT_ADD_CHANNEL,     PORT,   PWI_LOG_DEBUG,  "pwiPortPulseCounter::addChannel() pin=%u, port=%u, bit=%u" )
+
+/* pwiTimer (continued)
+ */
+PWI_LOG_SITE( TIMER_DUMP,           TIMER,  PWI_LOG_INFO,   "pwiTimer::dump() this=%p, delay_ms=%lu, once=%u, start_ms=%lu" )
+
+/* pwiSensor (continued)
+ */
+PWI_LOG_SITE( SENSOR_SHED,          SENSOR, PWI_LOG_WARN,   "pwiSensor::OnShedPeriodCb() level=%u, load=%u%%" )
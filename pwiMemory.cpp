@@ -0,0 +1,250 @@
+/*
+ * pwi 2026-10-18 creation
+ *                the stack is painted by inline assembly
+ *                the sensors no longer hold label buffers
+ */
+
+#include "pwiMemory.h"
+#include "pwiSensor.h"
+
+#ifdef __AVR__
+// avr-libc malloc() internals
+struct __freelist {
+    size_t sz;
+    struct __freelist *nx;
+};
+extern struct __freelist *__flp;
+extern char *__brkval;
+extern char __heap_start;
+extern uint8_t _end;
+extern uint8_t __stack;
+
+// the size of the header of an allocated block
+#define MALLOC_OVERHEAD             sizeof( size_t )
+
+/*
+ * pwiMemoryPaint:
+ *
+ * Paint the RAM between the end of the static data and the top of the stack
+ * with the canary. This runs from the .init3 section, i.e. before the static
+ * constructors, while the stack is still empty.
+ *
+ * A naked function has neither prologue nor epilogue, so that its body must
+ * only be inline assembly: it falls through to the next .init section.
+ */
+void pwiMemoryPaint( void ) __attribute__(( naked, used, section( ".init3" )));
+
+void pwiMemoryPaint( void )
+{
+    __asm__ __volatile__(
+        "    ldi r30, lo8(_end)          \n"
+        "    ldi r31, hi8(_end)          \n"
+        "    ldi r24, %[canary]          \n"
+        "    ldi r25, hi8(__stack+1)     \n"
+        "    rjmp 2f                     \n"
+        "1:  st Z+, r24                  \n"
+        "2:  cpi r30, lo8(__stack+1)     \n"
+        "    cpc r31, r25                \n"
+        "    brne 1b                     \n"
+        :
+        : [canary] "M" ( PWI_MEMORY_CANARY )
+        : "r24", "r25", "r30", "r31", "memory" );
+}
+#else
+#include <malloc.h>
+#define MALLOC_OVERHEAD             ( 2*sizeof( size_t ))
+#endif
+
+// TimerCb() helper: whether a previous timer has the same label
+typedef struct {
+    pwiTimer   *timer;
+    const char *label;
+    bool        found;
+}
+    sMemoryLabel;
+
+/**
+ * pwiMemory::Dump:
+ *
+ * Print the memory statistics to the Serial.
+ *
+ * Public Static.
+ */
+void pwiMemory::Dump( void )
+{
+    pwiMemoryStats stats;
+    pwiMemory::Stats( stats );
+
+    Serial.print( F( "[pwiMemory::Dump] library=" ));
+    Serial.print( stats.library_bytes );
+    Serial.print( F( " list=" ));
+    Serial.print( stats.list_nodes );
+    Serial.print( '/' );
+    Serial.print( stats.list_bytes );
+    Serial.print( F( " timers=" ));
+    Serial.print( stats.timers );
+    Serial.print( '/' );
+    Serial.print( stats.timer_bytes );
+    Serial.print( F( " sensors=" ));
+    Serial.print( stats.sensors );
+    Serial.print( '/' );
+    Serial.print( stats.sensor_bytes );
+    Serial.print( F( " labels=" ));
+    Serial.println( stats.label_bytes );
+
+    Serial.print( F( "[pwiMemory::Dump] heap=" ));
+    Serial.print(( unsigned long ) stats.heap_bytes );
+    Serial.print( F( " free=" ));
+    Serial.print(( unsigned long ) stats.heap_free_bytes );
+    Serial.print( '/' );
+    Serial.print( stats.heap_free_blocks );
+    Serial.print( F( " largest=" ));
+    Serial.print(( unsigned long ) stats.heap_largest_free );
+    Serial.print( F( " fragmentation=" ));
+    Serial.print( pwiMemory::GetFragmentation( stats ));
+    Serial.print( '%' );
+#ifdef __AVR__
+    Serial.print( F( " stack_max=" ));
+    Serial.print( stats.stack_max );
+    Serial.print( F( " stack_free=" ));
+    Serial.print( stats.stack_free );
+#endif
+    Serial.println();
+}
+
+/**
+ * pwiMemory::GetFragmentation:
+ * @stats: the memory statistics.
+ *
+ * Returns: the fragmentation of the free heap as a percentage: zero when
+ * all the free bytes are in one block, near 100 when they are scattered in
+ * many small blocks.
+ *
+ * Public Static.
+ */
+uint8_t pwiMemory::GetFragmentation( const pwiMemoryStats &stats )
+{
+    if( !stats.heap_free_bytes ){
+        return( 0 );
+    }
+    return( 100 - ( uint8_t )(( uint64_t ) stats.heap_largest_free * 100 / stats.heap_free_bytes ));
+}
+
+/**
+ * pwiMemory::Stats:
+ * @stats: [out]: the memory statistics.
+ *
+ * Compute the memory statistics.
+ *
+ * Public Static.
+ */
+void pwiMemory::Stats( pwiMemoryStats &stats )
+{
+    memset( &stats, '\0', sizeof( stats ));
+
+    stats.list_nodes = pwiList::GetNodesCount();
+    stats.list_bytes = stats.list_nodes * ( sizeof( pwiList ) + MALLOC_OVERHEAD );
+    pwiTimer::list.iter(( pwiListIterCb * ) pwiMemory::TimerCb, &stats );
+    pwiSensor::list.iter(( pwiListIterCb * ) pwiMemory::SensorCb, &stats );
+    stats.library_bytes = stats.list_bytes + stats.timer_bytes + stats.sensor_bytes + stats.label_bytes;
+
+#ifdef __AVR__
+    char *heap_end = __brkval ? __brkval : &__heap_start;
+    stats.heap_bytes = heap_end - &__heap_start;
+    for( struct __freelist *fp=__flp ; fp ; fp=fp->nx ){
+        stats.heap_free_bytes += fp->sz;
+        stats.heap_free_blocks += 1;
+        if( fp->sz > stats.heap_largest_free ){
+            stats.heap_largest_free = fp->sz;
+        }
+    }
+    // the painted area starts at the end of the heap (at least _end)
+    uint8_t *p = ( uint8_t * ) heap_end;
+    if( p < &_end ){
+        p = &_end;
+    }
+    // stop at the current stack pointer, which is always in use
+    uint8_t *sp = ( uint8_t * ) SP;
+    while( p < sp && *p == PWI_MEMORY_CANARY ){
+        p += 1;
+        stats.stack_free += 1;
+    }
+    stats.stack_max = &__stack - p + 1;
+#elif defined( __GLIBC__ ) && ( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 33 ))
+    struct mallinfo2 mi = mallinfo2();
+    stats.heap_bytes = mi.arena;
+    stats.heap_free_bytes = mi.fordblks;
+    stats.heap_free_blocks = mi.ordblks;
+    // glibc does not expose the largest free block: the top chunk is the
+    // one which can grow
+    stats.heap_largest_free = mi.keepcost;
+#elif defined( __linux__ )
+    struct mallinfo mi = mallinfo();
+    stats.heap_bytes = mi.arena;
+    stats.heap_free_bytes = mi.fordblks;
+    stats.heap_free_blocks = mi.ordblks;
+    stats.heap_largest_free = mi.keepcost;
+#endif
+}
+
+/*
+ * pwiMemory::LabelCb:
+ * @timer: a registered pwiTimer.
+ * @user_data: a pointer to a sMemoryLabel structure.
+ *
+ * pwiList::iter() callback function: whether a timer which precedes the
+ * searched one has the same label, in which case the label has already been
+ * accounted.
+ *
+ * Private Static.
+ */
+void pwiMemory::LabelCb( pwiTimer *timer, void *user_data )
+{
+    sMemoryLabel *search = ( sMemoryLabel * ) user_data;
+    if( search->timer ){
+        if( timer == search->timer ){
+            search->timer = NULL;
+        } else if( timer->label == search->label ){
+            search->found = true;
+            search->timer = NULL;
+        }
+    }
+}
+
+/*
+ * pwiMemory::SensorCb:
+ * @sensor: a registered pwiSensor.
+ * @stats: the statistics being computed.
+ *
+ * pwiList::iter() callback function.
+ *
+ * Private Static.
+ */
+void pwiMemory::SensorCb( pwiSensor *sensor, pwiMemoryStats *stats )
+{
+    stats->sensors += 1;
+    // the min and max timers are already accounted as timers
+    stats->sensor_bytes += sizeof( pwiSensor ) - 2*sizeof( pwiTimer );
+}
+
+/*
+ * pwiMemory::TimerCb:
+ * @timer: a registered pwiTimer.
+ * @stats: the statistics being computed.
+ *
+ * pwiList::iter() callback function.
+ *
+ * Private Static.
+ */
+void pwiMemory::TimerCb( pwiTimer *timer, pwiMemoryStats *stats )
+{
+    stats->timers += 1;
+    stats->timer_bytes += sizeof( pwiTimer );
+    if( timer->label ){
+        sMemoryLabel search = { timer, timer->label, false };
+        pwiTimer::list.iter(( pwiListIterCb * ) pwiMemory::LabelCb, &search );
+        if( !search.found ){
+            stats->label_bytes += strlen( timer->label ) + 1;
+        }
+    }
+}
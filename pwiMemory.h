@@ -0,0 +1,69 @@
+#ifndef __PWI_MEMORY_H__
+#define __PWI_MEMORY_H__
+
+/*
+ * RAM and stack footprint accounting.
+ *
+ * Stats() reports:
+ * - the bytes held by the library registries: the pwiList nodes allocated
+ *   from the heap, the pwiTimer and pwiSensor instances, and the labels of
+ *   the timers (each distinct label being counted once);
+ * - on AVR, the stack high-water mark: the RAM between the heap and the
+ *   stack is painted with a canary at startup (before the constructors
+ *   run), and the never-overwritten bytes are counted back;
+ * - the heap usage and fragmentation: on AVR, by walking the free list of
+ *   the avr-libc malloc(); on Linux, through mallinfo().
+ *
+ * The pwiSensor instances are accounted at the size of the base class,
+ * which is a lower bound of the size of the derived classes.
+ *
+ * Usage synopsys:
+ *
+ *    pwiMemoryStats stats;
+ *    pwiMemory::Stats( stats );
+ *    or:
+ *    pwiMemory::Dump();
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <Arduino.h>
+
+/* the stack painting pattern
+ */
+#define PWI_MEMORY_CANARY               0xc5
+
+typedef struct {
+    uint16_t    list_nodes;                     // count of pwiList nodes allocated from the heap
+    uint16_t    list_bytes;                     // including the malloc() overhead
+    uint16_t    timers;                         // count of pwiTimer instances
+    uint16_t    timer_bytes;
+    uint16_t    sensors;                        // count of pwiSensor instances
+    uint16_t    sensor_bytes;                   // excluding their pwiTimer members
+    uint16_t    label_bytes;                    // distinct timer labels
+    uint16_t    library_bytes;                  // total of the above
+    uint32_t    heap_bytes;                     // allocated from the heap, free blocks included
+    uint32_t    heap_free_bytes;                // in the free blocks of the heap
+    uint16_t    heap_free_blocks;
+    uint32_t    heap_largest_free;              // largest free block
+    uint16_t    stack_max;                      // stack high-water mark (AVR only)
+    uint16_t    stack_free;                     // never used bytes between the heap and the stack (AVR only)
+}
+    pwiMemoryStats;
+
+class pwiTimer;
+class pwiSensor;
+
+class pwiMemory {
+    public:
+        static  void              Dump( void );
+        static  uint8_t           GetFragmentation( const pwiMemoryStats &stats );
+        static  void              Stats( pwiMemoryStats &stats );
+
+    private:
+        static  void              LabelCb( pwiTimer *timer, void *user_data );
+        static  void              SensorCb( pwiSensor *sensor, pwiMemoryStats *stats );
+        static  void              TimerCb( pwiTimer *timer, pwiMemoryStats *stats );
+};
+
+#endif // __PWI_MEMORY_H__
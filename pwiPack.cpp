@@ -0,0 +1,472 @@
+/*
+ * pwi 2026-10-18 creation
+ *                an acknowledged base which became too old is forgotten
+ */
+
+#include "pwiPack.h"
+
+// single linked list of allocated pwiPackChannel's
+pwiList pwiPackChannel::list;
+
+// sequence number of the next frame
+uint8_t pwiPack::next_seq = 0;
+
+/**
+ * pwiVarintGet:
+ * @buffer: the encoded bytes.
+ * @size: the count of available bytes.
+ * @value: [out]: the decoded value.
+ *
+ * Returns: the count of consumed bytes, or zero if the varint is truncated.
+ */
+uint8_t pwiVarintGet( const uint8_t *buffer, uint8_t size, uint32_t &value )
+{
+    value = 0;
+    for( uint8_t i=0 ; i<size && i<5 ; ++i ){
+        value |= ( uint32_t )( buffer[i] & 0x7f ) << ( 7*i );
+        if( !( buffer[i] & 0x80 )){
+            return( i+1 );
+        }
+    }
+    return( 0 );
+}
+
+/**
+ * pwiVarintPut:
+ * @buffer: the buffer to be filled.
+ * @size: the count of available bytes.
+ * @value: the value to be encoded.
+ *
+ * Returns: the count of written bytes, or zero if the @buffer is too small.
+ */
+uint8_t pwiVarintPut( uint8_t *buffer, uint8_t size, uint32_t value )
+{
+    uint8_t needed = pwiVarintSize( value );
+    if( needed > size ){
+        return( 0 );
+    }
+    for( uint8_t i=0 ; i<needed-1 ; ++i ){
+        buffer[i] = ( value & 0x7f ) | 0x80;
+        value >>= 7;
+    }
+    buffer[needed-1] = value;
+    return( needed );
+}
+
+/**
+ * pwiVarintSize:
+ * @value: a value.
+ *
+ * Returns: the count of bytes needed to encode the @value.
+ */
+uint8_t pwiVarintSize( uint32_t value )
+{
+    uint8_t size = 1;
+    while( value >= 0x80 ){
+        value >>= 7;
+        size += 1;
+    }
+    return( size );
+}
+
+/**
+ * pwiPackChannel::pwiPackChannel:
+ * @channel: the channel number, in [0..PWI_PACK_CHANNELS-1].
+ *
+ * Constructor.
+ *
+ * Public.
+ */
+pwiPackChannel::pwiPackChannel( uint8_t channel )
+{
+    this->channel = channel % PWI_PACK_CHANNELS;
+    this->acked = false;
+    this->acked_seq = 0;
+    this->acked_value = 0;
+    this->sent_head = 0;
+    this->sent_count = 0;
+
+    pwiPackChannel::list.add( this );
+}
+
+/**
+ * pwiPackChannel::getChannel:
+ *
+ * Returns: the channel number.
+ *
+ * Public.
+ */
+uint8_t pwiPackChannel::getChannel( void )
+{
+    return( this->channel );
+}
+
+/**
+ * pwiPackChannel::isAcked:
+ *
+ * Returns: %TRUE if a value of the channel has been acknowledged, so that
+ * the next ones may be sent as deltas.
+ *
+ * Public.
+ */
+bool pwiPackChannel::isAcked( void )
+{
+    return( this->acked );
+}
+
+/**
+ * pwiPackChannel::ack:
+ * @seq: the sequence number of an acknowledged frame.
+ *
+ * If the channel has been sent in this frame, its value becomes the base of
+ * the next deltas. A late acknowledge of an older frame is ignored.
+ *
+ * Public.
+ */
+void pwiPackChannel::ack( uint8_t seq )
+{
+    if( this->acked && ( int8_t )( seq - this->acked_seq ) <= 0 ){
+        return;
+    }
+    for( uint8_t i=0 ; i<this->sent_count ; ++i ){
+        uint8_t idx = ( this->sent_head + PWI_PACK_HISTORY - 1 - i ) % PWI_PACK_HISTORY;
+        if( this->sent_seq[idx] == seq ){
+            this->acked = true;
+            this->acked_seq = seq;
+            this->acked_value = this->sent_value[idx];
+            return;
+        }
+    }
+}
+
+/**
+ * pwiPackChannel::Ack:
+ * @seq: the sequence number of an acknowledged frame.
+ *
+ * Acknowledge the frame for all the channels.
+ *
+ * Public Static.
+ */
+void pwiPackChannel::Ack( uint8_t seq )
+{
+    pwiPackChannel::list.iter(( pwiListIterCb * ) pwiPackChannel::AckCb, &seq );
+}
+
+/*
+ * pwiPackChannel::AckCb:
+ * @channel: a pwiPackChannel.
+ * @user_data: a pointer to the sequence number.
+ *
+ * pwiList::iter() callback function.
+ *
+ * Private Static.
+ */
+void pwiPackChannel::AckCb( pwiPackChannel *channel, void *user_data )
+{
+    channel->ack( *( uint8_t * ) user_data );
+}
+
+/**
+ * pwiPack::pwiPack:
+ *
+ * Constructor: start a new frame.
+ *
+ * Public.
+ */
+pwiPack::pwiPack( void )
+{
+    this->reset();
+}
+
+/**
+ * pwiPack::addDelta:
+ * @channel: the delta channel.
+ * @value: its current value.
+ *
+ * Add the @value as a delta since the last acknowledged value of the
+ * @channel, or as an absolute value if there is no usable base.
+ *
+ * Returns: %TRUE if the field has been added, %FALSE if the frame is full.
+ *
+ * Public.
+ */
+bool pwiPack::addDelta( pwiPackChannel &channel, uint32_t value )
+{
+    uint8_t seq = this->getSeq();
+    bool added;
+
+    // a base older than the history is forgotten, before its sequence
+    // number wraps and seems recent again
+    if( channel.acked && ( uint8_t )( seq - channel.acked_seq ) >= PWI_PACK_HISTORY ){
+        channel.acked = false;
+    }
+    if( channel.acked ){
+        added = this->addField( PWI_PACK_DELTA, channel.channel, pwiZigzag(( int32_t )( value - channel.acked_value )), channel.acked_seq );
+    } else {
+        added = this->addField( PWI_PACK_ABSOLUTE, channel.channel, value );
+    }
+    if( added ){
+        channel.sent_seq[channel.sent_head] = seq;
+        channel.sent_value[channel.sent_head] = value;
+        channel.sent_head = ( channel.sent_head+1 ) % PWI_PACK_HISTORY;
+        if( channel.sent_count < PWI_PACK_HISTORY ){
+            channel.sent_count += 1;
+        }
+    }
+    return( added );
+}
+
+/**
+ * pwiPack::addSigned:
+ * @channel: the channel number.
+ * @value: the value.
+ *
+ * Returns: %TRUE if the field has been added, %FALSE if the frame is full.
+ *
+ * Public.
+ */
+bool pwiPack::addSigned( uint8_t channel, int32_t value )
+{
+    return( this->addField( PWI_PACK_SIGNED, channel, pwiZigzag( value )));
+}
+
+/**
+ * pwiPack::addUnsigned:
+ * @channel: the channel number.
+ * @value: the value.
+ *
+ * Returns: %TRUE if the field has been added, %FALSE if the frame is full.
+ *
+ * Public.
+ */
+bool pwiPack::addUnsigned( uint8_t channel, uint32_t value )
+{
+    return( this->addField( PWI_PACK_UNSIGNED, channel, value ));
+}
+
+/**
+ * pwiPack::getBuffer:
+ *
+ * Returns: the encoded frame.
+ *
+ * Public.
+ */
+const uint8_t *pwiPack::getBuffer( void )
+{
+    return( this->buffer );
+}
+
+/**
+ * pwiPack::getLength:
+ *
+ * Returns: the length of the encoded frame.
+ *
+ * Public.
+ */
+uint8_t pwiPack::getLength( void )
+{
+    return( this->length );
+}
+
+/**
+ * pwiPack::getSeq:
+ *
+ * Returns: the sequence number of the frame.
+ *
+ * Public.
+ */
+uint8_t pwiPack::getSeq( void )
+{
+    return( this->buffer[0] );
+}
+
+/**
+ * pwiPack::reset:
+ *
+ * Start a new frame, with a new sequence number.
+ *
+ * Public.
+ */
+void pwiPack::reset( void )
+{
+    this->buffer[0] = pwiPack::next_seq++;
+    this->length = 1;
+}
+
+/**
+ * pwiPack::GetSeq:
+ * @frame: an encoded frame, e.g. the custom payload of a received echo.
+ *
+ * Returns: the sequence number of the frame.
+ *
+ * Public Static.
+ */
+uint8_t pwiPack::GetSeq( const void *frame )
+{
+    return( *( const uint8_t * ) frame );
+}
+
+/*
+ * pwiPack::addField:
+ * @type: the field type.
+ * @channel: the channel number.
+ * @value: the value, already zig-zag encoded if needed.
+ * @base_seq: the sequence number of the base of a delta field.
+ *
+ * Append the field, unless it does not fit in the frame.
+ *
+ * Returns: %TRUE if the field has been added.
+ *
+ * Private.
+ */
+bool pwiPack::addField( uint8_t type, uint8_t channel, uint32_t value, int16_t base_seq )
+{
+    uint8_t needed = 1 + ( base_seq >= 0 ? 1 : 0 ) + pwiVarintSize( value );
+    if( this->length + needed > sizeof( this->buffer )){
+        return( false );
+    }
+    this->buffer[this->length++] = ( type << 6 ) | ( channel % PWI_PACK_CHANNELS );
+    if( base_seq >= 0 ){
+        this->buffer[this->length++] = base_seq;
+    }
+    this->length += pwiVarintPut( this->buffer+this->length, sizeof( this->buffer )-this->length, value );
+    return( true );
+}
+
+/**
+ * pwiPackDecoder::pwiPackDecoder:
+ *
+ * Constructor.
+ *
+ * Public.
+ */
+pwiPackDecoder::pwiPackDecoder( void )
+{
+    this->reset();
+}
+
+/**
+ * pwiPackDecoder::decode:
+ * @frame: the encoded frame.
+ * @length: the length of the @frame.
+ * @cb: the callback to be called for each decoded field; the value of a
+ *  signed field is to be casted to int32_t, while the value of a delta
+ *  field is the reconstructed absolute value.
+ * @user_data: [allow-none]: the user data to be passed to @cb.
+ *
+ * Decode the frame. A delta field whose base is unknown (e.g. because the
+ * frame which held it has been lost) is skipped.
+ *
+ * Returns: %PWI_PACK_OK, or the last error code.
+ *
+ * Public.
+ */
+uint8_t pwiPackDecoder::decode( const uint8_t *frame, uint8_t length, pwiPackDecoderCb cb, void *user_data )
+{
+    uint8_t status = PWI_PACK_OK;
+    uint8_t offset = 1;
+    uint32_t value;
+
+    if( !length ){
+        return( PWI_PACK_ERR01 );
+    }
+    while( offset < length ){
+        uint8_t type = frame[offset] >> 6;
+        uint8_t channel = frame[offset] & ( PWI_PACK_CHANNELS-1 );
+        uint8_t base_seq = 0;
+        offset += 1;
+        if( type == PWI_PACK_DELTA ){
+            if( offset >= length ){
+                return( PWI_PACK_ERR01 );
+            }
+            base_seq = frame[offset++];
+        }
+        uint8_t consumed = pwiVarintGet( frame+offset, length-offset, value );
+        if( !consumed ){
+            return( PWI_PACK_ERR01 );
+        }
+        offset += consumed;
+        switch( type ){
+            case PWI_PACK_SIGNED:
+                value = ( uint32_t ) pwiUnzigzag( value );
+                break;
+            case PWI_PACK_DELTA: {
+                uint32_t base;
+                if( !this->getBase( channel, base_seq, base )){
+                    status = PWI_PACK_ERR02;
+                    continue;
+                }
+                value = base + ( uint32_t ) pwiUnzigzag( value );
+                this->remember( channel, frame[0], value );
+                break;
+            }
+            case PWI_PACK_ABSOLUTE:
+                this->remember( channel, frame[0], value );
+                break;
+        }
+        if( cb ){
+            cb( channel, type, value, user_data );
+        }
+    }
+    return( status );
+}
+
+/**
+ * pwiPackDecoder::reset:
+ *
+ * Forget all the bases, e.g. when the sender has rebooted.
+ *
+ * Public.
+ */
+void pwiPackDecoder::reset( void )
+{
+    memset( this->count, '\0', sizeof( this->count ));
+    memset( this->head, '\0', sizeof( this->head ));
+}
+
+/*
+ * pwiPackDecoder::getBase:
+ * @channel: the channel number.
+ * @base_seq: the sequence number of the base frame.
+ * @base: [out]: the value of the channel in this frame.
+ *
+ * Returns: %TRUE if the base has been found.
+ *
+ * Private.
+ */
+bool pwiPackDecoder::getBase( uint8_t channel, uint8_t base_seq, uint32_t &base )
+{
+    for( uint8_t i=0 ; i<this->count[channel] ; ++i ){
+        uint8_t idx = ( this->head[channel] + PWI_PACK_HISTORY - 1 - i ) % PWI_PACK_HISTORY;
+        if( this->seq[channel][idx] == base_seq ){
+            base = this->value[channel][idx];
+            return( true );
+        }
+    }
+    return( false );
+}
+
+/*
+ * pwiPackDecoder::remember:
+ * @channel: the channel number.
+ * @frame_seq: the sequence number of the frame.
+ * @value: the decoded value.
+ *
+ * Keep the value as a possible base for the next delta fields; a repeated
+ * frame does not consume the history.
+ *
+ * Private.
+ */
+void pwiPackDecoder::remember( uint8_t channel, uint8_t frame_seq, uint32_t value )
+{
+    uint8_t idx = ( this->head[channel] + PWI_PACK_HISTORY - 1 ) % PWI_PACK_HISTORY;
+    if( !this->count[channel] || this->seq[channel][idx] != frame_seq ){
+        idx = this->head[channel];
+        this->head[channel] = ( idx+1 ) % PWI_PACK_HISTORY;
+        if( this->count[channel] < PWI_PACK_HISTORY ){
+            this->count[channel] += 1;
+        }
+    }
+    this->seq[channel][idx] = frame_seq;
+    this->value[channel][idx] = value;
+}
@@ -0,0 +1,178 @@
+#ifndef __PWI_PACK_H__
+#define __PWI_PACK_H__
+
+/*
+ * A compact binary encoding of counters and aggregates, so that a single
+ * radio frame (MAX_PAYLOAD bytes) carries several channels of updates.
+ *
+ * Encoding:
+ * - integers are varints: 7 bits per byte, least significant group first,
+ *   the high bit being set on all the bytes but the last one; so a value
+ *   lower than 128 takes one byte, and a 32-bits value at most five;
+ * - signed integers are zig-zag encoded first (0, -1, 1, -2, ... become
+ *   0, 1, 2, 3, ...), so that small negative values stay small;
+ * - counters are sent as the (zig-zag) delta since the last value which has
+ *   been acknowledged by the receiver (see pwiPackChannel), and as an
+ *   absolute value until then.
+ *
+ * A frame is made of a sequence number byte, followed by fields; each field
+ * starts with a header byte which holds the field type on its two high bits,
+ * and the channel number (0-63) on the six low bits:
+ * - PWI_PACK_UNSIGNED: <varint value>
+ * - PWI_PACK_SIGNED:   <varint zigzag( value )>
+ * - PWI_PACK_DELTA:    <base seq byte> <varint zigzag( value - base value )>
+ * - PWI_PACK_ABSOLUTE: <varint value>, which also sets the base of a delta
+ *                      channel.
+ *
+ * pwiPackDecoder is the matching receiver, which keeps the last decoded
+ * values of each delta channel; see also extras/host/packdecode.
+ *
+ * Usage synopsys:
+ *
+ * a) define the channels whose values are sent as deltas:
+ *    pwiPackChannel pulsesChannel( 0 );
+ *
+ * b) build and send a frame, requesting an echo:
+ *    pwiPack pack;
+ *    pack.addDelta( pulsesChannel, mySensor.getPulsesCount());
+ *    pack.addUnsigned( 1, mySensor.getRate());
+ *    MyMessage msg( id, V_CUSTOM );
+ *    send( msg.set( pack.getBuffer(), pack.getLength()), true );
+ *
+ * c) on receiving the echo of the frame:
+ *    pwiPackChannel::Ack( pwiPack::GetSeq( msg.getCustom()));
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <Arduino.h>
+#include <core/MySensorsCore.h>
+#include "pwiList.h"
+
+/* the count of the last frames which are remembered by both sides for a
+ * delta channel; a base older than that is replaced by an absolute value
+ */
+#ifndef PWI_PACK_HISTORY
+#define PWI_PACK_HISTORY                4
+#endif
+
+/* the max count of channels
+ */
+#define PWI_PACK_CHANNELS               64
+
+/* the field types
+ */
+enum {
+    PWI_PACK_UNSIGNED = 0,
+    PWI_PACK_SIGNED,
+    PWI_PACK_DELTA,
+    PWI_PACK_ABSOLUTE
+};
+
+/* the decoding status
+ */
+enum {
+    PWI_PACK_OK = 0,
+    PWI_PACK_ERR01,                             // truncated frame
+    PWI_PACK_ERR02                              // unknown base of a delta field
+};
+
+/* varint and zig-zag primitives
+ */
+uint8_t  pwiVarintGet( const uint8_t *buffer, uint8_t size, uint32_t &value );
+uint8_t  pwiVarintPut( uint8_t *buffer, uint8_t size, uint32_t value );
+uint8_t  pwiVarintSize( uint32_t value );
+
+inline uint32_t pwiZigzag( int32_t value )
+{
+    return(( uint32_t ) value << 1 ) ^ ( uint32_t )( value >> 31 );
+}
+
+inline int32_t pwiUnzigzag( uint32_t value )
+{
+    return(( int32_t )( value >> 1 ) ^ -( int32_t )( value & 1 ));
+}
+
+/*
+ * pwiPackChannel:
+ * the sender side of a delta channel.
+ */
+class pwiPackChannel {
+    friend class pwiPack;
+
+    public:
+                                  pwiPackChannel( uint8_t channel );
+
+                uint8_t           getChannel( void );
+                bool              isAcked( void );
+                void              ack( uint8_t seq );
+
+        static  void              Ack( uint8_t seq );
+
+    private:
+                uint8_t           channel;
+                bool              acked;
+                uint8_t           acked_seq;
+                uint32_t          acked_value;
+                uint8_t           sent_seq[PWI_PACK_HISTORY];
+                uint32_t          sent_value[PWI_PACK_HISTORY];
+                uint8_t           sent_head;
+                uint8_t           sent_count;
+
+        static  pwiList           list;
+
+        static  void              AckCb( pwiPackChannel *channel, void *user_data );
+};
+
+/*
+ * pwiPack:
+ * a frame builder.
+ */
+class pwiPack {
+    public:
+                                  pwiPack( void );
+
+                bool              addDelta( pwiPackChannel &channel, uint32_t value );
+                bool              addSigned( uint8_t channel, int32_t value );
+                bool              addUnsigned( uint8_t channel, uint32_t value );
+          const uint8_t          *getBuffer( void );
+                uint8_t           getLength( void );
+                uint8_t           getSeq( void );
+                void              reset( void );
+
+        static  uint8_t           GetSeq( const void *frame );
+
+    private:
+                uint8_t           buffer[MAX_PAYLOAD];
+                uint8_t           length;
+
+        static  uint8_t           next_seq;
+
+                bool              addField( uint8_t type, uint8_t channel, uint32_t value, int16_t base_seq=-1 );
+};
+
+/*
+ * pwiPackDecoder:
+ * the receiver side, which keeps the last decoded values of the delta
+ * channels of one sender (about 1.5 KB).
+ */
+typedef void ( *pwiPackDecoderCb )( uint8_t channel, uint8_t type, uint32_t value, void *user_data );
+
+class pwiPackDecoder {
+    public:
+                                  pwiPackDecoder( void );
+
+                uint8_t           decode( const uint8_t *frame, uint8_t length, pwiPackDecoderCb cb, void *user_data=NULL );
+                void              reset( void );
+
+    private:
+                uint8_t           seq[PWI_PACK_CHANNELS][PWI_PACK_HISTORY];
+                uint32_t          value[PWI_PACK_CHANNELS][PWI_PACK_HISTORY];
+                uint8_t           count[PWI_PACK_CHANNELS];
+                uint8_t           head[PWI_PACK_CHANNELS];
+
+                bool              getBase( uint8_t channel, uint8_t base_seq, uint32_t &base );
+                void              remember( uint8_t channel, uint8_t frame_seq, uint32_t value );
+};
+
+#endif // __PWI_PACK_H__
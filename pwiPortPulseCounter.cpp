@@ -0,0 +1,164 @@
+/*
+ * pwi 2026-10-18 creation
+ *                debug traces are written to the pwiLog binary ring
+ */
+
+#include "pwiPortPulseCounter.h"
+#include "pwiLog.h"
+
+/**
+ * pwiPortPulseCounter::pwiPortPulseCounter:
+ *
+ * Constructor.
+ *
+ * Public.
+ */
+pwiPortPulseCounter::pwiPortPulseCounter( void )
+{
+    /* setup
+     */
+    this->input_reg = NULL;
+    this->port = NOT_A_PORT;
+    this->channels = 0;
+    this->mask = 0;
+    this->rising = 0;
+    this->falling = 0;
+    this->sample_us = 0;
+
+    /* runtime
+     */
+    this->debounced = 0;
+    this->cnt0 = 0xff;
+    this->cnt1 = 0xff;
+    this->last_us = 0;
+    memset( this->counts, 0, sizeof( this->counts ));
+}
+
+/**
+ * pwiPortPulseCounter::getChannelsCount:
+ *
+ * Returns: the count of configured channels.
+ *
+ * Public.
+ */
+uint8_t pwiPortPulseCounter::getChannelsCount( void )
+{
+    return( this->channels );
+}
+
+/**
+ * pwiPortPulseCounter::getPulsesCount:
+ * @channel: the channel index, as returned by addChannel().
+ *
+ * Returns: the count of pulses detected on the @channel.
+ *
+ * Public.
+ */
+uint32_t pwiPortPulseCounter::getPulsesCount( uint8_t channel )
+{
+    return( channel < this->channels ? this->counts[this->bits[channel]] : 0 );
+}
+
+/**
+ * pwiPortPulseCounter::addChannel:
+ * @pin: the input pin.
+ * @edge: the edge to be counted, FALLING or RISING.
+ *
+ * Add a new channel, configuring the @pin as a pulled-up input.
+ * All the channels must be on the same port.
+ *
+ * Returns: the index of the new channel, or an error code.
+ *
+ * Public.
+ */
+uint8_t pwiPortPulseCounter::addChannel( uint8_t pin, uint8_t edge )
+{
+    if( this->channels >= PWI_PORT_CHANNELS ){
+        return( PWI_PORT_ERR03 );
+    }
+    uint8_t port = digitalPinToPort( pin );
+    if( port == NOT_A_PORT ){
+        return( PWI_PORT_ERR02 );
+    }
+    if( this->channels && port != this->port ){
+        return( PWI_PORT_ERR01 );
+    }
+    uint8_t bitmask = digitalPinToBitMask( pin );
+    uint8_t bit = 0;
+    while( !( bitmask & ( 1 << bit ))){
+        bit += 1;
+    }
+
+    digitalWrite( pin, HIGH );
+    pinMode( pin, INPUT );
+
+    this->port = port;
+    this->input_reg = portInputRegister( port );
+    this->bits[this->channels] = bit;
+    this->mask |= bitmask;
+    if( edge == RISING ){
+        this->rising |= bitmask;
+    } else {
+        this->falling |= bitmask;
+    }
+    // initialize the debounced state with the current level of the pin
+    this->debounced = ( this->debounced & ~bitmask ) | ( *this->input_reg & bitmask );
+    PWI_LOG( PORT_ADD_CHANNEL, pin, port, bit );
+    return( this->channels++ );
+}
+
+/**
+ * pwiPortPulseCounter::loopInput:
+ *
+ * Sample the port, debounce all channels at once, and count the edges.
+ *
+ * Returns: the count of pulses detected during this pass.
+ *
+ * Public.
+ */
+uint8_t pwiPortPulseCounter::loopInput( void )
+{
+    if( !this->input_reg ){
+        return( 0 );
+    }
+    if( this->sample_us ){
+        uint32_t now = micros();
+        if( now - this->last_us < this->sample_us ){
+            return( 0 );
+        }
+        this->last_us = now;
+    }
+
+    // vertical counters: a bit only toggles after four identical samples
+    uint8_t changed = ( *this->input_reg & this->mask ) ^ this->debounced;
+    this->cnt0 = ~( this->cnt0 & changed );
+    this->cnt1 = this->cnt0 ^ ( this->cnt1 & changed );
+    uint8_t toggled = changed & this->cnt0 & this->cnt1;
+    this->debounced ^= toggled;
+
+    // edges: rising where the bit is now high, falling where it is now low
+    uint8_t edges = toggled & (( this->debounced & this->rising ) | ( ~this->debounced & this->falling ));
+    uint8_t detected = 0;
+    for( uint8_t bit=0 ; edges ; ++bit, edges >>= 1 ){
+        if( edges & 1 ){
+            this->counts[bit] += 1;
+            detected += 1;
+        }
+    }
+    return( detected );
+}
+
+/**
+ * pwiPortPulseCounter::setSamplePeriod:
+ * @period_us: the min period between two samples of the port; zero to sample
+ *  on each loopInput() call.
+ *
+ * As a bit must be stable during four samples to be considered as changed,
+ * this defines the debounce time.
+ *
+ * Public.
+ */
+void pwiPortPulseCounter::setSamplePeriod( uint16_t period_us )
+{
+    this->sample_us = period_us;
+}
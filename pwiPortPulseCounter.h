@@ -0,0 +1,88 @@
+#ifndef __PWI_PORT_PULSE_COUNTER_H__
+#define __PWI_PORT_PULSE_COUNTER_H__
+
+/*
+ * A multi-channel pulse counter which reads a whole I/O port at once.
+ *
+ * Up to 8 pulse inputs, all wired to the same I/O port, are sampled with a
+ * single read of the port input register on each loopInput() call, instead
+ * of one (slow) digitalRead() per pin.
+ *
+ * All channels are debounced in parallel with a vertical counter: each port
+ * bit owns a 2-bits counter spread across two bytes, and a bit is only
+ * considered as having changed after four consecutive identical samples.
+ * Rising and falling edges of all channels are then detected at once with
+ * XOR/AND masks, and only the counters of the channels which actually got
+ * a pulse are incremented.
+ *
+ * The debounce time is so four times the sampling period, which is the main
+ * loop period unless a min sampling period is set (see setSamplePeriod()).
+ *
+ * Usage synopsys:
+ *
+ * a) define the counter:
+ *    pwiPortPulseCounter myCounter;
+ *
+ * b) add the channels, which must all be on the same port:
+ *    uint8_t gasChannel = myCounter.addChannel( 4, FALLING );
+ *    uint8_t waterChannel = myCounter.addChannel( 5, FALLING );
+ *
+ * c) sample the port from the main loop:
+ *    myCounter.loopInput();
+ *
+ * d) read the counts:
+ *    myCounter.getPulsesCount( gasChannel );
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <Arduino.h>
+
+#define PWI_PORT_CHANNELS               8
+
+enum {
+    PWI_PORT_ERR01 = 0xfd,                      // the pin is not on the same port than the previous channels
+    PWI_PORT_ERR02,                             // the pin does not belong to any port
+    PWI_PORT_ERR03                              // all channels are already used
+};
+
+class pwiPortPulseCounter {
+    public:
+                                  pwiPortPulseCounter( void );
+
+		/* getters
+		 */
+                uint8_t           getChannelsCount( void );
+                uint32_t          getPulsesCount( uint8_t channel );
+
+		/* actors
+		 */
+                uint8_t           addChannel( uint8_t pin, uint8_t edge );
+                uint8_t           loopInput( void );
+
+		/* setters
+		 */
+                void              setSamplePeriod( uint16_t period_us );
+
+    private:
+        /* setup
+         */
+                volatile uint8_t *input_reg;
+                uint8_t           port;
+                uint8_t           channels;
+                uint8_t           bits[PWI_PORT_CHANNELS];      // bit index of each channel
+                uint8_t           mask;                         // all used bits
+                uint8_t           rising;                       // bits counted on a rising edge
+                uint8_t           falling;                      // bits counted on a falling edge
+                uint16_t          sample_us;
+
+        /* runtime
+         */
+                uint8_t           debounced;
+                uint8_t           cnt0;
+                uint8_t           cnt1;
+                uint32_t          last_us;
+                uint32_t          counts[PWI_PORT_CHANNELS];    // indexed by bit index
+};
+
+#endif // __PWI_PORT_PULSE_COUNTER_H__
@@ -0,0 +1,368 @@
+/*
+ * pwi 2026-10-18 creation
+ *                stalls are keyed by timer, and reported with its user data
+ *                the sensor timers are reported with the sensor id
+ */
+
+#include "pwiProfiler.h"
+
+#ifdef PWI_PROFILER
+
+#include "pwiClock.h"
+#include "pwiSensor.h"
+#include "pwiTimer.h"
+#include <core/MySensorsCore.h>
+
+uint16_t    pwiProfiler::buckets[PWI_PROFILER_BUCKETS];
+uint32_t    pwiProfiler::loops = 0;
+uint32_t    pwiProfiler::last_us = 0;
+uint32_t    pwiProfiler::max_period_us = 0;
+uint32_t    pwiProfiler::stall_us[PWI_PROFILER_STALLS];
+const pwiTimer *pwiProfiler::stall_timer[PWI_PROFILER_STALLS];
+uint32_t    pwiProfiler::input_gap_us = 0;
+uint8_t     pwiProfiler::input_id = 0;
+uint8_t     pwiProfiler::report_id = 0;
+
+/**
+ * pwiProfiler::GetBucket:
+ * @index: the index of the bucket, counted from zero.
+ *
+ * Returns: the count of main loop periods in [2^index, 2^(index+1)) us
+ * (saturated to 65535).
+ *
+ * Public Static.
+ */
+uint16_t pwiProfiler::GetBucket( uint8_t index )
+{
+    return( index < PWI_PROFILER_BUCKETS ? pwiProfiler::buckets[index] : 0 );
+}
+
+/**
+ * pwiProfiler::GetInputGap:
+ * @sensor_id: [out][allow-none]: set to the identifier of the sensor.
+ *
+ * Returns: the worst gap between two loopInput() calls of a same
+ * pwiPulseSensor, in us.
+ *
+ * Public Static.
+ */
+uint32_t pwiProfiler::GetInputGap( uint8_t *sensor_id )
+{
+    if( sensor_id ){
+        *sensor_id = pwiProfiler::input_id;
+    }
+    return( pwiProfiler::input_gap_us );
+}
+
+/**
+ * pwiProfiler::GetLoops:
+ *
+ * Returns: the count of measured main loop periods.
+ *
+ * Public Static.
+ */
+uint32_t pwiProfiler::GetLoops( void )
+{
+    return( pwiProfiler::loops );
+}
+
+/**
+ * pwiProfiler::GetMaxPeriod:
+ *
+ * Returns: the longest main loop period, in us.
+ *
+ * Public Static.
+ */
+uint32_t pwiProfiler::GetMaxPeriod( void )
+{
+    return( pwiProfiler::max_period_us );
+}
+
+/**
+ * pwiProfiler::GetPercentile:
+ * @percent: the requested percentile, e.g. 99.
+ *
+ * Returns: an upper bound of the main loop period under which are @percent
+ * of the measured periods, in us; as the histogram has a log2 resolution,
+ * this is the upper limit of the bucket which holds the percentile, bounded
+ * by the longest period.
+ *
+ * Public Static.
+ */
+uint32_t pwiProfiler::GetPercentile( uint8_t percent )
+{
+    uint32_t total = 0;
+    for( uint8_t i=0 ; i<PWI_PROFILER_BUCKETS ; ++i ){
+        total += pwiProfiler::buckets[i];
+    }
+    uint32_t target = ( total * percent + 99 ) / 100;
+    uint32_t count = 0;
+    for( uint8_t i=0 ; i<PWI_PROFILER_BUCKETS-1 ; ++i ){
+        count += pwiProfiler::buckets[i];
+        if( count && count >= target ){
+            uint32_t bound = ( uint32_t ) 2 << i;
+            return( bound < pwiProfiler::max_period_us ? bound : pwiProfiler::max_period_us );
+        }
+    }
+    return( pwiProfiler::max_period_us );
+}
+
+/**
+ * pwiProfiler::GetStall:
+ * @index: the rank of the stall, zero being the longest.
+ * @label: [out][allow-none]: set to the label of the culprit timer.
+ * @user_data: [out][allow-none]: set to the user data of the culprit timer.
+ *
+ * Returns: the duration of the stall, in us, or zero.
+ *
+ * Public Static.
+ */
+uint32_t pwiProfiler::GetStall( uint8_t index, const char **label, void **user_data )
+{
+    if( index >= PWI_PROFILER_STALLS ){
+        return( 0 );
+    }
+    const pwiTimer *timer = pwiProfiler::stall_timer[index];
+    if( label ){
+        *label = timer ? timer->label : NULL;
+    }
+    if( user_data ){
+        *user_data = timer ? timer->user_data : NULL;
+    }
+    return( pwiProfiler::stall_us[index] );
+}
+
+/**
+ * pwiProfiler::Dump:
+ *
+ * Print the results to the Serial, as:
+ * - 'loops=<count> max=<us> p50=<us> p90=<us> p99=<us>'
+ * - one '<2^i>us <count>' line per non-empty bucket of the histogram
+ * - one 'stall <us> <label> <user_data>' line per recorded stall, the user
+ *   data being printed in hexadecimal, and the label of the timers of a
+ *   sensor including its id (see pwiSensor::GetTimerLabel())
+ * - 'input #<id> <us>' for the worst gap between two loopInput() calls.
+ *
+ * Public Static.
+ */
+void pwiProfiler::Dump( void )
+{
+    Serial.print( F( "[pwiProfiler::Dump] loops=" ));
+    Serial.print(( unsigned long ) pwiProfiler::loops );
+    Serial.print( F( " max=" ));
+    Serial.print(( unsigned long ) pwiProfiler::max_period_us );
+    Serial.print( F( " p50=" ));
+    Serial.print(( unsigned long ) pwiProfiler::GetPercentile( 50 ));
+    Serial.print( F( " p90=" ));
+    Serial.print(( unsigned long ) pwiProfiler::GetPercentile( 90 ));
+    Serial.print( F( " p99=" ));
+    Serial.println(( unsigned long ) pwiProfiler::GetPercentile( 99 ));
+
+    for( uint8_t i=0 ; i<PWI_PROFILER_BUCKETS ; ++i ){
+        if( pwiProfiler::buckets[i] ){
+            Serial.print( i == PWI_PROFILER_BUCKETS-1 ? F( ">=" ) : F( "  " ));
+            Serial.print(( unsigned long )(( uint32_t ) 1 << i ));
+            Serial.print( F( "us " ));
+            Serial.println( pwiProfiler::buckets[i] );
+        }
+    }
+    for( uint8_t i=0 ; i<PWI_PROFILER_STALLS && pwiProfiler::stall_us[i] ; ++i ){
+        const char *label;
+        void *user_data;
+        char buffer[PWI_SENSOR_LABEL_SIZE];
+        Serial.print( F( "stall " ));
+        Serial.print(( unsigned long ) pwiProfiler::GetStall( i, &label, &user_data ));
+        Serial.print( ' ' );
+        label = pwiSensor::GetTimerLabel( label, user_data, buffer, sizeof( buffer ));
+        Serial.print( label ? label : "(null)" );
+        Serial.print( ' ' );
+        Serial.println(( unsigned long )( uintptr_t ) user_data, HEX );
+    }
+    if( pwiProfiler::input_gap_us ){
+        Serial.print( F( "input #" ));
+        Serial.print( pwiProfiler::input_id );
+        Serial.print( ' ' );
+        Serial.println(( unsigned long ) pwiProfiler::input_gap_us );
+    }
+}
+
+/**
+ * pwiProfiler::Reset:
+ *
+ * Reset the results; the current main loop period is still measured.
+ *
+ * Public Static.
+ */
+void pwiProfiler::Reset( void )
+{
+    memset( pwiProfiler::buckets, '\0', sizeof( pwiProfiler::buckets ));
+    memset( pwiProfiler::stall_us, '\0', sizeof( pwiProfiler::stall_us ));
+    memset( pwiProfiler::stall_timer, '\0', sizeof( pwiProfiler::stall_timer ));
+    pwiProfiler::loops = 0;
+    pwiProfiler::max_period_us = 0;
+    pwiProfiler::input_gap_us = 0;
+    pwiProfiler::input_id = 0;
+}
+
+/**
+ * pwiProfiler::Send:
+ * @child_id: the diagnostic child identifier.
+ *
+ * Publish the results to the controller as V_TEXT messages, then reset them:
+ * - 'L<loops> M<max>'
+ * - 'Q<p50>/<p90>/<p99>'
+ * - one 'S<us> <label> <user_data>' message per recorded stall, as for
+ *   Dump()
+ * - 'I#<id> <us>' for the worst gap between two loopInput() calls.
+ *
+ * Public Static.
+ */
+void pwiProfiler::Send( uint8_t child_id )
+{
+    char payload[1+MAX_PAYLOAD];
+    MyMessage msg( child_id, V_TEXT );
+
+    snprintf_P( payload, sizeof( payload ), PSTR( "L%lu M%lu" ),
+            ( unsigned long ) pwiProfiler::loops, ( unsigned long ) pwiProfiler::max_period_us );
+    send( msg.set( payload ));
+
+    snprintf_P( payload, sizeof( payload ), PSTR( "Q%lu/%lu/%lu" ),
+            ( unsigned long ) pwiProfiler::GetPercentile( 50 ),
+            ( unsigned long ) pwiProfiler::GetPercentile( 90 ),
+            ( unsigned long ) pwiProfiler::GetPercentile( 99 ));
+    send( msg.set( payload ));
+
+    for( uint8_t i=0 ; i<PWI_PROFILER_STALLS && pwiProfiler::stall_us[i] ; ++i ){
+        const char *label;
+        void *user_data;
+        char buffer[PWI_SENSOR_LABEL_SIZE];
+        uint32_t duration = pwiProfiler::GetStall( i, &label, &user_data );
+        label = pwiSensor::GetTimerLabel( label, user_data, buffer, sizeof( buffer ));
+        snprintf_P( payload, sizeof( payload ), PSTR( "S%lu %s %lx" ),
+                ( unsigned long ) duration, label ? label : "",
+                ( unsigned long )( uintptr_t ) user_data );
+        send( msg.set( payload ));
+    }
+
+    if( pwiProfiler::input_gap_us ){
+        snprintf_P( payload, sizeof( payload ), PSTR( "I#%u %lu" ),
+                pwiProfiler::input_id, ( unsigned long ) pwiProfiler::input_gap_us );
+        send( msg.set( payload ));
+    }
+
+    pwiProfiler::Reset();
+}
+
+/**
+ * pwiProfiler::SetupReport:
+ * @timer: a timer to be dedicated to the publication.
+ * @child_id: the diagnostic child identifier.
+ * @period_ms: the publication period.
+ *
+ * Configure and start the @timer so that the results are periodically
+ * published to the controller.
+ *
+ * Public Static.
+ */
+void pwiProfiler::SetupReport( pwiTimer &timer, uint8_t child_id, unsigned long period_ms )
+{
+    pwiProfiler::report_id = child_id;
+    timer.setup( "Profiler", period_ms, false, pwiProfiler::OnReportCb );
+    timer.start();
+}
+
+/**
+ * pwiProfiler::Input:
+ * @sensor_id: the identifier of the pwiPulseSensor.
+ * @last_us: the time of the previous loopInput() call of this sensor, zero
+ *  meaning never; updated on return.
+ *
+ * Hook called by pwiPulseSensor::loopInput().
+ *
+ * Public Static.
+ */
+void pwiProfiler::Input( uint8_t sensor_id, uint32_t &last_us )
+{
+    uint32_t now_us = micros();
+    if( last_us ){
+        uint32_t gap = pwiElapsed( last_us, now_us );
+        if( gap > pwiProfiler::input_gap_us ){
+            pwiProfiler::input_gap_us = gap;
+            pwiProfiler::input_id = sensor_id;
+        }
+    }
+    last_us = now_us ? now_us : 1;
+}
+
+/**
+ * pwiProfiler::Loop:
+ *
+ * Hook to be called once per main loop iteration: record the period since
+ * the previous call.
+ *
+ * Public Static.
+ */
+void pwiProfiler::Loop( void )
+{
+    uint32_t now_us = micros();
+    if( pwiProfiler::last_us ){
+        uint32_t period = pwiElapsed( pwiProfiler::last_us, now_us );
+        uint8_t i = 0;
+        for( uint32_t v=period>>1 ; v && i<PWI_PROFILER_BUCKETS-1 ; v>>=1 ){
+            i += 1;
+        }
+        if( pwiProfiler::buckets[i] < 0xffff ){
+            pwiProfiler::buckets[i] += 1;
+        }
+        if( period > pwiProfiler::max_period_us ){
+            pwiProfiler::max_period_us = period;
+        }
+        pwiProfiler::loops += 1;
+    }
+    pwiProfiler::last_us = now_us ? now_us : 1;
+}
+
+/**
+ * pwiProfiler::Stall:
+ * @timer: the timer.
+ * @duration_us: the duration of its callback.
+ *
+ * Hook called by pwiTimer::Loop() after each callback which has been run in
+ * the main loop: keep the PWI_PROFILER_STALLS longest ones, a timer being
+ * recorded at most once with its longest stall.
+ * The stalls are keyed by the timer itself rather than by its label, which
+ * may be shared by several timers.
+ *
+ * Public Static.
+ */
+void pwiProfiler::Stall( const pwiTimer *timer, uint32_t duration_us )
+{
+    uint8_t i;
+    // either replace the previous stall of this timer, or the shortest one
+    for( i=0 ; i<PWI_PROFILER_STALLS-1 && pwiProfiler::stall_timer[i] != timer ; ++i );
+    if( duration_us <= pwiProfiler::stall_us[i] ){
+        return;
+    }
+    // move the stall up to keep the array sorted
+    while( i > 0 && duration_us > pwiProfiler::stall_us[i-1] ){
+        pwiProfiler::stall_us[i] = pwiProfiler::stall_us[i-1];
+        pwiProfiler::stall_timer[i] = pwiProfiler::stall_timer[i-1];
+        i -= 1;
+    }
+    pwiProfiler::stall_us[i] = duration_us;
+    pwiProfiler::stall_timer[i] = timer;
+}
+
+/*
+ * pwiProfiler::OnReportCb:
+ *
+ * Callback of the report timer.
+ *
+ * Private Static.
+ */
+void pwiProfiler::OnReportCb( void *user_data )
+{
+    pwiProfiler::Send( pwiProfiler::report_id );
+}
+
+#endif // PWI_PROFILER
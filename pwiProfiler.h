@@ -0,0 +1,103 @@
+#ifndef __PWI_PROFILER_H__
+#define __PWI_PROFILER_H__
+
+/*
+ * A main loop jitter and latency profiler.
+ *
+ * The profiler records:
+ * - the histogram of the main loop periods, as log2 buckets of microseconds
+ *   (bucket i counts the periods in [2^i, 2^(i+1)) us, the last bucket
+ *   counting all longer periods);
+ * - the longest stalls, i.e. the pwiTimer callbacks which have run the
+ *   longest from pwiTimer::Loop(), one per timer, along with the label and
+ *   the user data of the timer (so that timers which share a same label,
+ *   e.g. the min period timers of the sensors, can be told apart);
+ * - the worst gap between two loopInput() calls of a pwiPulseSensor, which
+ *   is the actual risk of missing pulses in polling mode.
+ *
+ * It is only compiled when the library is built with PWI_PROFILER defined;
+ * it then uses a fixed amount of RAM (about 80 bytes with the default
+ * sizes), and costs one micros() call and a few shifts per hook, so that it
+ * may be left on in production.
+ *
+ * Usage synopsys:
+ *
+ * a) call Loop() once per main loop iteration:
+ *    void loop(){
+ *        pwiProfiler::Loop();
+ *        pwiTimer::Loop();
+ *        ...
+ *    }
+ *
+ * b) either dump the results to the Serial:
+ *    pwiProfiler::Dump();
+ *
+ * c) or periodically publish them to the controller:
+ *    present( profiler_id, S_INFO, "Loop profiler" );
+ *    pwiTimer profilerTimer;
+ *    pwiProfiler::SetupReport( profilerTimer, profiler_id, 3600000 );
+ *
+ * pwi 2026-10-18 creation
+ *                stalls are recorded per timer
+ */
+
+#ifdef PWI_PROFILER
+
+#include <Arduino.h>
+
+class pwiTimer;
+
+/* the count of log2 buckets of the loop periods histogram: the last bucket
+ * counts the periods longer than 2^(PWI_PROFILER_BUCKETS-1) us
+ */
+#ifndef PWI_PROFILER_BUCKETS
+#define PWI_PROFILER_BUCKETS            20
+#endif
+
+/* the count of longest stalls kept by the profiler
+ */
+#ifndef PWI_PROFILER_STALLS
+#define PWI_PROFILER_STALLS             4
+#endif
+
+class pwiProfiler {
+    public:
+        /* getters
+         */
+        static  uint16_t          GetBucket( uint8_t index );
+        static  uint32_t          GetInputGap( uint8_t *sensor_id=NULL );
+        static  uint32_t          GetLoops( void );
+        static  uint32_t          GetMaxPeriod( void );
+        static  uint32_t          GetPercentile( uint8_t percent );
+        static  uint32_t          GetStall( uint8_t index, const char **label=NULL, void **user_data=NULL );
+
+        /* actors
+         */
+        static  void              Dump( void );
+        static  void              Reset( void );
+        static  void              Send( uint8_t child_id );
+        static  void              SetupReport( pwiTimer &timer, uint8_t child_id, unsigned long period_ms );
+
+        /* hooks
+         */
+        static  void              Input( uint8_t sensor_id, uint32_t &last_us );
+        static  void              Loop( void );
+        static  void              Stall( const pwiTimer *timer, uint32_t duration_us );
+
+    private:
+        static  uint16_t          buckets[PWI_PROFILER_BUCKETS];
+        static  uint32_t          loops;
+        static  uint32_t          last_us;
+        static  uint32_t          max_period_us;
+        static  uint32_t          stall_us[PWI_PROFILER_STALLS];
+        static  const pwiTimer   *stall_timer[PWI_PROFILER_STALLS];
+        static  uint32_t          input_gap_us;
+        static  uint8_t           input_id;
+        static  uint8_t           report_id;
+
+        static  void              OnReportCb( void *user_data );
+};
+
+#endif // PWI_PROFILER
+
+#endif // __PWI_PROFILER_H__
@@ -6,12 +6,59 @@
  * pwi 2025- 3-22 creation
  * pwi 2025- 3-23 initialize input pin mode and state
  * pwi 2025- 7-31 add bounce protection
+ * pwi 2026-10-18 interrupt-driven counting mode
+ *                instantaneous rate estimation
+ *                wear-leveled EEPROM persistence of the pulses count
+ *                use pwiDebounce engine, fixing the millis() rollover
+ *                hardware counter backend
+ *                immediate send on pulses count threshold
+ *                debug traces are written to the pwiLog binary ring
+ *                use the pwiClock wrap-safe helpers
+ *                loopInput() gaps are measured by the pwiProfiler
+ *                the pulses count is saved in the warm-start snapshot
+ *                the polling lockout only starts on the counted edge
  */
 
 #include "pwiPulseSensor.h"
+#include "pwiLog.h"
+#include "pwiProfiler.h"
 
-// uncomment to debugging this file
-//#define SENSOR_DEBUG
+#define DEFAULT_RATE_TIMEOUT    600000
+#define MAX_RATE_TIMEOUT        3600000         // less than the micros() rollover period
+#define DEFAULT_HW_RATE_WINDOW  1000
+
+#if PWI_PULSE_MAX_INTERRUPTS > 8
+#error "pwiPulseSensor: PWI_PULSE_MAX_INTERRUPTS cannot be greater than 8"
+#endif
+
+// the sensors attached to an interrupt, indexed by interrupt number
+pwiPulseSensor *pwiPulseSensor::IsrSensors[PWI_PULSE_MAX_INTERRUPTS];
+
+// the interrupt service routines, indexed by interrupt number
+void ( * const pwiPulseSensor::IsrTrampolines[PWI_PULSE_MAX_INTERRUPTS] )( void ) = {
+    pwiPulseSensor::Isr<0>,
+#if PWI_PULSE_MAX_INTERRUPTS > 1
+    pwiPulseSensor::Isr<1>,
+#endif
+#if PWI_PULSE_MAX_INTERRUPTS > 2
+    pwiPulseSensor::Isr<2>,
+#endif
+#if PWI_PULSE_MAX_INTERRUPTS > 3
+    pwiPulseSensor::Isr<3>,
+#endif
+#if PWI_PULSE_MAX_INTERRUPTS > 4
+    pwiPulseSensor::Isr<4>,
+#endif
+#if PWI_PULSE_MAX_INTERRUPTS > 5
+    pwiPulseSensor::Isr<5>,
+#endif
+#if PWI_PULSE_MAX_INTERRUPTS > 6
+    pwiPulseSensor::Isr<6>,
+#endif
+#if PWI_PULSE_MAX_INTERRUPTS > 7
+    pwiPulseSensor::Isr<7>,
+#endif
+};
 
 /*
  * Constructor
@@ -35,10 +82,143 @@ void pwiPulseSensor::init()
 	// setup
 	this->input_pin = 0;
 	this->edge = 0;
+	this->mode = PWI_PULSE_POLLING;
+	this->rate_window_ms = 0;
+	this->rate_timeout_ms = DEFAULT_RATE_TIMEOUT;
 	// runtime
-	this->last_state = 0;
 	this->imp_count = 0;
 	this->last_ms = 0;
+	this->last_us = 0;
+	this->last_count = 0;
+	this->ts_head = 0;
+	this->ts_count = 0;
+	// hardware counter
+	this->counter = NULL;
+	this->hw_base = 0;
+	this->hw_rate_count = 0;
+	this->hw_rate_us = 0;
+	this->hw_rate = 0;
+	// threshold trigger
+	this->trigger_pulses = 0;
+	this->trigger_spacing_ms = 0;
+	this->trigger_count = 0;
+	this->trigger_ms = 0;
+	// persistence
+	this->ring = NULL;
+	this->persist_delta = 0;
+	this->persist_period_ms = 0;
+	this->persist_min_ms = 0;
+	this->saved_count = 0;
+	this->saved_ms = 0;
+#ifdef PWI_PROFILER
+	this->profiler_us = 0;
+#endif
+}
+
+/*
+ * pwiPulseSensor::addPulse():
+ * @now_ms: the millis() timestamp of the pulse.
+ * @now_us: the micros() timestamp of the pulse.
+ *
+ * Count a new pulse and record its timestamp.
+ * This may be called from the interrupt service routine.
+ *
+ * Private
+ */
+void pwiPulseSensor::addPulse( uint32_t now_ms, uint32_t now_us )
+{
+	this->imp_count += 1;
+	this->last_ms = now_ms;
+	this->last_us = now_us;
+	this->ts_us[this->ts_head] = now_us;
+	this->ts_head = ( this->ts_head + 1 ) % PWI_PULSE_RATE_SAMPLES;
+	if( this->ts_count < PWI_PULSE_RATE_SAMPLES ){
+		this->ts_count += 1;
+	}
+}
+
+/*
+ * pwiPulseSensor::attach():
+ *
+ * Attach the interrupt service routine to the input pin.
+ *
+ * Returns: %TRUE if the input pin supports external interrupts.
+ *
+ * Private
+ */
+bool pwiPulseSensor::attach()
+{
+	int irq = digitalPinToInterrupt( this->input_pin );
+	if( !this->input_pin || irq == NOT_AN_INTERRUPT || irq >= PWI_PULSE_MAX_INTERRUPTS ){
+		return( false );
+	}
+	pwiPulseSensor::IsrSensors[irq] = this;
+	attachInterrupt( irq, pwiPulseSensor::IsrTrampolines[irq], this->edge );
+	return( true );
+}
+
+/*
+ * pwiPulseSensor::detach():
+ *
+ * Detach the interrupt service routine from the input pin.
+ *
+ * Private
+ */
+void pwiPulseSensor::detach()
+{
+	int irq = digitalPinToInterrupt( this->input_pin );
+	if( this->input_pin && irq != NOT_AN_INTERRUPT && irq < PWI_PULSE_MAX_INTERRUPTS ){
+		detachInterrupt( irq );
+		pwiPulseSensor::IsrSensors[irq] = NULL;
+	}
+}
+
+/*
+ * pwiPulseSensor::onInterrupt():
+ *
+ * Interrupt service routine: count the edge unless it happens during the
+ * lockout delay of the debounce engine.
+ *
+ * Private
+ */
+void pwiPulseSensor::onInterrupt()
+{
+	uint32_t now = micros();
+	if( this->debounce.accept( now )){
+		this->addPulse( millis(), now );
+	}
+}
+
+/**
+ * pwiPulseSensor::checkpoint():
+ *
+ * Save the current pulses count to the EEPROM ring, if it has changed since
+ * the last checkpoint.
+ * This may be called explicitely, e.g. when a power loss is detected.
+ *
+ * Public
+ */
+void pwiPulseSensor::checkpoint()
+{
+	uint32_t count = this->getPulsesCount();
+	if( this->ring && count != this->saved_count ){
+		this->ring->write( count );
+		this->saved_count = count;
+		this->saved_ms = millis();
+		PWI_LOG( PULSE_CHECKPOINT, this->getId(), count );
+	}
+}
+
+/**
+ * pwiPulseSensor::getDebounce():
+ *
+ * Returns: a reference to the debounce engine.
+ *
+ * Public
+ */
+pwiDebounce &pwiPulseSensor::getDebounce()
+{
+    return( this->debounce );
 }
 
 /**
@@ -61,24 +241,177 @@ uint8_t pwiPulseSensor::getInputPin()
     return( this->input_pin );
 }
 
+/**
+ * pwiPulseSensor::getMode():
+ *
+ * Returns: %PWI_PULSE_POLLING, %PWI_PULSE_INTERRUPT or %PWI_PULSE_HARDWARE.
+ * 
+ * Public
+ */
+uint8_t pwiPulseSensor::getMode()
+{
+    return( this->mode );
+}
+
 /**
  * pwiPulseSensor::getPulsesCount():
+ *
+ * Returns: an atomic snapshot of the pulses count.
  * 
  * Public
  */
 uint32_t pwiPulseSensor::getPulsesCount()
 {
-    return( this->imp_count );
+    noInterrupts();
+    uint32_t count = this->imp_count;
+    interrupts();
+    if( this->mode == PWI_PULSE_HARDWARE ){
+        count += this->counter->getCount() - this->hw_base;
+    }
+    return( count );
+}
+
+/**
+ * pwiPulseSensor::getRate():
+ *
+ * Estimate the current pulses rate from the timestamps of the last pulses:
+ * - the mean interval is computed over the recorded pulses which are inside
+ *   of the rate window (all recorded pulses if no window is set), at least
+ *   two pulses being needed;
+ * - when the time elapsed since the last pulse is greater than this mean
+ *   interval, the rate decays as the inverse of this elapsed time;
+ * - the rate falls to zero when no pulse has been detected since the rate
+ *   timeout.
+ *
+ * With a hardware counter, no pulse timestamp is available: the rate is rather
+ *  computed by loopInput() over each rate window (one second by default).
+ *
+ * E.g. with an energy meter which emits 1000 pulses per kWh, the current
+ *  power in W is getRate() * 3.6 / 1000.
+ *
+ * Returns: the rate in milli-pulses per second (mHz).
+ *
+ * Public
+ */
+uint32_t pwiPulseSensor::getRate()
+{
+	if( this->mode == PWI_PULSE_HARDWARE ){
+		return( pwiReached( this->last_ms, this->rate_timeout_ms, millis()) ? 0 : this->hw_rate );
+	}
+
+	uint32_t ts[PWI_PULSE_RATE_SAMPLES];
+	noInterrupts();
+	uint8_t count = this->ts_count;
+	uint8_t head = this->ts_head;
+	uint32_t last_ms = this->last_ms;
+	for( uint8_t i=0 ; i<count ; ++i ){
+		// ts[0] is the most recent timestamp
+		ts[i] = this->ts_us[( head + PWI_PULSE_RATE_SAMPLES - 1 - i ) % PWI_PULSE_RATE_SAMPLES];
+	}
+	interrupts();
+
+	if( !count || pwiReached( last_ms, this->rate_timeout_ms, millis())){
+		return( 0 );
+	}
+	uint32_t age = micros() - ts[0];
+	uint8_t intervals = 0;
+	uint32_t span = 0;
+	for( uint8_t i=1 ; i<count ; ++i ){
+		uint32_t d = ts[0] - ts[i];
+		if( this->rate_window_ms && d > 1000UL * this->rate_window_ms ){
+			break;
+		}
+		intervals = i;
+		span = d;
+	}
+	// at least two pulses are needed to estimate a rate
+	if( !intervals || !span ){
+		return( 0 );
+	}
+	uint32_t rate = ( uint64_t ) intervals * 1000000000ULL / span;
+	// decay when the next pulse is later than expected
+	if(( uint64_t ) age * intervals > span ){
+		rate = 1000000000UL / age;
+	}
+	return( rate );
+}
+
+/**
+ * pwiPulseSensor::setDebounce():
+ * @strategy: the debounce strategy.
+ * @param: the strategy parameter, see pwiDebounce::setup().
+ *
+ * Note: in interrupt mode, only the lockout strategy is relevant.
+ *
+ * Public
+ */
+void pwiPulseSensor::setDebounce( uint8_t strategy, uint32_t param )
+{
+    this->debounce.setup( strategy, param );
 }
 
 /**
  * pwiPulseSensor::setEdge():
+ *
+ * The debounce lockout is only started by the counted edge, in polling mode
+ * as in interrupt mode.
  * 
  * Public
  */
 void pwiPulseSensor::setEdge( uint8_t edge )
 {
     this->edge = edge;
+    this->debounce.setActiveLevel( edge == FALLING ? LOW : ( edge == RISING ? HIGH : PWI_DEBOUNCE_ANY_LEVEL ));
+    if( this->mode == PWI_PULSE_INTERRUPT ){
+        this->attach();
+    } else if( this->mode == PWI_PULSE_HARDWARE ){
+        this->setHardwareCounter( this->counter );
+    }
+}
+
+/**
+ * pwiPulseSensor::setHardwareCounter():
+ * @counter: [allow-none]: the hardware counter; %NULL to go back to polling.
+ *
+ * Let the pulses be counted by the @counter, which is (re)started.
+ * The input pin must be the external clock input of the counter.
+ * The pulses already counted are kept.
+ *
+ * Note: the debounce engine is not used in this mode: the input should be
+ *  debounced in hardware if needed.
+ *
+ * Returns: %TRUE if the @counter has been started.
+ *
+ * Public
+ */
+bool pwiPulseSensor::setHardwareCounter( pwiHwCounter *counter )
+{
+    // consolidate the current count before switching
+    uint32_t count = this->getPulsesCount();
+    if( this->mode == PWI_PULSE_INTERRUPT ){
+        this->setInterruptMode( false );
+    } else if( this->mode == PWI_PULSE_HARDWARE ){
+        this->counter->end();
+        this->mode = PWI_PULSE_POLLING;
+    }
+    noInterrupts();
+    this->imp_count = count;
+    interrupts();
+
+    if( !counter ){
+        this->debounce.reset( digitalRead( this->input_pin ), micros());
+        return( true );
+    }
+    if( !counter->begin( this->edge )){
+        return( false );
+    }
+    this->counter = counter;
+    this->hw_base = counter->getCount();
+    this->hw_rate_count = count;
+    this->hw_rate_us = micros();
+    this->hw_rate = 0;
+    this->mode = PWI_PULSE_HARDWARE;
+    return( true );
 }
 
 /**
@@ -88,30 +421,159 @@ void pwiPulseSensor::setEdge( uint8_t edge )
  */
 void pwiPulseSensor::setInputPin( uint8_t input_pin )
 {
+    if( this->mode == PWI_PULSE_INTERRUPT ){
+        this->detach();
+    }
     this->input_pin = input_pin;
 	if( input_pin ){
 		digitalWrite( input_pin, HIGH );
 		pinMode( input_pin, INPUT );
+		this->debounce.reset( digitalRead( input_pin ), micros());
+	}
+    if( this->mode == PWI_PULSE_INTERRUPT && !this->attach()){
+        this->mode = PWI_PULSE_POLLING;
+    }
+}
+
+/**
+ * pwiPulseSensor::setInterruptMode():
+ * @enabled: whether edges should be counted by an interrupt service routine.
+ *
+ * The interrupt mode requires the input pin to support external interrupts,
+ * i.e. digitalPinToInterrupt() must return a valid interrupt number, lesser
+ * than PWI_PULSE_MAX_INTERRUPTS. Else, the sensor stays in polling mode.
+ *
+ * The interrupt mode cannot be set while a hardware counter is used.
+ *
+ * Returns: %TRUE if the requested mode has been set.
+ *
+ * Public
+ */
+bool pwiPulseSensor::setInterruptMode( bool enabled )
+{
+    if( this->mode == PWI_PULSE_HARDWARE ){
+        return( !enabled );
+    }
+    if( enabled ){
+        if( this->mode == PWI_PULSE_INTERRUPT ){
+            return( true );
+        }
+        if( !this->attach()){
+            return( false );
+        }
+        this->mode = PWI_PULSE_INTERRUPT;
+    } else if( this->mode == PWI_PULSE_INTERRUPT ){
+        this->detach();
+        this->mode = PWI_PULSE_POLLING;
+        this->debounce.reset( digitalRead( this->input_pin ), micros());
+    }
+    return( true );
+}
+
+/**
+ * pwiPulseSensor::setPersistence():
+ * @ring: [allow-none]: the EEPROM ring where the pulses count is to be saved,
+ *  which must have been setup; %NULL to disable the persistence.
+ * @delta: save the count when it has increased by at least @delta pulses;
+ *  zero to disable this threshold.
+ * @period_ms: save the count when it has changed since @period_ms; zero to
+ *  disable this threshold.
+ * @min_interval_ms: the min interval between two writes, which so bounds the
+ *  EEPROM write rate.
+ *
+ * Restore the pulses count from the @ring, and let it be saved on time or
+ * delta thresholds from loopInput().
+ *
+ * Returns: %TRUE if a previously saved count has been restored.
+ *
+ * Public
+ */
+bool pwiPulseSensor::setPersistence( pwiEepromRing *ring, uint32_t delta, uint32_t period_ms, uint32_t min_interval_ms )
+{
+	bool restored = false;
+	uint32_t count;
+
+	this->ring = ring;
+	this->persist_delta = delta;
+	this->persist_period_ms = period_ms;
+	this->persist_min_ms = min_interval_ms;
+	if( ring && ring->restore( count )){
+		this->restoreCount( count );
+		this->saved_count = count;
+		restored = true;
 	}
+	this->saved_ms = millis();
+	return( restored );
 }
 
 /**
  * pwiPulseSensor::setPulseLength():
  *
- * Set the length of the impulsion in ms
+ * Set the length of the impulsion in ms, i.e. configure a lockout debounce
+ * strategy with this delay: the input is ignored during this delay after
+ * each counted edge.
  * 
  * Public
  */
 void pwiPulseSensor::setPulseLength( uint8_t length_ms )
 {
-    this->length_ms = length_ms;
+    this->debounce.setup( PWI_DEBOUNCE_LOCKOUT, 1000UL * length_ms );
+}
+
+/**
+ * pwiPulseSensor::setRateTimeout():
+ * @timeout_ms: the delay without any pulse after which the rate is zero;
+ *  this is bounded to one hour.
+ *
+ * Public
+ */
+void pwiPulseSensor::setRateTimeout( uint32_t timeout_ms )
+{
+    this->rate_timeout_ms = min( timeout_ms, ( uint32_t ) MAX_RATE_TIMEOUT );
+}
+
+/**
+ * pwiPulseSensor::setRateWindow():
+ * @window_ms: only the pulses which are less than @window_ms older than the
+ *  last one are taken into account to estimate the rate; zero to take into
+ *  account all recorded pulses.
+ *
+ * Public
+ */
+void pwiPulseSensor::setRateWindow( uint32_t window_ms )
+{
+    this->rate_window_ms = window_ms;
+}
+
+/**
+ * pwiPulseSensor::setTrigger():
+ * @pulses: the count of new pulses which triggers an immediate measure and
+ *  send; zero to disable the trigger.
+ * @min_spacing_ms: the min delay between two triggered sends, so that the
+ *  radio cannot be flooded.
+ *
+ * The trigger is evaluated by loopInput().
+ *
+ * Public
+ */
+void pwiPulseSensor::setTrigger( uint32_t pulses, uint32_t min_spacing_ms )
+{
+    this->trigger_pulses = pulses;
+    this->trigger_spacing_ms = min_spacing_ms;
+    this->trigger_count = this->getPulsesCount();
+    this->trigger_ms = millis();
 }
 
 /**
  * pwiPulseSensor::loopInput():
  * 
  * Test for a falling/rising edge on the input pin: this is counted as *one* impulsion
- * Debouncing: do not even look at the pin state during the length of last impulsion
+ * Debouncing: the pin state is fed to the debounce engine, and only the
+ *  changes of the debounced state are taken into account
+ *
+ * In interrupt mode, edges have already been counted by the interrupt service
+ * routine: just check whether the count has changed since the last call.
+ * Same with a hardware counter, which also computes the rate here.
  *
  * Returns true if a pulse has been detected
  * 
@@ -120,23 +582,171 @@ void pwiPulseSensor::setPulseLength( uint8_t length_ms )
 bool pwiPulseSensor::loopInput()
 {
 	bool isEdge = false;
-	uint32_t now = millis();
-	uint32_t start_ms = this->last_ms + this->length_ms;
-	if( now > start_ms ){
-		uint8_t state = digitalRead( this->input_pin );
-
-		isEdge = ( this->edge == FALLING && state == LOW && this->last_state == HIGH )
-					|| ( this->edge == RISING && state == HIGH && this->last_state == LOW );
-
-		if( isEdge ){
-			this->imp_count += 1;
-			this->last_ms = now;
-#ifdef SENSOR_DEBUG
-			Serial.print( F( "edge detected count=" ));
-			Serial.println( this->imp_count );
+
+#ifdef PWI_PROFILER
+	pwiProfiler::Input( this->getId(), this->profiler_us );
 #endif
+
+	if( this->mode == PWI_PULSE_INTERRUPT || this->mode == PWI_PULSE_HARDWARE ){
+		uint32_t count = this->getPulsesCount();
+		isEdge = ( count != this->last_count );
+		this->last_count = count;
+		if( this->mode == PWI_PULSE_HARDWARE ){
+			this->loopHardware( count, isEdge );
 		}
-		this->last_state = state;
+
+	} else {
+		uint32_t now_us = micros();
+		if( this->debounce.sample( digitalRead( this->input_pin ), now_us )){
+			uint8_t state = this->debounce.getState();
+
+			isEdge = ( this->edge == FALLING && state == LOW )
+						|| ( this->edge == RISING && state == HIGH );
+
+			if( isEdge ){
+				this->addPulse( millis(), now_us );
+				PWI_LOG( PULSE_EDGE, this->getId(), this->imp_count );
+			}
+		}
+	}
+
+	if( this->trigger_pulses ){
+		this->loopTrigger( this->getPulsesCount());
+	}
+	if( this->ring ){
+		this->loopPersist();
 	}
 	return isEdge;
 }
+
+/*
+ * pwiPulseSensor::loopHardware():
+ * @count: the current pulses count.
+ * @changed: whether the count has changed since the last call.
+ *
+ * Compute the rate at the end of each rate window.
+ * As there is no pulse timestamp in this mode, the timestamp of the last
+ * pulse is approximated as the time at which a count change is detected.
+ *
+ * Private
+ */
+void pwiPulseSensor::loopHardware( uint32_t count, bool changed )
+{
+	uint32_t now_us = micros();
+	if( changed ){
+		this->last_ms = millis();
+	}
+	uint32_t window_us = 1000UL * ( this->rate_window_ms ? this->rate_window_ms : DEFAULT_HW_RATE_WINDOW );
+	uint32_t elapsed = pwiElapsed( this->hw_rate_us, now_us );
+	if( elapsed >= window_us ){
+		this->hw_rate = ( uint64_t )( count - this->hw_rate_count ) * 1000000000ULL / elapsed;
+		this->hw_rate_count = count;
+		this->hw_rate_us = now_us;
+	}
+}
+
+/*
+ * pwiPulseSensor::loopTrigger():
+ * @count: the current pulses count.
+ *
+ * Request an immediate measure and send when the threshold is reached, and
+ * the min spacing has elapsed since the last triggered send.
+ *
+ * Private
+ */
+void pwiPulseSensor::loopTrigger( uint32_t count )
+{
+	uint32_t now = millis();
+	if( count - this->trigger_count >= this->trigger_pulses && pwiReached( this->trigger_ms, this->trigger_spacing_ms, now )){
+		this->trigger_count = count;
+		this->trigger_ms = now;
+		PWI_LOG( PULSE_TRIGGER, this->getId(), count );
+		this->measureAndSend();
+	}
+}
+
+/*
+ * pwiPulseSensor::loopPersist():
+ *
+ * Checkpoint the pulses count to EEPROM when either the delta threshold is
+ * reached, or the checkpoint period has elapsed while the count has changed.
+ * In all cases, there is at least the min interval between two writes.
+ *
+ * Private
+ */
+void pwiPulseSensor::loopPersist()
+{
+	uint32_t now = millis();
+	uint32_t elapsed = pwiElapsed( this->saved_ms, now );
+	if( elapsed < this->persist_min_ms ){
+		return;
+	}
+	uint32_t delta = this->getPulsesCount() - this->saved_count;
+	if(( this->persist_delta && delta >= this->persist_delta )
+			|| ( delta && this->persist_period_ms && elapsed >= this->persist_period_ms )){
+		this->checkpoint();
+	}
+}
+
+/*
+ * pwiPulseSensor::restoreCount():
+ * @count: the restored pulses count.
+ *
+ * Reset the pulses count to the restored value.
+ *
+ * Private
+ */
+void pwiPulseSensor::restoreCount( uint32_t count )
+{
+	noInterrupts();
+	this->imp_count = count;
+	interrupts();
+	if( this->mode == PWI_PULSE_HARDWARE ){
+		this->hw_base = this->counter->getCount();
+		this->hw_rate_count = count;
+	}
+	this->last_count = count;
+	this->trigger_count = count;
+}
+
+/*
+ * pwiPulseSensor::vRestoreState():
+ * @buffer: the state saved by vSaveState().
+ * @size: the size of the saved state.
+ *
+ * Restore the pulses count from the warm-start snapshot, unless the EEPROM
+ * ring has already restored a greater one.
+ *
+ * Protected
+ */
+void pwiPulseSensor::vRestoreState( const uint8_t *buffer, uint8_t size )
+{
+	uint32_t count;
+	if( size == sizeof( count )){
+		memcpy( &count, buffer, sizeof( count ));
+		if( count > this->getPulsesCount()){
+			this->restoreCount( count );
+		}
+	}
+}
+
+/*
+ * pwiPulseSensor::vSaveState():
+ * @buffer: the buffer to be filled.
+ * @size: the size of the @buffer.
+ *
+ * Save the pulses count into the warm-start snapshot.
+ *
+ * Returns: the count of written bytes.
+ *
+ * Protected
+ */
+uint8_t pwiPulseSensor::vSaveState( uint8_t *buffer, uint8_t size )
+{
+	uint32_t count = this->getPulsesCount();
+	if( size < sizeof( count )){
+		return( 0 );
+	}
+	memcpy( buffer, &count, sizeof( count ));
+	return( sizeof( count ));
+}
@@ -5,12 +5,65 @@
  * A Pulse sensor is a sensor which counts impulsions on a given pin.
  * Impulsions are detected at loop time by just reading the pin state.
  * Impulsions can be detected on FALLING or RISING edge.
+ * The input is debounced by a pwiDebounce engine, which defaults to a lockout
+ * of the pulse length (see setPulseLength() and setDebounce()).
+ *
+ * When the input pin supports external interrupts, impulsions may rather be
+ * counted by an interrupt service routine, so that they are not lost when
+ * the main loop is too slow (see setInterruptMode()). loopInput() should yet
+ * be called in order to know when new pulses have been counted.
+ *
+ * For high-frequency inputs, a hardware timer/counter clocked from the input
+ * pin may count the pulses instead (see setHardwareCounter(), and build with
+ * PWI_HW_COUNTER to enable the AVR Timer1 backend).
+ *
+ * The timestamps of the last pulses are kept in a ring buffer, from which an
+ * instantaneous rate is estimated (see getRate()). In interrupt mode, the
+ * timestamps are taken by the interrupt service routine, so the rate is
+ * accurate whatever be the main loop period.
+ *
+ * A threshold may also be set, so that the measure is immediately taken and
+ * sent when enough new pulses have been counted, without waiting for the next
+ * min period (see setTrigger()).
+ *
+ * The pulses count may be persisted in a wear-leveled EEPROM ring, so that
+ * the meter reading survives a reboot (see setPersistence()).
  * 
  * pwi 2025- 3-22 creation
  * pwi 2025- 7-31 add bounce protection
+ * pwi 2026-10-18 interrupt-driven counting mode
+ *                instantaneous rate estimation
+ *                wear-leveled EEPROM persistence of the pulses count
+ *                use pwiDebounce engine
+ *                hardware counter backend
+ *                immediate send on pulses count threshold
+ *                loopInput() gaps are measured by the pwiProfiler
+ *                the pulses count is saved in the warm-start snapshot
  */
 
 #include "pwiSensor.h"
+#include "pwiDebounce.h"
+#include "pwiEepromRing.h"
+#include "pwiHwCounter.h"
+
+/* the count of external interrupts which may be used by pwiPulseSensor's,
+ * i.e. the max interrupt number plus one (2 on an Arduino Uno, 6 on a Mega)
+ */
+#ifndef PWI_PULSE_MAX_INTERRUPTS
+#define PWI_PULSE_MAX_INTERRUPTS        2
+#endif
+
+/* the count of pulse timestamps kept to estimate the rate
+ */
+#ifndef PWI_PULSE_RATE_SAMPLES
+#define PWI_PULSE_RATE_SAMPLES          8
+#endif
+
+enum {
+    PWI_PULSE_POLLING = 0,                      // the pin is read by loopInput()
+    PWI_PULSE_INTERRUPT,                        // edges are counted by an interrupt service routine
+    PWI_PULSE_HARDWARE                          // edges are counted by a hardware counter
+};
 
 class pwiPulseSensor : public pwiSensor {
 	public:
@@ -19,32 +72,94 @@ class pwiPulseSensor : public pwiSensor {
 
 		/* getters
 		 */
+		pwiDebounce &getDebounce();
 		uint8_t		getEdge();
         uint8_t     getInputPin();
+        uint8_t     getMode();
 		uint32_t    getPulsesCount();
+		uint32_t    getRate();
 
 		/* actors
 		 */
+        void        checkpoint();
         bool        loopInput();
 
 		/* setters
 		 */
+		void        setDebounce( uint8_t strategy, uint32_t param );
 		void        setEdge( uint8_t edge );
+		bool        setHardwareCounter( pwiHwCounter *counter );
 		void        setInputPin( uint8_t input_pin );
+		bool        setInterruptMode( bool enabled );
+		bool        setPersistence( pwiEepromRing *ring, uint32_t delta, uint32_t period_ms, uint32_t min_interval_ms=60000 );
 		void        setPulseLength( uint8_t length_ms );
+		void        setRateTimeout( uint32_t timeout_ms );
+		void        setRateWindow( uint32_t window_ms );
+		void        setTrigger( uint32_t pulses, uint32_t min_spacing_ms );
+
+	protected:
+        virtual void    vRestoreState( const uint8_t *buffer, uint8_t size );
+        virtual uint8_t vSaveState( uint8_t *buffer, uint8_t size );
 
 	private:
         // setup
         uint8_t     input_pin;
 		uint8_t 	edge;
-        uint8_t     length_ms;
+        uint8_t     mode;
+        pwiDebounce debounce;
+        uint32_t    rate_window_ms;
+        uint32_t    rate_timeout_ms;
 
         // runtime
-        uint8_t     last_state;
-        uint32_t    imp_count;
-        uint32_t    last_ms;
+        volatile uint32_t imp_count;
+        volatile uint32_t last_ms;              // millis() timestamp of the last pulse
+        volatile uint32_t last_us;              // micros() timestamp of the last pulse
+        uint32_t    last_count;
+        volatile uint32_t ts_us[PWI_PULSE_RATE_SAMPLES];
+        volatile uint8_t  ts_head;              // index of the next timestamp
+        volatile uint8_t  ts_count;
+
+        // hardware counter
+        pwiHwCounter *counter;
+        uint32_t    hw_base;                    // hardware count which corresponds to imp_count
+        uint32_t    hw_rate_count;              // count at the start of the rate window
+        uint32_t    hw_rate_us;                 // timestamp of the start of the rate window
+        uint32_t    hw_rate;
+
+        // threshold trigger
+        uint32_t    trigger_pulses;
+        uint32_t    trigger_spacing_ms;
+        uint32_t    trigger_count;              // count at the last trigger
+        uint32_t    trigger_ms;                 // millis() timestamp of the last trigger
+
+        // persistence
+        pwiEepromRing *ring;
+        uint32_t    persist_delta;
+        uint32_t    persist_period_ms;
+        uint32_t    persist_min_ms;
+        uint32_t    saved_count;
+        uint32_t    saved_ms;
+
+#ifdef PWI_PROFILER
+        uint32_t    profiler_us;                // micros() timestamp of the last loopInput()
+#endif
 
 		void 		init();
+        void        addPulse( uint32_t now_ms, uint32_t now_us );
+        bool        attach();
+        void        detach();
+        void        loopHardware( uint32_t count, bool changed );
+        void        restoreCount( uint32_t count );
+        void        loopPersist();
+        void        loopTrigger( uint32_t count );
+        void        onInterrupt();
+
+        // interrupt dispatching, indexed by interrupt number
+        static pwiPulseSensor *IsrSensors[PWI_PULSE_MAX_INTERRUPTS];
+        static void ( * const IsrTrampolines[PWI_PULSE_MAX_INTERRUPTS] )( void );
+
+        template<uint8_t N>
+        static void Isr( void ) { IsrSensors[N]->onInterrupt(); }
 };
 
 #endif // __PWI_PULSE_SENSOR_H__
@@ -0,0 +1,297 @@
+/*
+ * pwi 2026-10-18 creation
+ *                debug traces are written to the pwiLog binary ring
+ *                messages which cannot be queued go through the transport
+ *                retries are flushed from the radio thread with PWI_THREADS
+ *                the retry timer is restarted with the new backoff delay
+ */
+
+#include <core/MySensorsCore.h>
+#include "pwiSendQueue.h"
+#include "pwiLog.h"
+
+#define DEFAULT_BATCH           4
+#define DEFAULT_MIN_BACKOFF     1000
+#define DEFAULT_MAX_BACKOFF     300000
+
+/**
+ * pwiSendQueue::pwiSendQueue:
+ * @items: the storage of the queue, provided by the caller.
+ * @size: the count of items in @items.
+ *
+ * Constructor.
+ *
+ * Public.
+ */
+pwiSendQueue::pwiSendQueue( pwiSendQueueItem *items, uint8_t size )
+{
+    /* setup
+     */
+    this->items = items;
+    this->size = items ? size : 0;
+    this->batch = DEFAULT_BATCH;
+    this->min_backoff_ms = DEFAULT_MIN_BACKOFF;
+    this->max_backoff_ms = DEFAULT_MAX_BACKOFF;
+    this->transport = pwiSendQueue::SendMessage;
+    this->transport_data = NULL;
+
+    /* runtime
+     */
+    this->head = 0;
+    this->count = 0;
+    this->dropped = 0;
+    this->backoff_ms = this->min_backoff_ms;
+}
+
+/**
+ * pwiSendQueue::getCount:
+ *
+ * Returns: the count of measures currently waiting in the queue.
+ *
+ * Public.
+ */
+uint8_t pwiSendQueue::getCount( void )
+{
+    return( this->count );
+}
+
+/**
+ * pwiSendQueue::getDropped:
+ *
+ * Returns: the count of measures which have been dropped because the queue
+ * was full.
+ *
+ * Public.
+ */
+uint32_t pwiSendQueue::getDropped( void )
+{
+    return( this->dropped );
+}
+
+/**
+ * pwiSendQueue::getSize:
+ *
+ * Returns: the capacity of the queue.
+ *
+ * Public.
+ */
+uint8_t pwiSendQueue::getSize( void )
+{
+    return( this->size );
+}
+
+/**
+ * pwiSendQueue::flush:
+ *
+ * Try to send a batch of the oldest queued measures.
+ * Stop on the first failure.
+ *
+ * Returns: the count of measures which have been sent.
+ *
+ * Public.
+ */
+uint8_t pwiSendQueue::flush( void )
+{
+    uint8_t sent = 0;
+    while( this->count && sent < this->batch ){
+        if( !this->sendItem( &this->items[this->head] )){
+            break;
+        }
+        this->head = ( this->head + 1 ) % this->size;
+        this->count -= 1;
+        sent += 1;
+    }
+    PWI_LOG( QUEUE_FLUSH, this, sent, this->count );
+    return( sent );
+}
+
+/**
+ * pwiSendQueue::send:
+ * @msg: the message to be sent.
+ *
+ * Send the @msg message if the queue is empty, else (or if the send fails)
+ *  queue it to be sent later.
+ *
+ * A message whose payload is too long to be queued is sent immediately
+ *  through the transport, and lost if the send fails.
+ *
+ * Returns: %PWI_SEND_QUEUE_SENT, %PWI_SEND_QUEUE_QUEUED, or the error code.
+ *
+ * Public.
+ */
+uint8_t pwiSendQueue::send( MyMessage &msg )
+{
+    if( msg.getLength() > PWI_SEND_QUEUE_PAYLOAD || !this->size ){
+        return( this->transport( msg, millis(), this->transport_data ) ? PWI_SEND_QUEUE_SENT : PWI_SEND_QUEUE_ERR01 );
+    }
+    this->push( msg );
+    // only try to send immediately if no older measure is waiting
+    if( this->count == 1 && this->flush()){
+        return( PWI_SEND_QUEUE_SENT );
+    }
+    if( !this->retry_timer.isStarted()){
+        this->schedule( this->backoff_ms );
+    }
+    return( PWI_SEND_QUEUE_QUEUED );
+}
+
+/**
+ * pwiSendQueue::setBackoff:
+ * @min_ms: the initial retry delay.
+ * @max_ms: the max retry delay.
+ *
+ * Configure the exponential backoff: the retry delay is doubled after each
+ *  failure, up to @max_ms, and reset to @min_ms after a success.
+ *
+ * Public.
+ */
+void pwiSendQueue::setBackoff( unsigned long min_ms, unsigned long max_ms )
+{
+    this->min_backoff_ms = min_ms ? min_ms : 1;
+    this->max_backoff_ms = max( max_ms, this->min_backoff_ms );
+    this->backoff_ms = this->min_backoff_ms;
+}
+
+/**
+ * pwiSendQueue::setBatch:
+ * @count: the max count of measures to be sent on each retry.
+ *
+ * Public.
+ */
+void pwiSendQueue::setBatch( uint8_t count )
+{
+    this->batch = count ? count : 1;
+}
+
+/**
+ * pwiSendQueue::setTransport:
+ * @cb: the transport function, or %NULL to reset to the MySensors send().
+ * @user_data: the data to be passed to @cb.
+ *
+ * Public.
+ */
+void pwiSendQueue::setTransport( pwiSendQueueTransportCb cb, void *user_data )
+{
+    this->transport = cb ? cb : pwiSendQueue::SendMessage;
+    this->transport_data = user_data;
+}
+
+/**
+ * pwiSendQueue::SendMessage:
+ * @msg: the message to be sent.
+ * @ts_ms: the millis() timestamp of the measure; not used.
+ * @user_data: not used.
+ *
+ * The default transport: send the message through MySensors.
+ * Do not even try to send while the transport is not ready.
+ *
+ * Returns: %TRUE if the message has been sent.
+ *
+ * Public Static.
+ */
+bool pwiSendQueue::SendMessage( MyMessage &msg, uint32_t ts_ms, void *user_data )
+{
+    if( !isTransportReady()){
+        return( false );
+    }
+    return( ::send( msg ));
+}
+
+/*
+ * pwiSendQueue::push:
+ * @msg: the message to be queued.
+ *
+ * Append a copy of the @msg to the queue, dropping the oldest item if the
+ *  queue is full.
+ *
+ * Private.
+ */
+void pwiSendQueue::push( MyMessage &msg )
+{
+    if( this->count == this->size ){
+        this->head = ( this->head + 1 ) % this->size;
+        this->count -= 1;
+        this->dropped += 1;
+    }
+    pwiSendQueueItem *item = &this->items[( this->head + this->count ) % this->size];
+    item->ts_ms = millis();
+    item->sensor = msg.getSensor();
+    item->type = msg.getType();
+    item->payload_type = msg.getPayloadType();
+    item->length = msg.getLength();
+    memcpy( item->payload, msg.getCustom(), item->length );
+    this->count += 1;
+}
+
+/*
+ * pwiSendQueue::sendItem:
+ * @item: the queued item to be sent.
+ *
+ * Rebuild the message from the @item, and send it through the transport.
+ *
+ * Returns: %TRUE if the message has been sent.
+ *
+ * Private.
+ */
+bool pwiSendQueue::sendItem( const pwiSendQueueItem *item )
+{
+    MyMessage msg( item->sensor, ( mysensors_data_t ) item->type );
+    msg.set( item->payload, item->length );
+    msg.setPayloadType(( mysensors_payload_t ) item->payload_type );
+    return( this->transport( msg, item->ts_ms, this->transport_data ));
+}
+
+/*
+ * pwiSendQueue::schedule:
+ * @delay_ms: the delay before next retry.
+ *
+ * Private.
+ */
+void pwiSendQueue::schedule( unsigned long delay_ms )
+{
+    this->retry_timer.setup( "SendQueue", delay_ms, false, ( pwiTimerCb ) pwiSendQueue::OnRetryCb, this );
+    this->retry_timer.start();
+}
+
+/*
+ * pwiSendQueue::OnRetryCb:
+ *
+ * Flush a batch of queued measures.
+ * On failure, double the backoff delay.
+ * On success, reset the backoff and go on with the next batch if any.
+ *
+ * Note: the @retry_timer is a periodic timer, which is explicitly restarted
+ *  from now with the new backoff delay, or stopped when the queue is empty.
+ *
+ * Note: with PWI_THREADS, the timer callbacks run on a worker, while the
+ *  measures are pushed from the radio thread: the flush is then posted to the
+ *  radio thread, so that the queue is only ever accessed from there. The
+ *  worker has then already restarted the timer with the previous delay when
+ *  the flush runs, hence the explicit restart.
+ *
+ * Private Static.
+ */
+void pwiSendQueue::OnRetryCb( pwiSendQueue *queue )
+{
+#ifdef PWI_THREADS
+    if( !pwiThreads::IsRadioThread()){
+        pwiThreads::PostRadio(( pwiThreadsJobCb ) pwiSendQueue::OnRetryCb, queue );
+        return;
+    }
+#endif
+    uint8_t expected = min( queue->count, queue->batch );
+    uint8_t sent = queue->flush();
+    if( sent < expected ){
+        queue->backoff_ms = min( 2*queue->backoff_ms, queue->max_backoff_ms );
+    } else {
+        queue->backoff_ms = queue->min_backoff_ms;
+    }
+    if( queue->count ){
+        // restart from now with the new delay: with PWI_THREADS, the worker
+        // has already restarted the timer with the previous one
+        queue->retry_timer.setDelay( queue->backoff_ms );
+        queue->retry_timer.restart();
+    } else {
+        queue->retry_timer.setDelay( 0 );
+    }
+}
@@ -0,0 +1,135 @@
+#ifndef __PWI_SEND_QUEUE_H__
+#define __PWI_SEND_QUEUE_H__
+
+/*
+ * A bounded store-and-forward queue of measures.
+ *
+ * When the radio link or the gateway is down, the measures which cannot be
+ * sent are kept in a circular queue with their timestamp. Sending is retried
+ * with an exponential backoff, and the queue is flushed by batches once the
+ * link is back. When the queue is full, the oldest measure is dropped first.
+ *
+ * The queue storage is provided by the caller, so that its size is known
+ * at compile time. Each item keeps a compact copy of the message: only
+ * payloads up to PWI_SEND_QUEUE_PAYLOAD bytes (i.e. numeric values, floats
+ * included, by default) can be queued.
+ *
+ * By default, messages are sent through the MySensors send() function.
+ * Another transport may be provided, e.g. to simulate the radio link on the
+ * host, or to forward the age of the measure along with its value. All the
+ * messages go through the transport, even those which cannot be queued.
+ *
+ * Usage synopsys:
+ *
+ * a) define the queue and its storage:
+ *    pwiSendQueueItem myItems[16];
+ *    pwiSendQueue myQueue( myItems, 16 );
+ *
+ * b) attach the queue to the sensors:
+ *    mySensor.setSendQueue( &myQueue );
+ *
+ * c) in vSend(), send the messages through the sensor:
+ *    this->sendMessage( msg.set( value ));
+ *
+ * Retries are driven by a pwiTimer, so pwiTimer::Loop() must be called from
+ * the main loop. With PWI_THREADS, the queue must only be used from the radio
+ * thread (which is the case when sending through a sensor): the retries are
+ * posted there with pwiThreads::PostRadio(), so pwiThreads::RadioLoop() must
+ * be called from the main loop too.
+ *
+ * pwi 2026-10-18 creation
+ *                default payload size fits a float
+ *                the transport receives the rebuilt message
+ *                retries are flushed from the radio thread with PWI_THREADS
+ */
+
+#include "pwiTimer.h"
+
+class MyMessage;
+
+/* the max payload size which can be queued: a float is 5 bytes long (the
+ * value and its precision)
+ */
+#ifndef PWI_SEND_QUEUE_PAYLOAD
+#define PWI_SEND_QUEUE_PAYLOAD          5
+#endif
+
+enum {
+    PWI_SEND_QUEUE_SENT = 0,                    // the message has been sent
+    PWI_SEND_QUEUE_QUEUED,                      // the message has been queued to be sent later
+    PWI_SEND_QUEUE_ERR01                        // the payload is too long to be queued, and the send has failed
+};
+
+/* a compact copy of a message
+ */
+typedef struct {
+    uint32_t    ts_ms;                          // millis() at enqueue time
+    uint8_t     sensor;
+    uint8_t     type;
+    uint8_t     payload_type;
+    uint8_t     length;
+    uint8_t     payload[PWI_SEND_QUEUE_PAYLOAD];
+}
+    pwiSendQueueItem;
+
+/* The prototype of the transport function.
+   It receives the message to be sent, the millis() timestamp of the measure
+   and the 'user_data' provided at setTransport() time, and returns %TRUE if
+   the message has been sent.
+ */
+typedef bool ( *pwiSendQueueTransportCb )( MyMessage &msg, uint32_t ts_ms, void *user_data );
+
+class pwiSendQueue {
+    public:
+                                  pwiSendQueue( pwiSendQueueItem *items, uint8_t size );
+
+		/* getters
+		 */
+                uint8_t           getCount( void );
+                uint32_t          getDropped( void );
+                uint8_t           getSize( void );
+
+		/* actors
+		 */
+                uint8_t           flush( void );
+                uint8_t           send( MyMessage &msg );
+
+		/* setters
+		 */
+                void              setBackoff( unsigned long min_ms, unsigned long max_ms );
+                void              setBatch( uint8_t count );
+                void              setTransport( pwiSendQueueTransportCb cb, void *user_data=NULL );
+
+        /* static methods
+         */
+        static  bool              SendMessage( MyMessage &msg, uint32_t ts_ms, void *user_data );
+
+    private:
+        /* setup
+         */
+                pwiSendQueueItem *items;
+                uint8_t           size;
+                uint8_t           batch;
+                unsigned long     min_backoff_ms;
+                unsigned long     max_backoff_ms;
+                pwiSendQueueTransportCb transport;
+                void             *transport_data;
+
+        /* runtime
+         */
+                uint8_t           head;             // index of the oldest item
+                uint8_t           count;
+                uint32_t          dropped;
+                unsigned long     backoff_ms;
+                pwiTimer          retry_timer;
+
+        /* private methods
+         */
+                void              push( MyMessage &msg );
+                bool              sendItem( const pwiSendQueueItem *item );
+                void              schedule( unsigned long delay_ms );
+
+        static  void              OnRetryCb( pwiSendQueue *queue );
+};
+
+#endif // __PWI_SEND_QUEUE_H__
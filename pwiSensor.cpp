@@ -28,16 +28,44 @@
  *                BREAKING CHANGE: replace sendCb() method by protected virtual vSend()
  *                BREAKING CHANGE: remove setup() method
  *                new setMeasureCb(), setSendCb() methods
+ * pwi 2026-10-18 optional runtime statistics (define PWI_SENSOR_STATS)
+ *                new setSendQueue() and sendMessage() methods
+ *                new protected measureAndSend() method
+ *                debug traces are written to the pwiLog binary ring
+ *                wrap-safe durations
+ *                vSend() is serialized onto the radio thread with PWI_THREADS
+ *                the registry of the sensors is unconditional
+ *                new vSaveState(), vRestoreState() virtuals
+ *                new getGroup() method
+ *                fix the timer labels which were pointing to the stack
+ *                the timer labels are built into the sensor
+ *                the sensor id is only added to the timer labels when reported
+ *                priority and overload-aware load shedding
+ *                setMinPeriod() leaves the min timer of a grouped sensor alone
  */
 
 #include <core/MySensorsCore.h>
 #include "pwiSensor.h"
+#include "pwiLog.h"
 
-// uncomment to debugging this file
-//#define SENSOR_DEBUG
+// the timers keep a pointer to their label: all the sensors share the same
+// ones, and GetTimerLabel() adds the sensor id when the label is reported
+static char const strMinTimer[] = "MinTimer";
+static char const strMaxTimer[] = "MaxTimer";
 
-static char const strMinTimer[] PROGMEM = "MinTimer #";
-static char const strMaxTimer[] PROGMEM = "MaxTimer #";
+// single linked list of allocated pwiSensor's
+pwiList pwiSensor::list;
+
+// load shedding
+uint8_t  pwiSensor::shed_level = 0;
+uint8_t  pwiSensor::shed_high = 100;
+uint8_t  pwiSensor::shed_low = 0;
+uint32_t pwiSensor::shed_events = 0;
+
+#ifdef PWI_SENSOR_STATS
+// the diagnostic child identifier
+uint8_t pwiSensor::stats_id = 0;
+#endif
 
 /**
  * pwiSensor::pwiSensor:
@@ -56,7 +84,7 @@ pwiSensor::pwiSensor( uint8_t id )
 {
     this->init();
 
-    this->id = id;
+    this->setId( id );
 }
 
 /*
@@ -65,6 +93,107 @@ pwiSensor::pwiSensor( uint8_t id )
 void pwiSensor::init( void )
 {
     this->id = 0;
+    this->priority = PWI_SENSOR_PRIORITY_NORMAL;
+    this->min_period_ms = 0;
+    this->queue = NULL;
+    this->group = NULL;
+
+#ifdef PWI_SENSOR_STATS
+    this->resetStats();
+#endif
+    // the registry is unconditional, see pwiSensor.h
+    pwiSensor::list.add( this );
+}
+
+/*
+ * Private pwiSensor::applyShedding:
+ *
+ * Apply the current shedding level to the min timer; the min timers of the
+ * members of a pwiSensorGroup are not used, and so are left unchanged.
+ */
+void pwiSensor::applyShedding( void )
+{
+    if( !this->group && this->min_period_ms ){
+        unsigned long delay_ms = this->getShedPeriod();
+        if( delay_ms != this->min_timer.getDelay()){
+            this->min_timer.setDelay( delay_ms );
+        }
+    }
+}
+
+/*
+ * Private pwiSensor::doMeasure:
+ *
+ * Take the measure through the vMeasure() virtual, maintaining the statistics.
+ *
+ * Returns: %TRUE if the measure has to be sent.
+ */
+bool pwiSensor::doMeasure( void )
+{
+#ifdef PWI_SENSOR_STATS
+    uint32_t start_us = micros();
+    bool changed = this->vMeasure();
+    uint32_t duration = pwiElapsed( start_us, micros());
+    this->stats.measures += 1;
+    this->stats.measure_total_us += duration;
+    if( duration > this->stats.measure_max_us ){
+        this->stats.measure_max_us = duration;
+    }
+    if( !changed ){
+        this->stats.suppressed += 1;
+    }
+    return( changed );
+#else
+    return( this->vMeasure());
+#endif
+}
+
+/*
+ * Private pwiSensor::doSend:
+ * @heartbeat: whether the send is triggered by the max period.
+ *
+ * Send the measure through the vSend() virtual, maintaining the statistics.
+ *
+ * When built with PWI_THREADS, vSend() is always called from the radio
+ * thread.
+ */
+void pwiSensor::doSend( bool heartbeat )
+{
+#ifdef PWI_THREADS
+    if( !pwiThreads::IsRadioThread()){
+        pwiThreads::PostRadio(( pwiThreadsJobCb )( heartbeat ? pwiSensor::RadioHeartbeatCb : pwiSensor::RadioSendCb ), this );
+        return;
+    }
+#endif
+#ifdef PWI_SENSOR_STATS
+    uint32_t start_us = micros();
+    this->vSend();
+    uint32_t duration = pwiElapsed( start_us, micros());
+    this->stats.sends += 1;
+    if( heartbeat ){
+        this->stats.heartbeats += 1;
+    }
+    this->stats.send_total_us += duration;
+    if( duration > this->stats.send_max_us ){
+        this->stats.send_max_us = duration;
+    }
+#else
+    this->vSend();
+#endif
+}
+
+/**
+ * pwiSensor::getGroup:
+ *
+ * Returns: the pwiSensorGroup the sensor is a member of, or %NULL; in the
+ * former case, the broadcast conversion has already been done when
+ * vMeasure() is called.
+ *
+ * Protected.
+ */
+pwiSensorGroup *pwiSensor::getGroup( void )
+{
+    return( this->group );
 }
 
 /**
@@ -103,6 +232,65 @@ pwiTimer &pwiSensor::getMinTimer()
     return( this->min_timer );
 }
 
+#ifdef PWI_SENSOR_STATS
+/**
+ * pwiSensor::getStats:
+ *
+ * Returns: a reference to the runtime statistics of the sensor.
+ *
+ * Public.
+ */
+const pwiSensorStats &pwiSensor::getStats( void )
+{
+    return( this->stats );
+}
+
+/**
+ * pwiSensor::resetStats:
+ *
+ * Reset the runtime statistics of the sensor.
+ *
+ * Public.
+ */
+void pwiSensor::resetStats( void )
+{
+    memset( &this->stats, 0, sizeof( this->stats ));
+}
+#endif
+
+/**
+ * pwiSensor::getPriority:
+ *
+ * Returns: the priority of the sensor.
+ *
+ * Public.
+ */
+uint8_t pwiSensor::getPriority( void )
+{
+    return( this->priority );
+}
+
+/*
+ * Private pwiSensor::getShedPeriod:
+ *
+ * Returns: the min period stretched according to the shedding level and the
+ * priority of the sensor, bounded by the max period.
+ */
+unsigned long pwiSensor::getShedPeriod( void )
+{
+    unsigned long delay_ms = this->min_period_ms;
+    unsigned long max_ms = this->max_timer.getDelay();
+    if( pwiSensor::shed_level > this->priority ){
+        for( uint8_t i=this->priority ; i<pwiSensor::shed_level && delay_ms < 0x80000000UL ; ++i ){
+            delay_ms <<= 1;
+        }
+        if( max_ms && delay_ms > max_ms ){
+            delay_ms = max( max_ms, this->min_period_ms );
+        }
+    }
+    return( delay_ms );
+}
+
 /**
  * pwiSensor::setId:
  * @id: the child identifier inside of this MySensor node; must be unique for
@@ -139,15 +327,14 @@ void pwiSensor::setId( uint8_t id )
  */
 uint8_t pwiSensor::setMaxPeriod( unsigned long delay_ms )
 {
-    unsigned long min_period = this->min_timer.getDelay();
-    if( delay_ms && ( delay_ms < min_period )){
+    if( delay_ms && ( delay_ms < this->min_period_ms )){
         return( PWI_SENSOR_ERR01 );
     }
 	// delay_ms may be zero
-    char label[1+MAX_PAYLOAD];
-    snprintf_P( label, sizeof( label ), PSTR( "%S%u" ), strMaxTimer, this->getId());
-    this->max_timer.setup( label, delay_ms, false, pwiSensor::OnMaxPeriodCb, this );
+    this->max_timer.setup( strMaxTimer, delay_ms, false, pwiSensor::OnMaxPeriodCb, this );
     this->max_timer.start();
+    // the stretched min period is bounded by the max period
+    this->applyShedding();
     return( PWI_SENSOR_OK );
 }
 
@@ -161,7 +348,9 @@ uint8_t pwiSensor::setMaxPeriod( unsigned long delay_ms )
  *  If greater than the max period, then an error is logged and returned. The
  *  previous min period is left unchanged.
  *
- * Configure and start the min timer.
+ * Configure and start the min timer; the min timer of a member of a
+ * pwiSensorGroup is not used, and is left stopped, the new period being
+ * only recorded.
  *
  * Returns: %PWI_SENSOR_OK if the timer has been successfully set, or the error
  * code.
@@ -175,13 +364,44 @@ uint8_t pwiSensor::setMinPeriod( unsigned long delay_ms )
         return( PWI_SENSOR_ERR02 );
     }
 	// delay_ms may be zero
-    char label[1+MAX_PAYLOAD];
-    snprintf_P( label, sizeof( label ), PSTR( "%S%u" ), strMinTimer, this->getId());
-    min_timer.setup( label, delay_ms, false, pwiSensor::OnMinPeriodCb, this );
-    this->min_timer.start();
+    this->min_period_ms = delay_ms;
+    if( !this->group ){
+        this->min_timer.setup( strMinTimer, this->getShedPeriod(), false, pwiSensor::OnMinPeriodCb, this );
+        this->min_timer.start();
+    }
     return( PWI_SENSOR_OK );
 }
 
+/**
+ * pwiSensor::setPriority:
+ * @priority: the priority of the sensor, from PWI_SENSOR_PRIORITY_LOW (the
+ *  first to be shed) to PWI_SENSOR_PRIORITY_CRITICAL (never shed).
+ *
+ * Set the priority of the sensor, which defaults to
+ * PWI_SENSOR_PRIORITY_NORMAL.
+ *
+ * Public
+ */
+void pwiSensor::setPriority( uint8_t priority )
+{
+    this->priority = min( priority, ( uint8_t ) PWI_SENSOR_PRIORITY_CRITICAL );
+    this->applyShedding();
+}
+
+/**
+ * pwiSensor::setSendQueue:
+ * @queue: [allow-none]: the store-and-forward queue to be used by sendMessage().
+ *
+ * Let the measures be queued when they cannot be sent, e.g. because the
+ * gateway is unreachable. Several sensors may share the same queue.
+ *
+ * Public
+ */
+void pwiSensor::setSendQueue( pwiSendQueue *queue )
+{
+    this->queue = queue;
+}
+
 /**
  * pwiSensor::setTimers():
  * 
@@ -196,6 +416,85 @@ uint8_t pwiSensor::setTimers( unsigned long min_ms, unsigned long max_ms )
 	return( max( minRes, maxRes ));
 }
 
+/**
+ * pwiSensor::measureAndSend:
+ *
+ * Immediately take the measure, and send it if it has changed.
+ * This is expected to be called by the derived class on an event which
+ * should not wait for the next min period.
+ *
+ * The @min_timer is restarted, so that the next periodic measure is one min
+ * period later. The @max_timer (the heartbeat) is left unchanged.
+ *
+ * Returns: %TRUE if the measure has been sent.
+ *
+ * Protected
+ */
+bool pwiSensor::measureAndSend( void )
+{
+    bool sent = false;
+    if( this->doMeasure()){
+        this->doSend( false );
+        sent = true;
+    }
+    if( this->min_timer.isStarted()){
+        this->min_timer.restart();
+    }
+    return( sent );
+}
+
+/**
+ * pwiSensor::sendMessage:
+ * @msg: the message to be sent.
+ *
+ * Send the @msg message to the controller, through the store-and-forward
+ * queue if one has been set.
+ * This is expected to be called by the derived class from its vSend() method.
+ *
+ * Returns: %TRUE if the message has been sent or queued.
+ *
+ * Protected
+ */
+bool pwiSensor::sendMessage( MyMessage &msg )
+{
+    if( this->queue ){
+        return( this->queue->send( msg ) != PWI_SEND_QUEUE_ERR01 );
+    }
+    return( send( msg ));
+}
+
+/**
+ * pwiSensor::vRestoreState:
+ * @buffer: the state saved by vSaveState().
+ * @size: the size of the saved state.
+ *
+ * Restore the state of the derived class from a warm-start snapshot.
+ * The default implementation does nothing.
+ *
+ * Protected
+ */
+void pwiSensor::vRestoreState( const uint8_t *buffer, uint8_t size )
+{
+}
+
+/**
+ * pwiSensor::vSaveState:
+ * @buffer: the buffer to be filled.
+ * @size: the size of the @buffer.
+ *
+ * Save the state of the derived class (e.g. the last sent value) into a
+ * warm-start snapshot.
+ * The default implementation saves nothing.
+ *
+ * Returns: the count of bytes written to the @buffer.
+ *
+ * Protected
+ */
+uint8_t pwiSensor::vSaveState( uint8_t *buffer, uint8_t size )
+{
+    return( 0 );
+}
+
 /**
  * pwiSensor::OnMaxPeriodCb:
  * 
@@ -209,11 +508,8 @@ uint8_t pwiSensor::setTimers( unsigned long min_ms, unsigned long max_ms )
  */
 void pwiSensor::OnMaxPeriodCb( pwiSensor *sensor )
 {
-#ifdef SENSOR_DEBUG
-    Serial.print( F( "pwiSensor::OnMaxPeriodCb() id=" ));
-    Serial.println( sensor->id );
-#endif
-    sensor->vSend();
+    PWI_LOG( SENSOR_MAX_PERIOD, sensor->id );
+    sensor->doSend( true );
 }
 
 /**
@@ -228,11 +524,227 @@ void pwiSensor::OnMaxPeriodCb( pwiSensor *sensor )
  */
 void pwiSensor::OnMinPeriodCb( pwiSensor *sensor )
 {
-#ifdef SENSOR_DEBUG
-    Serial.print( F( "pwiSensor::OnMinPeriodCb() id=" ));
-    Serial.println( node->id );
-#endif
-	if( sensor->vMeasure()){
-		sensor->vSend();
+    PWI_LOG( SENSOR_MIN_PERIOD, sensor->id );
+	if( sensor->doMeasure()){
+		sensor->doSend( false );
 	}
 }
+
+/**
+ * pwiSensor::GetTimerLabel:
+ * @label: the label of a timer.
+ * @user_data: the user data of the timer.
+ * @buffer: a buffer of PWI_SENSOR_LABEL_SIZE bytes.
+ * @size: the size of the @buffer.
+ *
+ * The min and max timers of all the sensors share the same two labels, the
+ * sensor being their user data: this builds the label of such a timer with
+ * the sensor id, e.g. "MinTimer #12", only when a report needs it.
+ *
+ * Returns: the @buffer for the timer of a sensor, the @label otherwise.
+ *
+ * Public Static.
+ */
+const char *pwiSensor::GetTimerLabel( const char *label, void *user_data, char *buffer, uint8_t size )
+{
+    if(( label == strMinTimer || label == strMaxTimer ) && user_data && size ){
+        snprintf_P( buffer, size, PSTR( "%s #%u" ), label, (( pwiSensor * ) user_data )->id );
+        return( buffer );
+    }
+    return( label );
+}
+
+/**
+ * pwiSensor::GetShedEvents:
+ *
+ * Returns: the count of times the shedding level has been raised.
+ *
+ * Public Static.
+ */
+uint32_t pwiSensor::GetShedEvents( void )
+{
+    return( pwiSensor::shed_events );
+}
+
+/**
+ * pwiSensor::GetShedLevel:
+ *
+ * Returns: the current shedding level, zero when no sensor is shed.
+ *
+ * Public Static.
+ */
+uint8_t pwiSensor::GetShedLevel( void )
+{
+    return( pwiSensor::shed_level );
+}
+
+/**
+ * pwiSensor::SetupShedding:
+ * @timer: a timer to be dedicated to the load shedding.
+ * @high_percent: the load above which the shedding level is raised.
+ * @low_percent: the load below which the shedding level is lowered; must be
+ *  lower than @high_percent.
+ * @period_ms: the period at which the load is checked, which should be
+ *  several times PWI_TIMER_LOAD_WINDOW_MS.
+ *
+ * Configure and start the @timer so that the min periods of the lower
+ * priority sensors are stretched when the main loop is overloaded.
+ *
+ * Public Static.
+ */
+void pwiSensor::SetupShedding( pwiTimer &timer, uint8_t high_percent, uint8_t low_percent, unsigned long period_ms )
+{
+    pwiSensor::shed_high = high_percent;
+    pwiSensor::shed_low = low_percent;
+    timer.setup( "Shedding", period_ms, false, pwiSensor::OnShedPeriodCb );
+    timer.start();
+}
+
+/*
+ * pwiSensor::OnShedPeriodCb:
+ *
+ * Callback of the load shedding timer: raise or lower the shedding level by
+ * one step, and apply it to all the sensors.
+ *
+ * Private Static.
+ */
+void pwiSensor::OnShedPeriodCb( void *user_data )
+{
+    uint8_t load = pwiTimer::GetLoad();
+    uint8_t level = pwiSensor::shed_level;
+
+    if( load >= pwiSensor::shed_high && level < PWI_SENSOR_PRIORITY_CRITICAL ){
+        level += 1;
+        pwiSensor::shed_events += 1;
+    } else if( load <= pwiSensor::shed_low && level > 0 ){
+        level -= 1;
+    }
+    if( level != pwiSensor::shed_level ){
+        PWI_LOG( SENSOR_SHED, level, load );
+        pwiSensor::shed_level = level;
+        pwiSensor::list.iter(( pwiListIterCb * ) pwiSensor::ShedCb );
+    }
+}
+
+/*
+ * pwiSensor::ShedCb:
+ * @sensor: a registered sensor.
+ * @user_data: unused.
+ *
+ * pwiList::iter() callback function: apply the shedding level.
+ *
+ * Private Static.
+ */
+void pwiSensor::ShedCb( pwiSensor *sensor, void *user_data )
+{
+    sensor->applyShedding();
+}
+
+#ifdef PWI_SENSOR_STATS
+/**
+ * pwiSensor::SendStats:
+ * @child_id: the diagnostic child identifier.
+ *
+ * Publish the runtime statistics of all the registered sensors to the
+ * controller, then reset them.
+ *
+ * Each sensor is published as two V_TEXT messages:
+ * - '#<id> m<measures> s<sends> x<suppressed> h<heartbeats>'
+ * - '#<id> M<max>/<mean> S<max>/<mean>', durations being in us.
+ *
+ * Public Static.
+ */
+void pwiSensor::SendStats( uint8_t child_id )
+{
+    pwiSensor::list.iter(( pwiListIterCb * ) pwiSensor::SendStatsCb, &child_id );
+}
+
+/**
+ * pwiSensor::SetupStats:
+ * @timer: a timer to be dedicated to the statistics publication.
+ * @child_id: the diagnostic child identifier.
+ * @period_ms: the publication period.
+ *
+ * Configure and start the @timer so that the runtime statistics are
+ * periodically published to the controller.
+ *
+ * Public Static.
+ */
+void pwiSensor::SetupStats( pwiTimer &timer, uint8_t child_id, unsigned long period_ms )
+{
+    pwiSensor::stats_id = child_id;
+    timer.setup( "SensorStats", period_ms, false, pwiSensor::OnStatsPeriodCb );
+    timer.start();
+}
+
+/*
+ * pwiSensor::OnStatsPeriodCb:
+ *
+ * Callback of the statistics timer.
+ *
+ * Private Static.
+ */
+void pwiSensor::OnStatsPeriodCb( void *user_data )
+{
+    pwiSensor::SendStats( pwiSensor::stats_id );
+}
+
+/*
+ * pwiSensor::SendStatsCb:
+ * @sensor: the sensor.
+ * @user_data: a pointer to the diagnostic child identifier.
+ *
+ * pwiList::iter() callback function: publish the statistics of the sensor.
+ *
+ * Private Static.
+ */
+void pwiSensor::SendStatsCb( pwiSensor *sensor, void *user_data )
+{
+    pwiSensorStats *stats = &sensor->stats;
+    char payload[1+MAX_PAYLOAD];
+    MyMessage msg( *( uint8_t * ) user_data, V_TEXT );
+
+    snprintf_P( payload, sizeof( payload ), PSTR( "#%u m%lu s%lu x%lu h%lu" ),
+            sensor->id, ( unsigned long ) stats->measures, ( unsigned long ) stats->sends,
+            ( unsigned long ) stats->suppressed, ( unsigned long ) stats->heartbeats );
+    send( msg.set( payload ));
+
+    snprintf_P( payload, sizeof( payload ), PSTR( "#%u M%lu/%lu S%lu/%lu" ),
+            sensor->id,
+            ( unsigned long ) stats->measure_max_us,
+            ( unsigned long )( stats->measures ? stats->measure_total_us / stats->measures : 0 ),
+            ( unsigned long ) stats->send_max_us,
+            ( unsigned long )( stats->sends ? stats->send_total_us / stats->sends : 0 ));
+    send( msg.set( payload ));
+
+    sensor->resetStats();
+}
+#endif
+
+#ifdef PWI_THREADS
+/*
+ * pwiSensor::RadioHeartbeatCb:
+ * @sensor: this pwiSensor.
+ *
+ * pwiThreads radio job: send the measure on max period.
+ *
+ * Private Static.
+ */
+void pwiSensor::RadioHeartbeatCb( pwiSensor *sensor )
+{
+    sensor->doSend( true );
+}
+
+/*
+ * pwiSensor::RadioSendCb:
+ * @sensor: this pwiSensor.
+ *
+ * pwiThreads radio job: send the changed measure.
+ *
+ * Private Static.
+ */
+void pwiSensor::RadioSendCb( pwiSensor *sensor )
+{
+    sensor->doSend( false );
+}
+#endif
@@ -13,6 +13,17 @@
  *
  * The two included timers are automatically managed (restarted) by this class.
  *
+ * All the sensors register themselves into a static registry, which is
+ * walked by the statistics (PWI_SENSOR_STATS), the warm-start snapshot
+ * (pwiSnapshot), the memory accounting (pwiMemory) and the load shedding.
+ * The registry is unconditional, because the last three features are not
+ * build-time options, and cannot be told at compile time whether the sketch
+ * uses them. Its cost is known and bounded: the first sensor is held by the
+ * static head of the list, and each other one costs a heap pwiList node of
+ * two pointers (i.e. 4 bytes, plus 2 bytes of malloc() header, on AVR),
+ * allocated once at construction time, and never freed, so that it does not
+ * fragment the heap; it is reported by pwiMemory.
+ *
  * Usage synopsys:
  *
  * a) define the sensor variable:
@@ -59,9 +70,24 @@
  *                BREAKING CHANGE: replace sendCb() method by protected virtual vSend()
  *                BREAKING CHANGE: remove setup() method
  *                new setMeasureCb(), setSendCb() methods
+ * pwi 2026-10-18 optional runtime statistics (define PWI_SENSOR_STATS)
+ *                new setSendQueue() and sendMessage() methods
+ *                new protected measureAndSend() method
+ *                with PWI_THREADS, vMeasure() may be called from a worker
+ *                thread, while vSend() is always called from the radio thread
+ *                the registry of the sensors is unconditional (see above)
+ *                new vSaveState(), vRestoreState() virtuals (see pwiSnapshot)
+ *                may be measured as a member of a pwiSensorGroup
+ *                accounted by pwiMemory
+ *                priority and overload-aware load shedding
+ *                the timers are labelled with the sensor id
+ *                the sensor id is only added to the timer labels when reported
  */
 
 #include "pwiTimer.h"
+#include "pwiSendQueue.h"
+
+class pwiSensorGroup;
  
 enum {
     PWI_SENSOR_OK = 0,
@@ -69,7 +95,73 @@ enum {
     PWI_SENSOR_ERR02                            // min period greater than max period (and max period is set)
 };
 
+/* the size of the buffer of GetTimerLabel(), e.g. "MinTimer #255"
+ */
+#ifndef PWI_SENSOR_LABEL_SIZE
+#define PWI_SENSOR_LABEL_SIZE           14
+#endif
+
+/*
+ * Load shedding.
+ *
+ * When the load of the main loop (see pwiTimer::GetLoad()) crosses a high
+ * threshold, the shedding level is raised by one step; it is lowered by one
+ * step when the load falls below a low threshold, the gap between the two
+ * thresholds providing the hysteresis.
+ *
+ * The min period of a sensor whose priority is lower than the shedding level
+ * is doubled for each level of difference, but bounded by its max period, so
+ * that the heartbeats still arrive. Critical sensors are never shed.
+ *
+ * Usage synopsys:
+ *    mySensor.setPriority( PWI_SENSOR_PRIORITY_LOW );
+ *    pwiTimer shedTimer;
+ *    pwiSensor::SetupShedding( shedTimer, 80, 50, 5000 );
+ */
+enum {
+    PWI_SENSOR_PRIORITY_LOW = 0,
+    PWI_SENSOR_PRIORITY_NORMAL,
+    PWI_SENSOR_PRIORITY_HIGH,
+    PWI_SENSOR_PRIORITY_CRITICAL
+};
+
+#ifdef PWI_SENSOR_STATS
+/*
+ * Runtime statistics of a sensor.
+ *
+ * They are only maintained when the library is built with PWI_SENSOR_STATS
+ * defined, and do not cost anything else.
+ *
+ * Counters are reset each time they are published to the controller, so that
+ * they actually are per-period statistics.
+ *
+ * Usage synopsys:
+ *
+ * a) present the diagnostic child to the controller:
+ *    present( stats_id, S_INFO, "Sensors stats" );
+ *
+ * b) setup a timer to periodically publish the statistics:
+ *    pwiTimer statsTimer;
+ *    pwiSensor::SetupStats( statsTimer, stats_id, 3600000 );
+ */
+typedef struct {
+    uint32_t    measures;                       // count of vMeasure() calls
+    uint32_t    sends;                          // count of vSend() calls
+    uint32_t    suppressed;                     // count of measures which have not been sent
+    uint32_t    heartbeats;                     // count of vSend() calls triggered by the max period
+    uint32_t    measure_max_us;                 // max duration of vMeasure()
+    uint32_t    measure_total_us;               // total duration of vMeasure(), used to compute the mean
+    uint32_t    send_max_us;                    // max duration of vSend()
+    uint32_t    send_total_us;                  // total duration of vSend(), used to compute the mean
+}
+    pwiSensorStats;
+#endif
+
 class pwiSensor {
+    friend class pwiMemory;
+    friend class pwiSensorGroup;
+    friend class pwiSnapshot;
+
     public:
                                   pwiSensor( void );
                                   pwiSensor( uint8_t id );
@@ -79,36 +171,104 @@ class pwiSensor {
                 uint8_t           getId();
                 pwiTimer         &getMaxTimer( void );
                 pwiTimer         &getMinTimer( void );
+                uint8_t           getPriority( void );
 
 		/* setters
 		 */
                 void              setId( uint8_t id );
                 uint8_t           setMaxPeriod( unsigned long delay_ms );
                 uint8_t           setMinPeriod( unsigned long delay_ms );
+                void              setPriority( uint8_t priority );
+                void              setSendQueue( pwiSendQueue *queue );
 				uint8_t	          setTimers( unsigned long min_ms, unsigned long max_ms );
 
+		/* reports
+		 */
+        static  const char       *GetTimerLabel( const char *label, void *user_data, char *buffer, uint8_t size );
+
+		/* load shedding
+		 */
+        static  uint32_t          GetShedEvents( void );
+        static  uint8_t           GetShedLevel( void );
+        static  void              SetupShedding( pwiTimer &timer, uint8_t high_percent, uint8_t low_percent, unsigned long period_ms );
+
+#ifdef PWI_SENSOR_STATS
+		/* statistics
+		 */
+          const pwiSensorStats   &getStats( void );
+                void              resetStats( void );
+
+        static  void              SendStats( uint8_t child_id );
+        static  void              SetupStats( pwiTimer &timer, uint8_t child_id, unsigned long period_ms );
+#endif
+
 	protected:
 		/* virtuals MUST be implemented by the derived class
 		 */
         virtual bool              vMeasure() = 0;
         virtual void              vSend() = 0;
 
+		/* virtuals which MAY be implemented by the derived class to have its
+		 * state saved in the warm-start snapshot
+		 */
+        virtual void              vRestoreState( const uint8_t *buffer, uint8_t size );
+        virtual uint8_t           vSaveState( uint8_t *buffer, uint8_t size );
+
+		/* helpers for the derived class
+		 */
+                pwiSensorGroup   *getGroup( void );
+                bool              measureAndSend();
+                bool              sendMessage( MyMessage &msg );
+
     private:
         /* construction data
          */
                 uint8_t           id;
+                uint8_t           priority;
+                unsigned long     min_period_ms;            // the configured min period, before shedding
 
         /* runtime data
          */
                 pwiTimer          min_timer;                // min period, aka max frequency
                 pwiTimer          max_timer;                // max period, aka unchanged timeout
+                pwiSendQueue     *queue;                    // store-and-forward queue, may be null
+                pwiSensorGroup   *group;                    // the bus group, may be null
+
+#ifdef PWI_SENSOR_STATS
+                pwiSensorStats    stats;
+#endif
 
         /* private methods
          */
                 void              init();
+                void              applyShedding();
+                bool              doMeasure();
+                void              doSend( bool heartbeat );
+                unsigned long     getShedPeriod();
 
         static  void              OnMinPeriodCb( pwiSensor *sensor );
         static  void              OnMaxPeriodCb( pwiSensor *sensor );
+
+#ifdef PWI_THREADS
+        static  void              RadioHeartbeatCb( pwiSensor *sensor );
+        static  void              RadioSendCb( pwiSensor *sensor );
+#endif
+
+        static  pwiList           list;
+        static  uint8_t           shed_level;
+        static  uint8_t           shed_high;
+        static  uint8_t           shed_low;
+        static  uint32_t          shed_events;
+
+        static  void              OnShedPeriodCb( void *user_data );
+        static  void              ShedCb( pwiSensor *sensor, void *user_data );
+
+#ifdef PWI_SENSOR_STATS
+        static  uint8_t           stats_id;
+
+        static  void              OnStatsPeriodCb( void *user_data );
+        static  void              SendStatsCb( pwiSensor *sensor, void *user_data );
+#endif
 };
 
 #endif // __PWI_SENSOR_H__
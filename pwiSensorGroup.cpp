@@ -0,0 +1,159 @@
+/*
+ * pwi 2026-10-18 creation
+ *                the min timers of the members are no longer restarted by setMinPeriod()
+ */
+
+#include "pwiSensorGroup.h"
+
+static const char strGroupTimer[] = "SensorGroup";
+static const char strReadTimer[] = "SensorGroupRead";
+
+/**
+ * pwiSensorGroup::pwiSensorGroup:
+ *
+ * Constructor.
+ *
+ * Public.
+ */
+pwiSensorGroup::pwiSensorGroup( void )
+{
+    this->count = 0;
+    this->cb = NULL;
+    this->user_data = NULL;
+}
+
+/**
+ * pwiSensorGroup::add:
+ * @sensor: a configured sensor.
+ *
+ * Add the @sensor to the group: its min timer is stopped, and it is from
+ * now measured at the group period.
+ * A sensor must not be added to several groups.
+ *
+ * Public.
+ */
+void pwiSensorGroup::add( pwiSensor &sensor )
+{
+    sensor.group = this;
+    sensor.min_timer.stop();
+    this->members.add( &sensor );
+    this->count += 1;
+}
+
+/**
+ * pwiSensorGroup::getCount:
+ *
+ * Returns: the count of members.
+ *
+ * Public.
+ */
+uint8_t pwiSensorGroup::getCount( void )
+{
+    return( this->count );
+}
+
+/**
+ * pwiSensorGroup::getTimer:
+ *
+ * Returns: a reference to the group period timer.
+ *
+ * Public.
+ */
+pwiTimer &pwiSensorGroup::getTimer( void )
+{
+    return( this->period_timer );
+}
+
+/**
+ * pwiSensorGroup::setup:
+ * @period_ms: the measure period of the group.
+ * @conversion_ms: the conversion time, after which the members are read;
+ *  may be zero.
+ * @cb: [allow-none]: the callback which starts the broadcast conversion.
+ * @user_data: [allow-none]: the user data to be passed to the @cb.
+ *
+ * Configure the group.
+ *
+ * Public.
+ */
+void pwiSensorGroup::setup( unsigned long period_ms, unsigned long conversion_ms, pwiSensorGroupCb cb, void *user_data )
+{
+    this->cb = cb;
+    this->user_data = user_data;
+    this->period_timer.setup( strGroupTimer, period_ms, false, ( pwiTimerCb ) pwiSensorGroup::OnPeriodCb, this );
+    this->read_timer.setup( strReadTimer, conversion_ms, true, ( pwiTimerCb ) pwiSensorGroup::OnReadCb, this );
+}
+
+/**
+ * pwiSensorGroup::start:
+ *
+ * Start the group timer.
+ *
+ * Public.
+ */
+void pwiSensorGroup::start( void )
+{
+    this->period_timer.start();
+}
+
+/**
+ * pwiSensorGroup::stop:
+ *
+ * Stop the group timer; a pending read is cancelled.
+ *
+ * Public.
+ */
+void pwiSensorGroup::stop( void )
+{
+    this->period_timer.stop();
+    this->read_timer.stop();
+}
+
+/*
+ * pwiSensorGroup::OnPeriodCb:
+ * @group: this pwiSensorGroup.
+ *
+ * Callback of the group period timer: start the conversion, then wait for
+ * it without blocking.
+ *
+ * Private Static.
+ */
+void pwiSensorGroup::OnPeriodCb( pwiSensorGroup *group )
+{
+    if( group->cb ){
+        group->cb( group->user_data );
+    }
+    if( group->read_timer.isRunnable()){
+        group->read_timer.start();
+    } else {
+        pwiSensorGroup::OnReadCb( group );
+    }
+}
+
+/*
+ * pwiSensorGroup::OnReadCb:
+ * @group: this pwiSensorGroup.
+ *
+ * Callback of the conversion timer: measure each member.
+ *
+ * Private Static.
+ */
+void pwiSensorGroup::OnReadCb( pwiSensorGroup *group )
+{
+    group->members.iter(( pwiListIterCb * ) pwiSensorGroup::ReadCb );
+}
+
+/*
+ * pwiSensorGroup::ReadCb:
+ * @sensor: a member of the group.
+ * @user_data: unused.
+ *
+ * pwiList::iter() callback function: measure the sensor, and send the
+ * measure if it has changed.
+ *
+ * Private Static.
+ */
+void pwiSensorGroup::ReadCb( pwiSensor *sensor, void *user_data )
+{
+    sensor->measureAndSend();
+}
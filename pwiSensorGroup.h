@@ -0,0 +1,71 @@
+#ifndef __PWI_SENSOR_GROUP_H__
+#define __PWI_SENSOR_GROUP_H__
+
+/*
+ * A group of sensors which share a same bus (e.g. several DS18B20 on a
+ * 1-Wire bus, or several devices on an I2C bus).
+ *
+ * When each sensor triggers its own conversion and waits for it, N sensors
+ * cost N conversion times. Instead, the group replaces the min timers of its
+ * members by a single group timer, which:
+ * - first calls the convert callback, which is expected to start one
+ *   broadcast conversion (e.g. a 1-Wire 'Convert T' to all devices);
+ * - then, once the conversion time has elapsed, measures each member (and
+ *   sends the measure if it has changed), without blocking meanwhile.
+ *
+ * The whole group is so measured in about one conversion period. The max
+ * timers (heartbeats) of the members are left unchanged, while their min
+ * timers stay stopped, even through a later setMinPeriod().
+ *
+ * The vMeasure() of a member should then only read the converted value:
+ * it may check getGroup() to know whether the conversion has already been
+ * done.
+ *
+ * Usage synopsys:
+ *
+ * a) configure the sensors as usual, then define the group:
+ *    pwiSensorGroup myBus;
+ *    myBus.setup( 60000, 750, convertCb, &myOneWire );
+ *    myBus.add( mySensor1 );
+ *    myBus.add( mySensor2 );
+ *    myBus.start();
+ *
+ * b) the convert callback:
+ *    void convertCb( void *user_data ){
+ *        (( DallasTemperature * ) user_data )->requestTemperatures();
+ *    }
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include "pwiSensor.h"
+
+/* The prototype of the callback which starts the broadcast conversion.
+ */
+typedef void ( *pwiSensorGroupCb )( void *user_data );
+
+class pwiSensorGroup {
+    public:
+                                  pwiSensorGroup( void );
+
+                void              add( pwiSensor &sensor );
+                uint8_t           getCount( void );
+                pwiTimer         &getTimer( void );
+                void              setup( unsigned long period_ms, unsigned long conversion_ms, pwiSensorGroupCb cb, void *user_data=NULL );
+                void              start( void );
+                void              stop( void );
+
+    private:
+                pwiList           members;
+                uint8_t           count;
+                pwiSensorGroupCb  cb;
+                void             *user_data;
+                pwiTimer          period_timer;         // the group min period
+                pwiTimer          read_timer;           // the conversion time
+
+        static  void              OnPeriodCb( pwiSensorGroup *group );
+        static  void              OnReadCb( pwiSensorGroup *group );
+        static  void              ReadCb( pwiSensor *sensor, void *user_data );
+};
+
+#endif // __PWI_SENSOR_GROUP_H__
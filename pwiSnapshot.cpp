@@ -0,0 +1,283 @@
+/*
+ * pwi 2026-10-18 creation
+ *                the min timers of the grouped sensors are not restored
+ */
+
+#include "pwiSnapshot.h"
+#include "pwiSensor.h"
+#include "pwiCrc.h"
+#include <EEPROM.h>
+
+#define SNAPSHOT_MAGIC              'S'
+#define SNAPSHOT_VERSION            1
+
+// the remaining time of a stopped timer
+#define SNAPSHOT_STOPPED            (( uint32_t ) -1 )
+
+// survive a watchdog or software reset
+#ifdef __AVR__
+#define SNAPSHOT_NOINIT             __attribute__(( section( ".noinit" )))
+#else
+#define SNAPSHOT_NOINIT
+#endif
+
+/* the image is made of a header, the records, and the crc8 of both
+ */
+typedef struct {
+    uint8_t     magic;
+    uint8_t     version;
+    uint8_t     count;                          // count of records
+    uint16_t    length;                         // size of the header and the records
+}
+    sSnapshotHeader;
+
+typedef struct {
+    uint8_t     id;                             // sensor identifier
+    uint8_t     size;                           // size of the state of the derived class
+    uint32_t    min_remaining;
+    uint32_t    max_remaining;
+}
+    sSnapshotRecord;
+
+typedef struct {
+    const uint8_t *record;
+    uint8_t     restored;
+}
+    sSnapshotRestore;
+
+static uint8_t st_image[PWI_SNAPSHOT_SIZE] SNAPSHOT_NOINIT;
+
+/**
+ * pwiSnapshot::GetSize:
+ *
+ * Returns: the max size of the image, i.e. the count of bytes to be
+ * reserved in EEPROM.
+ *
+ * Public Static.
+ */
+uint16_t pwiSnapshot::GetSize( void )
+{
+    return( PWI_SNAPSHOT_SIZE );
+}
+
+/**
+ * pwiSnapshot::Invalidate:
+ *
+ * Invalidate the RAM image, so that the next boot will be a cold start.
+ *
+ * Public Static.
+ */
+void pwiSnapshot::Invalidate( void )
+{
+    (( sSnapshotHeader * ) st_image )->magic = 0;
+}
+
+/**
+ * pwiSnapshot::Restore:
+ *
+ * Restore the state of the registered sensors from the RAM image.
+ * This should be called once the sensors have been configured, as the
+ * timers only take the remaining time from the snapshot, while keeping
+ * their configured delay.
+ *
+ * Returns: the count of restored sensors, zero if the image is not valid.
+ *
+ * Public Static.
+ */
+uint8_t pwiSnapshot::Restore( void )
+{
+    sSnapshotRestore restore;
+
+    if( !pwiSnapshot::IsValid()){
+        return( 0 );
+    }
+    restore.restored = 0;
+    pwiSensor::list.iter(( pwiListIterCb * ) pwiSnapshot::RestoreCb, &restore );
+    return( restore.restored );
+}
+
+/**
+ * pwiSnapshot::Restore:
+ * @eeprom_address: the EEPROM address of the image.
+ *
+ * Read the image from EEPROM to RAM, then restore the state of the
+ * registered sensors.
+ *
+ * Returns: the count of restored sensors, zero if the image is not valid.
+ *
+ * Public Static.
+ */
+uint8_t pwiSnapshot::Restore( uint16_t eeprom_address )
+{
+    sSnapshotHeader *header = ( sSnapshotHeader * ) st_image;
+
+    EEPROM.get( eeprom_address, *header );
+    if( header->length < sizeof( sSnapshotHeader ) || header->length >= PWI_SNAPSHOT_SIZE ){
+        pwiSnapshot::Invalidate();
+        return( 0 );
+    }
+    for( uint16_t i=sizeof( sSnapshotHeader ) ; i<=header->length ; ++i ){
+        st_image[i] = EEPROM.read( eeprom_address+i );
+    }
+    return( pwiSnapshot::Restore());
+}
+
+/**
+ * pwiSnapshot::Save:
+ *
+ * Save the state of the registered sensors to the RAM image.
+ * A sensor which does not fit in the image is not saved.
+ *
+ * Returns: the count of saved sensors.
+ *
+ * Public Static.
+ */
+uint8_t pwiSnapshot::Save( void )
+{
+    sSnapshotHeader *header = ( sSnapshotHeader * ) st_image;
+
+    // the padding of the structures is zeroed, as it is covered by the crc
+    memset( st_image, '\0', sizeof( sSnapshotHeader ));
+    header->version = SNAPSHOT_VERSION;
+    header->count = 0;
+    header->length = sizeof( sSnapshotHeader );
+    pwiSensor::list.iter(( pwiListIterCb * ) pwiSnapshot::SaveCb, NULL );
+    st_image[header->length] = pwiCrc8( st_image+1, header->length-1 );
+    // the image becomes valid
+    header->magic = SNAPSHOT_MAGIC;
+    return( header->count );
+}
+
+/**
+ * pwiSnapshot::Save:
+ * @eeprom_address: the EEPROM address of the image, where GetSize() bytes
+ *  must have been reserved.
+ *
+ * Save the state of the registered sensors to the RAM image, and copy it to
+ * EEPROM. Only the changed bytes are actually written.
+ *
+ * Returns: the count of saved sensors.
+ *
+ * Public Static.
+ */
+uint8_t pwiSnapshot::Save( uint16_t eeprom_address )
+{
+    uint8_t count = pwiSnapshot::Save();
+    uint16_t length = (( sSnapshotHeader * ) st_image )->length;
+    for( uint16_t i=0 ; i<=length ; ++i ){
+        EEPROM.update( eeprom_address+i, st_image[i] );
+    }
+    return( count );
+}
+
+/**
+ * pwiSnapshot::SetupAutoSave:
+ * @timer: a timer to be dedicated to the snapshot.
+ * @period_ms: the save period.
+ *
+ * Configure and start the @timer so that the RAM image is periodically
+ * saved; the period bounds the schedule drift after a reset.
+ *
+ * Public Static.
+ */
+void pwiSnapshot::SetupAutoSave( pwiTimer &timer, unsigned long period_ms )
+{
+    timer.setup( "Snapshot", period_ms, false, pwiSnapshot::OnAutoSaveCb );
+    timer.start();
+}
+
+/*
+ * pwiSnapshot::IsValid:
+ *
+ * Returns: %TRUE if the RAM image is valid.
+ *
+ * Private Static.
+ */
+bool pwiSnapshot::IsValid( void )
+{
+    sSnapshotHeader *header = ( sSnapshotHeader * ) st_image;
+
+    return( header->magic == SNAPSHOT_MAGIC
+            && header->version == SNAPSHOT_VERSION
+            && header->length >= sizeof( sSnapshotHeader )
+            && header->length < PWI_SNAPSHOT_SIZE
+            && st_image[header->length] == pwiCrc8( st_image+1, header->length-1 ));
+}
+
+/*
+ * pwiSnapshot::OnAutoSaveCb:
+ *
+ * Callback of the auto-save timer.
+ *
+ * Private Static.
+ */
+void pwiSnapshot::OnAutoSaveCb( void *user_data )
+{
+    pwiSnapshot::Save();
+}
+
+/*
+ * pwiSnapshot::RestoreCb:
+ * @sensor: a registered sensor.
+ * @user_data: a pointer to a sSnapshotRestore structure.
+ *
+ * pwiList::iter() callback function: restore the sensor from its record,
+ * if any.
+ *
+ * Private Static.
+ */
+void pwiSnapshot::RestoreCb( pwiSensor *sensor, void *user_data )
+{
+    sSnapshotHeader *header = ( sSnapshotHeader * ) st_image;
+    sSnapshotRestore *restore = ( sSnapshotRestore * ) user_data;
+    sSnapshotRecord record;
+    uint16_t offset = sizeof( sSnapshotHeader );
+
+    for( uint8_t i=0 ; i<header->count ; ++i ){
+        memcpy( &record, st_image+offset, sizeof( record ));
+        if( record.id == sensor->getId()){
+            if( record.min_remaining != SNAPSHOT_STOPPED && !sensor->group && sensor->min_timer.isRunnable()){
+                sensor->min_timer.setRemaining( record.min_remaining );
+            }
+            if( record.max_remaining != SNAPSHOT_STOPPED && sensor->max_timer.isRunnable()){
+                sensor->max_timer.setRemaining( record.max_remaining );
+            }
+            if( record.size ){
+                sensor->vRestoreState( st_image+offset+sizeof( record ), record.size );
+            }
+            restore->restored += 1;
+            return;
+        }
+        offset += sizeof( record ) + record.size;
+    }
+}
+
+/*
+ * pwiSnapshot::SaveCb:
+ * @sensor: a registered sensor.
+ * @user_data: unused.
+ *
+ * pwiList::iter() callback function: append the record of the sensor to
+ * the image, keeping one byte for the crc.
+ *
+ * Private Static.
+ */
+void pwiSnapshot::SaveCb( pwiSensor *sensor, void *user_data )
+{
+    sSnapshotHeader *header = ( sSnapshotHeader * ) st_image;
+    sSnapshotRecord record;
+    uint8_t state[PWI_SNAPSHOT_STATE_MAX];
+
+    memset( &record, '\0', sizeof( record ));
+    record.id = sensor->getId();
+    record.size = sensor->vSaveState( state, sizeof( state ));
+    if( header->length + sizeof( record ) + record.size >= PWI_SNAPSHOT_SIZE ){
+        return;
+    }
+    record.min_remaining = sensor->min_timer.isStarted() ? sensor->min_timer.getRemaining() : SNAPSHOT_STOPPED;
+    record.max_remaining = sensor->max_timer.isStarted() ? sensor->max_timer.getRemaining() : SNAPSHOT_STOPPED;
+    memcpy( st_image+header->length, &record, sizeof( record ));
+    memcpy( st_image+header->length+sizeof( record ), state, record.size );
+    header->length += sizeof( record ) + record.size;
+    header->count += 1;
+}
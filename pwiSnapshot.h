@@ -0,0 +1,74 @@
+#ifndef __PWI_SNAPSHOT_H__
+#define __PWI_SNAPSHOT_H__
+
+/*
+ * A warm-start snapshot of the registered sensors.
+ *
+ * After a reset, every pwiSensor restarts its timers in phase; after a power
+ * blip, all the nodes of a network so restart together and hammer the
+ * gateway at once. The snapshot saves, for each registered pwiSensor:
+ * - the remaining time of its min and max timers,
+ * - the state of the derived class, through the vSaveState() virtual (e.g.
+ *   the pulses count of a pwiPulseSensor),
+ * so that the sensors resume their previous schedule when it is restored at
+ * boot.
+ *
+ * The snapshot is built in a RAM image which, on AVR, lives in the .noinit
+ * section, and so survives a watchdog or software reset. It may also be
+ * copied to EEPROM (e.g. before a planned reboot for a firmware update),
+ * though saving it too often would wear the EEPROM out.
+ *
+ * The image is protected by a magic, a version and a crc8, so that an
+ * uninitialized RAM or an empty EEPROM is just ignored.
+ *
+ * Usage synopsys:
+ *
+ * a) at the end of setup(), after the sensors have been configured:
+ *    pwiSnapshot::Restore();
+ *
+ * b) let the snapshot be periodically saved to RAM:
+ *    pwiTimer snapshotTimer;
+ *    pwiSnapshot::SetupAutoSave( snapshotTimer, 1000 );
+ *
+ * pwi 2026-10-18 creation
+ */
+
+#include <Arduino.h>
+
+class pwiSensor;
+class pwiTimer;
+
+/* the size of the RAM image
+ */
+#ifndef PWI_SNAPSHOT_SIZE
+#ifdef __AVR__
+#define PWI_SNAPSHOT_SIZE               64
+#else
+#define PWI_SNAPSHOT_SIZE               256
+#endif
+#endif
+
+/* the max size of the state of a derived class
+ */
+#ifndef PWI_SNAPSHOT_STATE_MAX
+#define PWI_SNAPSHOT_STATE_MAX          16
+#endif
+
+class pwiSnapshot {
+    public:
+        static  uint16_t          GetSize( void );
+        static  void              Invalidate( void );
+        static  uint8_t           Restore( void );
+        static  uint8_t           Restore( uint16_t eeprom_address );
+        static  uint8_t           Save( void );
+        static  uint8_t           Save( uint16_t eeprom_address );
+        static  void              SetupAutoSave( pwiTimer &timer, unsigned long period_ms );
+
+    private:
+        static  bool              IsValid( void );
+        static  void              OnAutoSaveCb( void *user_data );
+        static  void              RestoreCb( pwiSensor *sensor, void *user_data );
+        static  void              SaveCb( pwiSensor *sensor, void *user_data );
+};
+
+#endif // __PWI_SNAPSHOT_H__
@@ -0,0 +1,300 @@
+/*
+ * pwi 2026-10-18 creation
+ *                new SetWakeup() method
+ *                the jobs which cannot be allocated are dropped and counted
+ */
+
+#include "pwiThreads.h"
+
+#ifdef PWI_THREADS
+
+pwiThreads::pwiThreadsQueue pwiThreads::radio = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, NULL };
+pthread_t                   pwiThreads::radio_thread;
+bool                        pwiThreads::radio_set = false;
+
+pwiThreads::pwiThreadsQueue pwiThreads::work = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, NULL };
+pthread_t                   pwiThreads::workers[PWI_THREADS_MAX_WORKERS];
+uint8_t                     pwiThreads::workers_count = 0;
+bool                        pwiThreads::stopping = false;
+
+uint32_t                    pwiThreads::dropped = 0;
+
+pwiThreadsJobCb             pwiThreads::wakeup_cb = NULL;
+void                       *pwiThreads::wakeup_data = NULL;
+
+/**
+ * pwiThreads::GetDropped:
+ *
+ * Returns: the count of the jobs posted to the radio thread which have been
+ * dropped because they could not be allocated.
+ *
+ * Public Static.
+ */
+uint32_t pwiThreads::GetDropped( void )
+{
+    return( __atomic_load_n( &pwiThreads::dropped, __ATOMIC_ACQUIRE ));
+}
+
+/**
+ * pwiThreads::GetWorkersCount:
+ *
+ * Returns: the count of running worker threads.
+ *
+ * Public Static.
+ */
+uint8_t pwiThreads::GetWorkersCount( void )
+{
+    return( __atomic_load_n( &pwiThreads::workers_count, __ATOMIC_ACQUIRE ));
+}
+
+/**
+ * pwiThreads::IsRadioThread:
+ *
+ * Returns: %TRUE if the caller is the radio thread, or if the radio thread is
+ * not known yet.
+ *
+ * Public Static.
+ */
+bool pwiThreads::IsRadioThread( void )
+{
+    return( !__atomic_load_n( &pwiThreads::radio_set, __ATOMIC_ACQUIRE ) || pthread_equal( pthread_self(), pwiThreads::radio_thread ));
+}
+
+/**
+ * pwiThreads::PostRadio:
+ * @cb: the job.
+ * @data: the data to be passed to the @cb.
+ *
+ * Run the job on the radio thread: immediately if the caller is the radio
+ * thread, else at the next RadioLoop().
+ * If the job cannot be queued (out of memory), it is dropped and counted
+ * (see GetDropped()): it must not be run from the calling thread.
+ *
+ * Public Static.
+ */
+void pwiThreads::PostRadio( pwiThreadsJobCb cb, void *data )
+{
+    if( pwiThreads::IsRadioThread()){
+        cb( data );
+    } else if( pwiThreads::Push( &pwiThreads::radio, cb, data )){
+        pwiThreads::Wakeup();
+    } else {
+        __atomic_add_fetch( &pwiThreads::dropped, 1, __ATOMIC_RELEASE );
+    }
+}
+
+/**
+ * pwiThreads::RadioLoop:
+ *
+ * Run the jobs posted to the radio thread.
+ * This function is meant to be repeatedly called from the main loop, the
+ * calling thread becoming the radio thread.
+ *
+ * Public Static.
+ */
+void pwiThreads::RadioLoop( void )
+{
+    if( !__atomic_load_n( &pwiThreads::radio_set, __ATOMIC_ACQUIRE )){
+        pwiThreads::radio_thread = pthread_self();
+        __atomic_store_n( &pwiThreads::radio_set, true, __ATOMIC_RELEASE );
+    }
+    pwiThreadsJob *job;
+    while(( job = pwiThreads::Pop( &pwiThreads::radio )) != NULL ){
+        job->cb( job->data );
+        free( job );
+    }
+}
+
+/**
+ * pwiThreads::SetWakeup:
+ * @cb: [allow-none]: the callback.
+ * @data: the data to be passed to the @cb.
+ *
+ * Set a callback to be called each time a job has been posted to the radio
+ * thread, or a worker has terminated a job, so that a main loop which sleeps
+ * (see pwiEventLoop) may be woken up to run RadioLoop(), or to take into
+ * account the restarted timer.
+ *
+ * The @cb is called from any thread.
+ *
+ * Public Static.
+ */
+void pwiThreads::SetWakeup( pwiThreadsJobCb cb, void *data )
+{
+    pwiThreads::wakeup_data = data;
+    __atomic_store_n( &pwiThreads::wakeup_cb, cb, __ATOMIC_RELEASE );
+}
+
+/**
+ * pwiThreads::StartWorkers:
+ * @count: the count of worker threads, bounded to PWI_THREADS_MAX_WORKERS.
+ *
+ * Start the pool of worker threads to which the due timer callbacks are
+ * dispatched.
+ *
+ * Returns: %TRUE if at least one worker is running.
+ *
+ * Public Static.
+ */
+bool pwiThreads::StartWorkers( uint8_t count )
+{
+    count = min( count, ( uint8_t ) PWI_THREADS_MAX_WORKERS );
+    pwiThreads::stopping = false;
+    uint8_t started = pwiThreads::workers_count;
+    while( started < count && !pthread_create( &pwiThreads::workers[started], NULL, pwiThreads::WorkerMain, NULL )){
+        started += 1;
+    }
+    __atomic_store_n( &pwiThreads::workers_count, started, __ATOMIC_RELEASE );
+    return( started > 0 );
+}
+
+/**
+ * pwiThreads::StopWorkers:
+ *
+ * Stop the worker threads, after they have run the already submitted jobs.
+ * The timer callbacks are then run again by pwiTimer::Loop() itself.
+ *
+ * Public Static.
+ */
+void pwiThreads::StopWorkers( void )
+{
+    uint8_t count = pwiThreads::workers_count;
+    __atomic_store_n( &pwiThreads::workers_count, 0, __ATOMIC_RELEASE );
+
+    pthread_mutex_lock( &pwiThreads::work.mutex );
+    pwiThreads::stopping = true;
+    pthread_cond_broadcast( &pwiThreads::work.cond );
+    pthread_mutex_unlock( &pwiThreads::work.mutex );
+
+    for( uint8_t i=0 ; i<count ; ++i ){
+        pthread_join( pwiThreads::workers[i], NULL );
+    }
+}
+
+/**
+ * pwiThreads::Submit:
+ * @cb: the job.
+ * @data: the data to be passed to the @cb.
+ *
+ * Queue the job to the worker pool.
+ *
+ * Returns: %FALSE if there is no running worker, or if the job cannot be
+ * queued (out of memory), the job being then ignored.
+ *
+ * Public Static.
+ */
+bool pwiThreads::Submit( pwiThreadsJobCb cb, void *data )
+{
+    if( !pwiThreads::GetWorkersCount()){
+        return( false );
+    }
+    return( pwiThreads::Push( &pwiThreads::work, cb, data ));
+}
+
+/*
+ * pwiThreads::Pop:
+ * @queue: the queue.
+ *
+ * Returns: the oldest job of the @queue, or %NULL.
+ *
+ * Private Static.
+ */
+pwiThreads::pwiThreadsJob *pwiThreads::Pop( pwiThreadsQueue *queue )
+{
+    pthread_mutex_lock( &queue->mutex );
+    pwiThreadsJob *job = queue->head;
+    if( job ){
+        queue->head = job->next;
+        if( !queue->head ){
+            queue->tail = NULL;
+        }
+    }
+    pthread_mutex_unlock( &queue->mutex );
+    return( job );
+}
+
+/*
+ * pwiThreads::Push:
+ * @queue: the queue.
+ * @cb: the job.
+ * @data: the data to be passed to the @cb.
+ *
+ * Append a job to the @queue, and wake up a waiting thread.
+ *
+ * Returns: %FALSE if the job cannot be allocated.
+ *
+ * Private Static.
+ */
+bool pwiThreads::Push( pwiThreadsQueue *queue, pwiThreadsJobCb cb, void *data )
+{
+    pwiThreadsJob *job = ( pwiThreadsJob * ) malloc( sizeof( pwiThreadsJob ));
+    if( !job ){
+        return( false );
+    }
+    job->cb = cb;
+    job->data = data;
+    job->next = NULL;
+
+    pthread_mutex_lock( &queue->mutex );
+    if( queue->tail ){
+        queue->tail->next = job;
+    } else {
+        queue->head = job;
+    }
+    queue->tail = job;
+    pthread_cond_signal( &queue->cond );
+    pthread_mutex_unlock( &queue->mutex );
+    return( true );
+}
+
+/*
+ * pwiThreads::Wakeup:
+ *
+ * Call the wakeup callback, if any.
+ *
+ * Private Static.
+ */
+void pwiThreads::Wakeup( void )
+{
+    pwiThreadsJobCb cb = __atomic_load_n( &pwiThreads::wakeup_cb, __ATOMIC_ACQUIRE );
+    if( cb ){
+        cb( pwiThreads::wakeup_data );
+    }
+}
+
+/*
+ * pwiThreads::WorkerMain:
+ *
+ * The main function of a worker thread: run the submitted jobs until
+ * stopped.
+ *
+ * Private Static.
+ */
+void *pwiThreads::WorkerMain( void *arg )
+{
+    pwiThreadsQueue *queue = &pwiThreads::work;
+
+    while( true ){
+        pthread_mutex_lock( &queue->mutex );
+        while( !queue->head && !pwiThreads::stopping ){
+            pthread_cond_wait( &queue->cond, &queue->mutex );
+        }
+        pwiThreadsJob *job = queue->head;
+        if( !job ){
+            pthread_mutex_unlock( &queue->mutex );
+            break;
+        }
+        queue->head = job->next;
+        if( !queue->head ){
+            queue->tail = NULL;
+        }
+        pthread_mutex_unlock( &queue->mutex );
+
+        job->cb( job->data );
+        free( job );
+        pwiThreads::Wakeup();
+    }
+    return( NULL );
+}
+
+#endif // PWI_THREADS
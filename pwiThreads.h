@@ -0,0 +1,113 @@
+#ifndef __PWI_THREADS_H__
+#define __PWI_THREADS_H__
+
+/*
+ * Multi-threading support for the Linux builds (e.g. a MySensors gateway on
+ * a Raspberry Pi with many virtual children).
+ *
+ * This is only compiled when PWI_THREADS is defined. The library then:
+ * - protects the pwiTimer's runtime data with a mutex instead of the
+ *   (meaningless on Linux) noInterrupts(),
+ * - lets the readers of a pwiList iterate without any lock, the list being
+ *   append-only,
+ * - may dispatch the due timer callbacks to a pool of worker threads
+ *   (see StartWorkers()); a timer is not dispatched again while its
+ *   previous callback is still running, so that the callbacks of a given timer
+ *   are always run one after the other, in order;
+ * - serializes the pwiSensor::vSend() calls onto the radio thread, i.e. the
+ *   thread which calls pwiThreads::RadioLoop() (see below); until RadioLoop()
+ *   is first called, vSend() is called from the calling thread.
+ *
+ * Usage synopsys on the gateway:
+ *
+ * a) build the library and the sketch with -DPWI_THREADS, linking with
+ *    -lpthread;
+ *
+ * b) in setup(), start the workers:
+ *    pwiThreads::StartWorkers( 4 );
+ *
+ * c) in loop(), which is the MySensors radio thread:
+ *    pwiTimer::Loop();
+ *    pwiThreads::RadioLoop();
+ *
+ * pwi 2026-10-18 creation
+ *                new SetWakeup() method
+ *                new GetDropped() method
+ */
+
+#ifdef PWI_THREADS
+
+#ifndef __linux__
+#error "PWI_THREADS is only supported on Linux"
+#endif
+
+#include <Arduino.h>
+#include <pthread.h>
+
+/* the max count of worker threads
+ */
+#ifndef PWI_THREADS_MAX_WORKERS
+#define PWI_THREADS_MAX_WORKERS         8
+#endif
+
+/* a job to be run by a thread
+ */
+typedef void ( *pwiThreadsJobCb )( void *data );
+
+class pwiThreads {
+    public:
+        /* static methods
+         */
+        static  uint32_t          GetDropped( void );
+        static  bool              IsRadioThread( void );
+        static  void              PostRadio( pwiThreadsJobCb cb, void *data );
+        static  void              RadioLoop( void );
+
+        static  uint8_t           GetWorkersCount( void );
+        static  bool              StartWorkers( uint8_t count );
+        static  void              StopWorkers( void );
+        static  bool              Submit( pwiThreadsJobCb cb, void *data );
+
+        static  void              SetWakeup( pwiThreadsJobCb cb, void *data );
+
+    private:
+        /* a FIFO of jobs, protected by the mutex
+         */
+        typedef struct sJob {
+            pwiThreadsJobCb       cb;
+            void                 *data;
+            struct sJob          *next;
+        }
+            pwiThreadsJob;
+
+        typedef struct {
+            pthread_mutex_t       mutex;
+            pthread_cond_t        cond;
+            pwiThreadsJob        *head;
+            pwiThreadsJob        *tail;
+        }
+            pwiThreadsQueue;
+
+        static  pwiThreadsQueue   radio;
+        static  pthread_t         radio_thread;
+        static  bool              radio_set;
+
+        static  pwiThreadsQueue   work;
+        static  pthread_t         workers[PWI_THREADS_MAX_WORKERS];
+        static  uint8_t           workers_count;
+        static  bool              stopping;
+
+        static  uint32_t          dropped;
+
+        static  pwiThreadsJobCb   wakeup_cb;
+        static  void             *wakeup_data;
+
+        static  bool              Push( pwiThreadsQueue *queue, pwiThreadsJobCb cb, void *data );
+        static  pwiThreadsJob    *Pop( pwiThreadsQueue *queue );
+        static  void              Wakeup( void );
+        static  void             *WorkerMain( void *arg );
+};
+
+#endif // PWI_THREADS
+
+#endif // __PWI_THREADS_H__
@@ -12,13 +12,41 @@
  *                 identify the timer by its address using new getHex16() function
  * pwi 2019-10-14 v191002
  *                 convert to pwiTimer2 base class
+ * pwi 2026-10-18 debug traces are written to the pwiLog binary ring
+ *                TIMER_DEBUG is replaced by pwiLog levels
+ *                dump() logs the timer
+ *                use PWI_TIMER_CLOCK and wrap-safe helpers
+ *                fix getRemaining() when the delay is already reached
+ *                thread-safe dispatching when built with PWI_THREADS
+ *                new NextDeadline() static method
+ *                callbacks run from Loop() are measured by the pwiProfiler
+ *                new setRemaining() method
+ *                new GetLoad() static method
  */
 
 #include "pwiTimer.h"
-#include <toHex.h>
- 
- // uncomment to debugging this file
-//#define TIMER_DEBUG
+#include "pwiLog.h"
+#include "pwiProfiler.h"
+
+/* protect the runtime data against the interrupt service routines, or
+ * against the other threads
+ */
+#ifdef PWI_THREADS
+static pthread_mutex_t st_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define TIMER_LOCK()                pthread_mutex_lock( &st_mutex )
+#define TIMER_UNLOCK()              pthread_mutex_unlock( &st_mutex )
+#else
+#define TIMER_LOCK()                noInterrupts()
+#define TIMER_UNLOCK()              interrupts()
+#endif
+
+// NextDeadline() accumulator
+typedef struct {
+    const char *type;
+    bool        found;
+    uint32_t    remaining;
+}
+    sNextDeadline;
 
 // single linked list of allocated pwiTimer's
 static pwiList     pwiTimer::list;
@@ -26,6 +54,11 @@ static pwiList     pwiTimer::list;
 // this class name
 static const char *pwiTimer::className = "pwiTimer";
 
+// load measurement
+uint32_t pwiTimer::busy_us = 0;
+uint32_t pwiTimer::window_us = 0;
+uint8_t  pwiTimer::load = 0;
+
 /**
  * pwiTimer::pwiTimer:
  * 
@@ -45,7 +78,11 @@ pwiTimer::pwiTimer( void )
 
     /* runtime data
      */
+    this->started = false;
     this->start_ms = 0;
+#ifdef PWI_THREADS
+    this->pending = false;
+#endif
 
     /* keep a single linked list of allocated pwiTimer's
      */
@@ -61,9 +98,7 @@ pwiTimer::pwiTimer( void )
  */
 void pwiTimer::dump( void )
 {
-#ifdef TIMER_DEBUG
-    /* to be written */
-#endif
+    PWI_LOG( TIMER_DUMP, this, this->delay_ms, this->once, this->start_ms );
 }
 
 /**
@@ -88,33 +123,22 @@ unsigned long pwiTimer::getDelay( void )
  */
 unsigned long pwiTimer::getRemaining( void )
 {
-    unsigned long remaining = 0;
-    unsigned long duration = 0;
-    unsigned long now = millis();
-    noInterrupts();
-    unsigned long start_ms = this->start_ms;
-    interrupts();
+    uint32_t remaining = 0;
+    uint32_t duration = 0;
+    uint32_t now = PWI_TIMER_CLOCK::Now();
+    TIMER_LOCK();
+    bool started = this->started;
+    uint32_t start_ms = this->start_ms;
+    TIMER_UNLOCK();
     if( this->isRunnable()){
-        if( this->isStarted()){
-            duration = now - start_ms;
+        if( started ){
+            duration = pwiElapsed( start_ms, now );
+            remaining = pwiRemaining( start_ms, this->delay_ms, now );
+        } else {
+            remaining = this->delay_ms;
         }
-        remaining = this->delay_ms - duration;
     }
-#ifdef TIMER_DEBUG
-    Serial.print( this->getType());
-    Serial.print( F( "::getRemaining() this=" ));
-    Serial.print( toHex16( this ));
-    Serial.print( F( ", delay_ms=" ));
-    Serial.print( this->delay_ms );
-    Serial.print( F( ", start_ms=" ));
-    Serial.print( start_ms );
-    Serial.print( F( ", now=" ));
-    Serial.print( now );
-    Serial.print( F( ", duration=" ));
-    Serial.print( duration );
-    Serial.print( F( ", remaining=" ));
-    Serial.println( remaining );
-#endif
+    PWI_LOG( TIMER_REMAINING, this, this->delay_ms, start_ms, now, duration, remaining );
     return( remaining );
 }
 
@@ -155,10 +179,10 @@ bool pwiTimer::isRunnable( void )
  */
 bool pwiTimer::isStarted( void )
 {
-    noInterrupts();
-    unsigned long ms = this->start_ms;
-    interrupts();
-    return( ms > 0 );
+    TIMER_LOCK();
+    bool started = this->started;
+    TIMER_UNLOCK();
+    return( started );
 }
 
 /**
@@ -207,6 +231,35 @@ void pwiTimer::setDelay( unsigned long delay_ms )
 	}
 }
 
+/**
+ * pwiTimer::setRemaining:
+ * @remaining_ms: the delay until the next expiration, bounded by the
+ *  configured delay.
+ *
+ * (Re)start the timer so that it expires in @remaining_ms, while it keeps
+ * its configured delay for the next periods; this lets a schedule be resumed
+ * after a reset (see pwiSnapshot).
+ *
+ * Public.
+ */
+void pwiTimer::setRemaining( unsigned long remaining_ms )
+{
+    if( this->isRunnable()){
+        if( remaining_ms > this->delay_ms ){
+            remaining_ms = this->delay_ms;
+        }
+        uint32_t now = PWI_TIMER_CLOCK::Now();
+        TIMER_LOCK();
+        // the wrap-safe arithmetic accepts a start in the past of the clock
+        this->start_ms = now - ( uint32_t )( this->delay_ms - remaining_ms );
+        this->started = true;
+        TIMER_UNLOCK();
+    } else {
+        PWI_LOG( TIMER_START_UNSET, this );
+        this->stop();
+    }
+}
+
 /**
  * pwiTimer::setup:
  * @label: [allow-none]: a label to identify or qualify the timer;
@@ -232,21 +285,7 @@ void pwiTimer::setDelay( unsigned long delay_ms )
  */
 void pwiTimer::setup( const char *label, unsigned long delay_ms, bool once, pwiTimerCb cb, void *user_data )
 {
-#ifdef TIMER_DEBUG
-    Serial.print( this->getType());
-    Serial.print( F( "::setup() this=" ));
-    Serial.print( toHex16( this ));
-    Serial.print( F( ", label='" ));
-    Serial.print( label );
-    Serial.print( F( "', delay_ms=" ));
-    Serial.print( delay_ms );
-    Serial.print( F( ", once=" ));
-    Serial.print( once );
-    Serial.print( F( ", cb=" ));
-    Serial.print( toHex16( cb ));
-    Serial.print( F( ", user_data=" ));
-    Serial.println( toHex16( user_data ));
-#endif
+    PWI_LOG( TIMER_SETUP, this, delay_ms, once, cb, user_data );
     this->label = label;
     this->setDelay( delay_ms );
     this->once = once;
@@ -266,20 +305,13 @@ void pwiTimer::setup( const char *label, unsigned long delay_ms, bool once, pwiT
 void pwiTimer::start( void )
 {
     if( this->isRunnable()){
-        noInterrupts();
-        this->start_ms = millis();
-        // manage the millis() rollover to make sure start_ms is not zero
-        if( this->start_ms == 0 ){
-            this->start_ms += 1;
-        }
-        interrupts();
+        uint32_t now = PWI_TIMER_CLOCK::Now();
+        TIMER_LOCK();
+        this->start_ms = now;
+        this->started = true;
+        TIMER_UNLOCK();
     } else {
-#ifdef TIMER_DEBUG
-        Serial.print( this->getType());
-        Serial.print( F( "pwiTimer::start() this=" ));
-        Serial.print( toHex16( this ));
-        Serial.println( F( ": unable to start the timer while delay is not set" ));
-#endif
+        PWI_LOG( TIMER_START_UNSET, this );
         this->stop();
     }
 }
@@ -293,9 +325,9 @@ void pwiTimer::start( void )
  */
 void pwiTimer::stop( void )
 {
-    noInterrupts();
-    this->start_ms = 0;
-    interrupts();
+    TIMER_LOCK();
+    this->started = false;
+    TIMER_UNLOCK();
 }
 
 /**
@@ -310,18 +342,98 @@ void pwiTimer::Dump( void )
     pwiTimer::list.iter( pwiTimer::DumpCb );
 }
 
+/**
+ * pwiTimer::GetLoad:
+ *
+ * Returns: the share of the time which has been spent in the callbacks run
+ * by Loop() (i.e. not dispatched to a worker thread) over the last complete
+ * window of PWI_TIMER_LOAD_WINDOW_MS, in percent.
+ *
+ * Public Static.
+ */
+uint8_t pwiTimer::GetLoad( void )
+{
+    return( pwiTimer::load );
+}
+
 /**
  * pwiTimer::Loop:
  * 
  * This function is meant to be repeatedly called from the main loop.
+ * It also closes the load measurement window when it has elapsed (see
+ * GetLoad()).
  * 
  * Public Static.
  */
 void pwiTimer::Loop(  const char *type /*=NULL*/ )
 {
+    uint32_t now_us = micros();
+    uint32_t elapsed = pwiElapsed( pwiTimer::window_us, now_us );
+    if( elapsed >= PWI_TIMER_LOAD_WINDOW_MS * 1000UL ){
+        uint32_t percent = pwiTimer::busy_us / ( elapsed/100 );
+        pwiTimer::load = percent > 100 ? 100 : percent;
+        pwiTimer::busy_us = 0;
+        pwiTimer::window_us = now_us;
+    }
     pwiTimer::list.iter( pwiTimer::LoopCb, type );
 }
 
+/*
+ * pwiTimer::fire:
+ *
+ * Run the callback of the expired timer, then stop or restart it.
+ *
+ * Private.
+ */
+void pwiTimer::fire( void )
+{
+    if( this->cb ){
+        this->cb( this->user_data );
+    }
+    if( this->once ){
+        this->stop();
+    } else {
+        this->restart();
+    }
+}
+
+/*
+ * pwiTimer::isType:
+ * @type: the type name requested by a static method, or %NULL.
+ *
+ * Returns: %TRUE if this timer is addressed by the @type, i.e. if it is a
+ * pwiTimer object and @type is %NULL, or if it is an instance of @type.
+ *
+ * Private.
+ */
+bool pwiTimer::isType( const char *type )
+{
+    const char *obj_type = this->getType();
+    return(( !type && !strcmp( obj_type, pwiTimer::className )) || ( type && !strcmp( obj_type, type )));
+}
+
+/**
+ * pwiTimer::NextDeadline:
+ * @remaining_ms: [out]: the delay until the next timer expiration.
+ * @type: the type name, with the same meaning than for Loop().
+ *
+ * Compute the delay until the first expiration among the started timers,
+ * so that an event loop may sleep until then (see pwiEventLoop).
+ *
+ * Returns: %TRUE if at least one timer is started, %FALSE if there is no
+ * deadline at all.
+ *
+ * Public Static.
+ */
+bool pwiTimer::NextDeadline( uint32_t &remaining_ms, const char *type /*=NULL*/ )
+{
+    sNextDeadline next = { type, false, 0 };
+
+    pwiTimer::list.iter(( pwiListIterCb * ) pwiTimer::NextCb, &next );
+    remaining_ms = next.remaining;
+    return( next.found );
+}
+
 /**
  * pwiTimer::loop:
  * @type: the type name which was requested when calling the pwiTimer::Loop()
@@ -330,53 +442,54 @@ void pwiTimer::Loop(  const char *type /*=NULL*/ )
  *  Else, only addresses the named instances.
  * 
  * Check the pwiTimer element for expiration of the @delay_ms.
+ *
+ * When built with PWI_THREADS and workers are running, the callback of an
+ * expired timer is dispatched to the worker pool; the timer is then ignored
+ * until its callback has returned.
  * 
  * Private.
  */
 void pwiTimer::loop( const char *type )
 {
-    const char *obj_type = this->getType();
-    if(( !type && !strcmp( obj_type, pwiTimer::className )) || ( type && !strcmp( obj_type, type ))){
-#ifdef TIMER_DEBUG
-        Serial.print( this->getType());
-        Serial.print( F( "::loop() this=" ));
-        Serial.print( toHex16( this ));
-        Serial.print( F( ", delay_ms=" ));
-        Serial.print( this->delay_ms );
+    if( this->isType( type )){
+        TIMER_LOCK();
+        bool started = this->started;
+        uint32_t start_ms = this->start_ms;
+#ifdef PWI_THREADS
+        if( this->pending ){
+            started = false;
+        }
 #endif
-        if( this->isStarted()){
-            unsigned long now = millis();
-            noInterrupts();
-            unsigned long start_ms = this->start_ms;
-            interrupts();
-            unsigned long duration = now - start_ms;
-#ifdef TIMER_DEBUG
-            Serial.print( F( ", start_ms=" ));
-            Serial.print( start_ms );
-            Serial.print( F( ", duration=" ));
-            Serial.print( duration );
+        TIMER_UNLOCK();
+        if( started ){
+            // read the clock after start_ms, which so cannot be in the future
+            uint32_t now = PWI_TIMER_CLOCK::Now();
+            uint32_t duration = pwiElapsed( start_ms, now );
+            if( pwiReached( start_ms, this->delay_ms, now )){
+                PWI_LOG( TIMER_LOOP_FIRE, this, this->delay_ms, start_ms, duration );
+#ifdef PWI_THREADS
+                TIMER_LOCK();
+                this->pending = true;
+                TIMER_UNLOCK();
+                if( pwiThreads::Submit(( pwiThreadsJobCb ) pwiTimer::WorkerCb, this )){
+                    return;
+                }
+                TIMER_LOCK();
+                this->pending = false;
+                TIMER_UNLOCK();
 #endif
-            if( duration >= this->delay_ms ){
-#ifdef TIMER_DEBUG
-                Serial.println( F( " triggered" ));
+                uint32_t fire_us = micros();
+                this->fire();
+                uint32_t fire_duration = pwiElapsed( fire_us, micros());
+                pwiTimer::busy_us += fire_duration;
+#ifdef PWI_PROFILER
+                pwiProfiler::Stall( this, fire_duration );
 #endif
-                if( this->cb ){
-                    this->cb( this->user_data );
-                }
-                if( this->once ){
-                    this->stop();
-                } else {
-                    this->restart();
-                }
-#ifdef TIMER_DEBUG
             } else {
-                Serial.println( F( " not yet reached" ));
-#endif
+                PWI_LOG( TIMER_LOOP_WAIT, this, this->delay_ms, start_ms, duration );
             }
-#ifdef TIMER_DEBUG
         } else {
-            Serial.println( F( " not started" ));
-#endif
+            PWI_LOG( TIMER_LOOP_IDLE, this, this->delay_ms );
         }
     }
 }
@@ -407,3 +520,55 @@ void pwiTimer::LoopCb( pwiTimer *timer, const char *type )
     timer->loop( type );
 }
 
+/*
+ * pwiTimer::NextCb:
+ * @timer: the pwiTimer element.
+ * @user_data: the NextDeadline() accumulator.
+ *
+ * pwiList::iter() callback function: keep the smallest remaining delay
+ *  among the started timers.
+ *
+ * Private Static.
+ */
+void pwiTimer::NextCb( pwiTimer *timer, void *user_data )
+{
+    sNextDeadline *next = ( sNextDeadline * ) user_data;
+
+    if( timer->isType( next->type )){
+        TIMER_LOCK();
+        bool started = timer->started;
+        uint32_t start_ms = timer->start_ms;
+#ifdef PWI_THREADS
+        // the timer will be restarted by the worker
+        if( timer->pending ){
+            started = false;
+        }
+#endif
+        TIMER_UNLOCK();
+        if( started ){
+            uint32_t remaining = pwiRemaining( start_ms, timer->delay_ms, PWI_TIMER_CLOCK::Now());
+            if( !next->found || remaining < next->remaining ){
+                next->found = true;
+                next->remaining = remaining;
+            }
+        }
+    }
+}
+
+#ifdef PWI_THREADS
+/*
+ * pwiTimer::WorkerCb:
+ * @timer: the expired pwiTimer.
+ *
+ * pwiThreads worker job: run the callback of the @timer.
+ *
+ * Private Static.
+ */
+void pwiTimer::WorkerCb( pwiTimer *timer )
+{
+    timer->fire();
+    TIMER_LOCK();
+    timer->pending = false;
+    TIMER_UNLOCK();
+}
+#endif
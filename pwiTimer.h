@@ -38,10 +38,29 @@
  * pwi 2019-10-14 v101002
  *                 pwiList becomes a static class member
  *                 introduce getType() method
+ * pwi 2026-10-18 the time source is PWI_TIMER_CLOCK (see pwiClock.h)
+ *                wrap-safe time arithmetic
+ *                a timer started at timestamp zero is no more seen as stopped
+ *                thread-safe, with callbacks dispatched to the worker pool
+ *                when built with PWI_THREADS (see pwiThreads.h)
+ *                new NextDeadline() static method
+ *                new setRemaining() method
+ *                accounted by pwiMemory
+ *                new GetLoad() static method
+ *                profiled by pwiProfiler
  */
 
 #include <Arduino.h>
 #include <pwiList.h>
+#include <pwiClock.h>
+#include <pwiThreads.h>
+
+/* the window over which the load (the share of the time spent in the
+ * callbacks run by Loop()) is computed
+ */
+#ifndef PWI_TIMER_LOAD_WINDOW_MS
+#define PWI_TIMER_LOAD_WINDOW_MS        1000
+#endif
 
 /* The prototype for the timer callback function to be provided by the caller.
    This function receives the 'user_data' parameter provided at setup() time.
@@ -50,6 +69,9 @@
 typedef void ( *pwiTimerCb )( void * );
 
 class pwiTimer {
+    friend class pwiMemory;
+    friend class pwiProfiler;
+
     public:
                                     pwiTimer( void );
         virtual   void              dump( void );
@@ -60,6 +82,7 @@ class pwiTimer {
         virtual   bool              isStarted();
         virtual   void              restart( void );
         virtual   void              setDelay( unsigned long delay_ms );
+        virtual   void              setRemaining( unsigned long remaining_ms );
         virtual   void              setup( const char *label, unsigned long delay_ms, bool once=true, pwiTimerCb cb=NULL, void *user_data=NULL );
         virtual   void              start( void );
         virtual   void              stop( void );
@@ -67,7 +90,9 @@ class pwiTimer {
         /* static methods
          */
         static    void              Dump();
+        static    uint8_t           GetLoad( void );
         static    void              Loop( const char *type=NULL );
+        static    bool              NextDeadline( uint32_t &remaining_ms, const char *type=NULL );
 
     private:
         /* configuration data
@@ -80,25 +105,40 @@ class pwiTimer {
                   void             *user_data;
 
         /* runtime data
-         * @start_ms: startup timestamp.
-         *  =0 timer not started
-         *  >0 timestamp of the timer startup.
+         * @started: whether the timer is started.
+         * @start_ms: PWI_TIMER_CLOCK timestamp of the timer startup.
 		 */
-        volatile  unsigned long     start_ms;
+        volatile  bool              started;
+        volatile  uint32_t          start_ms;
+#ifdef PWI_THREADS
+        /* whether the callback has been dispatched to a worker and is not
+         * terminated yet
+         */
+        volatile  bool              pending;
+#endif
 
         /* methods
          */
+                  void              fire( void );
+                  bool              isType( const char *type );
                   void              loop( const char *type );
 
         /* static data
          */
         static    pwiList           list;
         static    const char       *className;
+        static    uint32_t          busy_us;            // time spent in the callbacks in the current window
+        static    uint32_t          window_us;          // micros() timestamp of the start of the current window
+        static    uint8_t           load;               // load of the last complete window, in percent
 
         /* static methods
          */
         static    void              DumpCb( pwiTimer *timer, void *user_data );
         static    void              LoopCb( pwiTimer *timer, const char *type );
+        static    void              NextCb( pwiTimer *timer, void *user_data );
+#ifdef PWI_THREADS
+        static    void              WorkerCb( pwiTimer *timer );
+#endif
 };
 
 #endif // __PWI_TIMER_H__
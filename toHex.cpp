@@ -4,22 +4,64 @@
 /*
  * pwi 2019- 9-12 v190902
  *                creation
+ * pwi 2026-10-18 new toHex() function
+ *                toHex16() is deprecated
+ *                fix a string truncation warning
  */
 
 // uncomment to debugging this file
 //#define PRINT_ADDRESS_DEBUG
 
-static char sHexa[7];		// up to 64 KB address
+static char sHexa[PWI_HEX_PTR_SIZE];
+
+/**
+ * toHex:
+ * @ptr: a pointer to any object.
+ * @buffer: the destination buffer.
+ * @size: the size of the @buffer, which should be at least PWI_HEX_PTR_SIZE.
+ *
+ * Format the @ptr address as an hexadecimal, '0x'-prefixed, string, with
+ * as many digits as the pointer width of the target (4 on AVR, 16 on a 64-bits
+ * Linux). The output is truncated to the @size of the @buffer.
+ *
+ * This function is reentrant: several calls may be chained in a same
+ * statement as soon as each one is given its own buffer.
+ *
+ * Returns: the @buffer.
+ */
+char *toHex( const void *ptr, char *buffer, size_t size )
+{
+    static const char hexa[] = "0123456789abcdef";
+    uintptr_t value = ( uintptr_t ) ptr;
+    char full[PWI_HEX_PTR_SIZE];
+    uint8_t digits = 2*sizeof( uintptr_t );
+
+    if( !buffer || !size ){
+        return( buffer );
+    }
+    full[0] = '0';
+    full[1] = 'x';
+    for( uint8_t i=0 ; i<digits ; ++i ){
+        full[1+digits-i] = hexa[value & 0x0f];
+        value >>= 4;
+    }
+    size_t length = min(( size_t )( 2+digits ), size-1 );
+    memcpy( buffer, full, length );
+    buffer[length] = '\0';
+
+    return( buffer );
+}
 
 /**
  * toHex16:
  * @ptr: a pointer to any object.
  *
  * Returns: the @ptr address as an hexadecimal, '0x'-prefixed, string.
+ *
+ * Deprecated: the returned string is a static buffer which is overwritten by
+ * each call; use toHex() instead.
  */
 char *toHex16( void *ptr )
 {
-    snprintf( sHexa, sizeof( sHexa ), "0x%4.4x", ( int ) ptr );
-    return( sHexa );
+    return( toHex( ptr, sHexa, sizeof( sHexa )));
 }
-
@@ -1,7 +1,20 @@
 #ifndef __PWI_TO_HEX_H__
 #define __PWI_TO_HEX_H__
 
+#include <Arduino.h>
+
+/*
+ * pwi 2026-10-18 new reentrant toHex() function
+ */
+
+/* the size of a buffer able to hold a formatted pointer, including the
+ * '0x' prefix and the terminating null byte
+ */
+#define PWI_HEX_PTR_SIZE        ( 2+2*sizeof( uintptr_t )+1 )
+
+char *toHex( const void *ptr, char *buffer, size_t size );
+
+/* deprecated: not reentrant, use toHex() */
 char *toHex16( void * );
 
 #endif // __PWI_TO_HEX_H__
-